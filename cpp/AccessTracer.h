@@ -0,0 +1,17 @@
+#pragma once
+// include/AccessTracer.h
+#ifndef ACCESSTRACER_H
+#define ACCESSTRACER_H
+
+#include <cstddef>
+
+// Получатель трассы обращений к памяти: деревья сообщают адреса
+// узлов (и связанных с ними буферов), которые они читают или меняют
+class AccessTracer {
+public:
+    virtual ~AccessTracer() = default;
+
+    virtual void onAccess(const void* address, size_t size) = 0;
+};
+
+#endif // ACCESSTRACER_H
\ No newline at end of file
@@ -1,227 +1,1405 @@
-// src/Benchmark.cpp
-#include <algorithm>
-#include <fstream>
-#include <iostream>
-#include <iomanip>
-#include <numeric>
-
-#include "AVLTree.h"
-#include "AATree.h"
-#include "Benchmark.h"
-#include "DataGenerator.h"
-#include "Treap.h"
-#include "TwoThreeTree.h"
-
-
-Benchmark::Benchmark() {
-    tree_names = {
-        {TreeType::AVL, "AVL Tree"},
-        {TreeType::AA, "AA Tree"},
-        {TreeType::TREAP, "Treap"},
-        {TreeType::TWO_THREE, "2-3 Tree"}
-    };
-}
-
-std::unique_ptr<TreeBase> Benchmark::createTree(TreeType type) {
-    switch (type) {
-    case TreeType::AVL:
-        return std::make_unique<AVLTree>();
-    case TreeType::AA:
-        return std::make_unique<AATree>();
-    case TreeType::TREAP:
-        return std::make_unique<Treap>();
-    case TreeType::TWO_THREE:
-        return std::make_unique<TwoThreeTree>();
-    default:
-        return nullptr;
-    }
-}
-
-BenchmarkResult Benchmark::testInsertion(TreeType type, const std::vector<int>& data) {
-    auto tree = createTree(type);
-    if (!tree) return BenchmarkResult();
-
-    BenchmarkResult result;
-    result.tree_type = type;
-    result.operation = "Insertion";
-    result.data_size = data.size();
-    result.data_order = DataOrder::RANDOM; // TODO:   
-
-    auto start = std::chrono::high_resolution_clock::now();
-
-    int rotations_before = tree->getStatistics().rotations_count;
-    for (int key : data) {
-        tree->insert(key);
-    }
-    int rotations_after = tree->getStatistics().rotations_count;
-
-    auto end = std::chrono::high_resolution_clock::now();
-
-    result.total_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
-    result.avg_time_ns = data.empty() ? 0 : result.total_time_ns / data.size();
-    result.final_height = tree->getHeight();
-    result.final_nodes = tree->getNodeCount();
-    result.rotations = rotations_after - rotations_before;
-
-    return result;
-}
-
-BenchmarkResult Benchmark::testSearch(TreeType type, const std::vector<int>& data_to_insert,
-    const std::vector<int>& data_to_search) {
-    auto tree = createTree(type);
-    if (!tree) return BenchmarkResult();
-
-    //   
-    for (int key : data_to_insert) {
-        tree->insert(key);
-    }
-
-    BenchmarkResult result;
-    result.tree_type = type;
-    result.operation = "Search";
-    result.data_size = data_to_search.size();
-
-    auto start = std::chrono::high_resolution_clock::now();
-
-    for (int key : data_to_search) {
-        tree->search(key);
-    }
-
-    auto end = std::chrono::high_resolution_clock::now();
-
-    result.total_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
-    result.avg_time_ns = data_to_search.empty() ? 0 : result.total_time_ns / data_to_search.size();
-    result.final_height = tree->getHeight();
-    result.final_nodes = tree->getNodeCount();
-
-    return result;
-}
-
-BenchmarkResult Benchmark::testDeletion(TreeType type, const std::vector<int>& data_to_insert,
-    const std::vector<int>& data_to_remove) {
-    auto tree = createTree(type);
-    if (!tree) return BenchmarkResult();
-
-    //   
-    for (int key : data_to_insert) {
-        tree->insert(key);
-    }
-
-    BenchmarkResult result;
-    result.tree_type = type;
-    result.operation = "Deletion";
-    result.data_size = data_to_remove.size();
-
-    auto start = std::chrono::high_resolution_clock::now();
-
-    for (int key : data_to_remove) {
-        tree->remove(key);
-    }
-
-    auto end = std::chrono::high_resolution_clock::now();
-
-    result.total_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
-    result.avg_time_ns = data_to_remove.empty() ? 0 : result.total_time_ns / data_to_remove.size();
-    result.final_height = tree->getHeight();
-    result.final_nodes = tree->getNodeCount();
-
-    return result;
-}
-
-std::vector<BenchmarkResult> Benchmark::runFullTest(int data_size, DataOrder order,
-    int iterations) {
-    std::vector<BenchmarkResult> results;
-    DataGenerator generator;
-
-    std::vector<TreeType> tree_types = {
-        TreeType::AVL,
-        TreeType::AA,
-        TreeType::TREAP,
-        TreeType::TWO_THREE
-    };
-
-    for (int i = 0; i < iterations; i++) {
-        std::vector<int> data = generator.generate(data_size, order);
-
-        for (TreeType type : tree_types) {
-            BenchmarkResult insert_result = testInsertion(type, data);
-            BenchmarkResult search_result = testSearch(type, data, data);
-            BenchmarkResult delete_result = testDeletion(type, data, data);
-
-            results.push_back(insert_result);
-            results.push_back(search_result);
-            results.push_back(delete_result);
-        }
-    }
-
-    return results;
-}
-
-void Benchmark::saveResultsToCSV(const std::vector<BenchmarkResult>& results,
-    const std::string& filename) {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "   : " << filename << std::endl;
-        return;
-    }
-
-    //  CSV
-    file << "TreeType;Operation;DataSize;TotalTimeNs;AvgTimeNs;"
-        << "FinalHeight;FinalNodes;Rotations\n";
-
-    for (const auto& result : results) {
-        file << tree_names[result.tree_type] << ";"
-            << result.operation << ";"
-            << result.data_size << ";"
-            << result.total_time_ns << ";"
-            << result.avg_time_ns << ";"
-            << result.final_height << ";"
-            << result.final_nodes << ";"
-            << result.rotations << "\n";
-    }
-
-    file.close();
-    std::cout << "  : " << filename << std::endl;
-}
-
-void Benchmark::printResults(const std::vector<BenchmarkResult>& results) {
-    std::cout << "\n===   ===\n\n";
-
-    std::map<std::pair<TreeType, std::string>, std::vector<BenchmarkResult>> grouped_results;
-
-    for (const auto& result : results) {
-        auto key = std::make_pair(result.tree_type, result.operation);
-        grouped_results[key].push_back(result);
-    }
-
-    for (const auto& entry : grouped_results) {
-        TreeType tree_type = entry.first.first;
-        std::string operation = entry.first.second;
-        const std::vector<BenchmarkResult>& result_group = entry.second;
-        std::string tree_name = tree_names[tree_type];
-
-        std::cout << tree_name << " - " << operation << ":\n";
-
-        if (!result_group.empty()) {
-            long long total_time_sum = 0;
-            long long avg_time_sum = 0;
-
-            for (const auto& result : result_group) {
-                total_time_sum += result.total_time_ns;
-                avg_time_sum += result.avg_time_ns;
-            }
-
-            long long avg_total_time = total_time_sum / result_group.size();
-            long long avg_avg_time = avg_time_sum / result_group.size();
-
-            std::cout << "    : " << avg_total_time << " \n";
-            std::cout << "     : " << avg_avg_time << " \n";
-            std::cout << "   : " << result_group[0].final_height << "\n";
-            std::cout << "    : " << result_group[0].final_nodes << "\n";
-            if (result_group[0].rotations > 0) {
-                std::cout << "   : " << result_group[0].rotations << "\n";
-            }
-        }
-        std::cout << "-------------------------\n";
-    }
+// src/Benchmark.cpp
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <numeric>
+#include <sstream>
+#include <thread>
+#include <tuple>
+
+#include "AVLTree.h"
+#include "AATree.h"
+#include "Benchmark.h"
+#include "CellIsolation.h"
+#include "DataGenerator.h"
+#include "ShardedTree.h"
+#include "SkipList.h"
+#include "Timer.h"
+#include "TraceRecorder.h"
+#include "Treap.h"
+#include "TwoThreeTree.h"
+#include "Visualizer.h"
+
+
+Benchmark::Benchmark() {
+    tree_names = {
+        {TreeType::AVL, "AVL Tree"},
+        {TreeType::AA, "AA Tree"},
+        {TreeType::TREAP, "Treap"},
+        {TreeType::TWO_THREE, "2-3 Tree"},
+        {TreeType::SKIP_LIST, "Skip List"}
+    };
+}
+
+std::string Benchmark::getTreeName(TreeType type) const {
+    auto it = tree_names.find(type);
+    return it != tree_names.end() ? it->second : "Unknown";
+}
+
+std::unique_ptr<TreeBase> Benchmark::createTree(TreeType type) {
+    switch (type) {
+    case TreeType::AVL:
+        return std::make_unique<AVLTree>();
+    case TreeType::AA:
+        return std::make_unique<AATree>();
+    case TreeType::TREAP:
+        return std::make_unique<Treap>();
+    case TreeType::TWO_THREE:
+        return std::make_unique<TwoThreeTree>();
+    case TreeType::SKIP_LIST:
+        return std::make_unique<SkipList>();
+    default:
+        return nullptr;
+    }
+}
+
+std::unique_ptr<TreeBase> Benchmark::createSynchronizedTree(TreeType type, SyncMode mode) {
+    auto tree = createTree(type);
+    if (!tree || tree->isThreadSafe()) return tree;
+
+    if (mode == SyncMode::FLAT_COMBINING) {
+        return std::make_unique<FlatCombiningTree>(std::move(tree));
+    }
+    return std::make_unique<LockedTree>(std::move(tree), mode);
+}
+
+double BenchmarkResult::comparisonsPerOperation() const {
+    return data_size > 0 ? static_cast<double>(comparisons) / data_size : 0.0;
+}
+
+double BenchmarkResult::nodeVisitsPerOperation() const {
+    return data_size > 0 ? static_cast<double>(node_visits) / data_size : 0.0;
+}
+
+double BenchmarkResult::getLog2Size() const {
+    return data_size > 1 ? std::log2(static_cast<double>(data_size)) : 0.0;
+}
+
+double BenchmarkResult::nsPerOperation() const {
+    return data_size > 0 ? static_cast<double>(total_time_ns) / data_size : 0.0;
+}
+
+double RepetitionPolicy::getNoisePercent() const {
+    return target_ci_percent > 0 ? target_ci_percent : DEFAULT_NOISE_PERCENT;
+}
+
+double BenchmarkResult::heapBytesPerKey() const {
+    return final_nodes > 0 ? static_cast<double>(heap_bytes) / final_nodes : 0.0;
+}
+
+namespace {
+
+// Память фазы. Дерево уничтожается здесь же: разность живой кучи до и после
+// уничтожения - точный объем дерева без гистограмм и прочих буферов замера.
+// inspect получает дерево после снимка кучи фазы, до уничтожения
+template <typename Tree, typename Inspect>
+void fillMemoryUsage(BenchmarkResult& result, std::unique_ptr<Tree>& tree, const MemorySnapshot& before,
+    Inspect inspect) {
+    MemorySnapshot after = MemoryTracker::snapshot();
+
+    result.memory_bytes = tree->getMemoryUsage();
+    result.bytes_per_key = result.final_nodes > 0 ?
+        static_cast<double>(result.memory_bytes) / result.final_nodes : 0.0;
+    result.peak_heap_bytes = after.peakBytes - before.liveBytes;
+    result.heap_allocations = after.allocations - before.allocations;
+    result.rss_bytes = after.rssBytes;
+
+    inspect(tree.get());
+
+    // Освобождение - отдельный интервал трассы: для больших деревьев оно
+    // сравнимо с самой фазой. Куча снимается до записи события в трассу
+    long long live = 0;
+    long long freed_live = 0;
+    {
+        TraceSpan span("FreeTree", "memory");
+        live = MemoryTracker::snapshot().liveBytes;
+        tree.reset();
+        freed_live = MemoryTracker::snapshot().liveBytes;
+    }
+    result.heap_bytes = live - freed_live;
+}
+
+template <typename Tree>
+void fillMemoryUsage(BenchmarkResult& result, std::unique_ptr<Tree>& tree, const MemorySnapshot& before) {
+    fillMemoryUsage(result, tree, before, [](Tree*) {});
+}
+
+// Выполняет count операций и пишет их время в latency. При batch > 1 дерево
+// не замеряет операции само: одна пара отметок Timer приходится на пакет,
+// в гистограмму попадает среднее время операции пакета с весом его размера.
+// prepare вызывается перед каждым замером и в замер не входит, как и
+// sample(op_index, latency_ns) после него - замер динамики
+// структуры. raw (если задан) должен быть уже зарезервирован под все замеры:
+// выделение памяти внутри фазы попало бы в ее кучу. Возвращает сумму
+// замеренного времени
+struct NoTelemetry {
+    void operator()(long long, long long) const {}
+};
+
+template <typename Operation, typename Prepare, typename Sample = NoTelemetry>
+long long timeOperations(TreeBase* tree, size_t count, int batch, LatencyHistogram& latency,
+    Operation operation, Prepare prepare, std::vector<long long>* raw = nullptr, Sample sample = Sample()) {
+    long long timed_ns = 0;
+
+    if (batch <= 1) {
+        for (size_t i = 0; i < count; i++) {
+            prepare();
+            OperationResult result = operation(i);
+            latency.record(result.time_ns);
+            timed_ns += result.time_ns;
+            if (raw) raw->push_back(result.time_ns);
+            sample(static_cast<long long>(i) + 1, result.time_ns);
+        }
+        return timed_ns;
+    }
+
+    tree->setOperationTiming(false);
+    for (size_t begin = 0; begin < count; begin += batch) {
+        size_t end = std::min(count, begin + static_cast<size_t>(batch));
+
+        prepare();
+        Timer::Ticks start = Timer::now();
+        for (size_t i = begin; i < end; i++) {
+            operation(i);
+        }
+        long long elapsed = Timer::elapsedNs(start, Timer::now());
+
+        long long operations = static_cast<long long>(end - begin);
+        latency.record(elapsed / operations, operations);
+        timed_ns += elapsed;
+        if (raw) raw->push_back(elapsed / operations);
+        sample(static_cast<long long>(end), elapsed / operations);
+    }
+    tree->setOperationTiming(true);
+    return timed_ns;
+}
+
+template <typename Operation>
+long long timeOperations(TreeBase* tree, size_t count, int batch, LatencyHistogram& latency, Operation operation) {
+    return timeOperations(tree, count, batch, latency, operation, []() {});
+}
+
+// Время фазы по сумме замеров timed_ns операций timed_ops. Если замерена
+// только выборка (режим COLD), время на операцию делится на число замеров,
+// а общее пересчитывается на все data_size операций фазы
+void fillPhaseTime(BenchmarkResult& result, long long timed_ns, size_t timed_ops) {
+    if (timed_ops == 0) return;
+    result.avg_time_ns = timed_ns / static_cast<long long>(timed_ops);
+    result.total_time_ns = timed_ns * static_cast<long long>(result.data_size) / static_cast<long long>(timed_ops);
+}
+
+// Заполнение перед замеряемой фазой, без замера отдельных вставок.
+// spacing > 0 - после каждого ключа выделяется промежуток такого размера,
+// и соседние узлы попадают на разные страницы (режим TLB_COLD)
+void fillTree(TreeBase* tree, const std::vector<int>& keys, size_t spacing,
+    std::vector<std::unique_ptr<char[]>>& spacers) {
+    bool timing = tree->isOperationTiming();
+    tree->setOperationTiming(false);
+    for (int key : keys) {
+        tree->insert(key);
+        if (spacing > 0) {
+            spacers.emplace_back(new char[spacing]);
+        }
+    }
+    tree->setOperationTiming(timing);
+}
+
+// В перемешанных режимах порядок ключей не совпадает с порядком вставки.
+// Зерно зависит только от размера, чтобы повторы и деревья шли одинаково
+std::vector<int> orderKeys(const std::vector<int>& keys, CacheMode mode) {
+    std::vector<int> ordered = keys;
+    if (mode == CacheMode::SHUFFLED || mode == CacheMode::TLB_COLD) {
+        std::mt19937 rng(static_cast<unsigned int>(keys.size()));
+        std::shuffle(ordered.begin(), ordered.end(), rng);
+    }
+    return ordered;
+}
+
+// Равномерная выборка не больше limit ключей
+std::vector<int> sampleKeys(const std::vector<int>& keys, size_t limit) {
+    if (keys.size() <= limit || limit == 0) return keys;
+
+    std::vector<int> sample;
+    sample.reserve(limit);
+    for (size_t i = 0; i < limit; i++) {
+        sample.push_back(keys[i * keys.size() / limit]);
+    }
+    return sample;
+}
+
+}
+
+void Benchmark::fillStructureWork(BenchmarkResult& result, TreeBase* tree, const TreeStatistics& before) {
+    TreeStatistics after = tree->getStatistics();
+
+    TreeStatistics delta;
+    delta.rotations_count = after.rotations_count - before.rotations_count;
+    delta.skew_count = after.skew_count - before.skew_count;
+    delta.split_count = after.split_count - before.split_count;
+    delta.splits_count = after.splits_count - before.splits_count;
+    delta.merges_count = after.merges_count - before.merges_count;
+    delta.borrows_count = after.borrows_count - before.borrows_count;
+    delta.comparisons = after.comparisons - before.comparisons;
+    delta.node_visits = after.node_visits - before.node_visits;
+    delta.allocations = after.allocations - before.allocations;
+
+    result.rotations = delta.rotations_count;
+    result.comparisons = delta.comparisons;
+    result.node_visits = delta.node_visits;
+    result.skews = delta.skew_count;
+    // У АА расщепления считаются отдельно от Treap и 2-3
+    result.splits = delta.split_count + delta.splits_count;
+    result.merges = delta.merges_count;
+    result.borrows = delta.borrows_count;
+    result.allocations = delta.allocations;
+
+    if (!warming_up) {
+        statistics.registerStructureWork(tree, delta);
+    }
+}
+
+void Benchmark::setCacheSimulation(bool enabled, const CacheSimulatorConfig& config) {
+    if (enabled) {
+        cache_simulator = std::make_unique<CacheSimulator>(config);
+    }
+    else {
+        cache_simulator.reset();
+    }
+}
+
+void Benchmark::attachCacheSimulator(TreeBase* tree) {
+    if (!cache_simulator) return;
+
+    // Каждое дерево начинает с пустого кэша, заполнение тоже трассируется
+    cache_simulator->flush();
+    tree->setAccessTracer(cache_simulator.get());
+}
+
+std::vector<long long>* Benchmark::reserveRawLatency(BenchmarkResult& result, size_t count) {
+    if (!capture_raw_latency || warming_up) return nullptr;
+
+    size_t batch = static_cast<size_t>(std::max(1, timing_batch_size));
+    result.raw_latency_ns.clear();
+    result.raw_latency_ns.reserve((count + batch - 1) / batch);
+    return &result.raw_latency_ns;
+}
+
+void Benchmark::startCacheSimulation() {
+    if (cache_simulator) {
+        cache_simulator->resetCounters();
+    }
+}
+
+CacheSimulationCounters Benchmark::finishCacheSimulation() {
+    return cache_simulator ? cache_simulator->getCounters() : CacheSimulationCounters();
+}
+
+void Benchmark::sampleTelemetry(TelemetrySampler& telemetry, long long op_index, TreeBase* tree,
+    long long latency_ns) {
+    perf_counters.pause();
+    AccessTracer* tracer = tree->getAccessTracer();
+    tree->setAccessTracer(nullptr);
+
+    telemetry.record(op_index, tree, latency_ns);
+
+    tree->setAccessTracer(tracer);
+    perf_counters.resume();
+}
+
+void Benchmark::setCacheModes(const std::vector<CacheMode>& modes, long long largest_cache_bytes) {
+    cache_modes = modes.empty() ? std::vector<CacheMode>{ CacheMode::WARM } : modes;
+
+    if (std::find(cache_modes.begin(), cache_modes.end(), CacheMode::COLD) == cache_modes.end()) {
+        std::vector<char>().swap(eviction_buffer);
+        return;
+    }
+    if (largest_cache_bytes <= 0) {
+        largest_cache_bytes = static_cast<long long>(CacheSimulatorConfig::getDefault().l3.size);
+    }
+    eviction_buffer.assign(static_cast<size_t>(largest_cache_bytes) * 2, 0);
+}
+
+const char* Benchmark::getCacheModeName(CacheMode mode) {
+    switch (mode) {
+    case CacheMode::WARM: return "Warm";
+    case CacheMode::COLD: return "Cold";
+    case CacheMode::SHUFFLED: return "Shuffled";
+    case CacheMode::TLB_COLD: return "TLBCold";
+    default: return "Unknown";
+    }
+}
+
+void Benchmark::evictCaches() {
+    TraceSpan span("EvictCaches", "cache");
+    // Запись в каждую строку: строки дерева вытесняются из всех уровней
+    for (size_t i = 0; i < eviction_buffer.size(); i += 64) {
+        eviction_buffer[i]++;
+    }
+
+    if (cache_simulator) {
+        cache_simulator->flush();
+    }
+}
+
+std::unique_ptr<TreeBase> Benchmark::buildSnapshot(TreeType type, const std::vector<int>& keys) {
+    TraceSpan span("BuildSnapshot", "setup", getTreeName(type), static_cast<long long>(keys.size()));
+    auto tree = createTree(type);
+    if (!tree) return nullptr;
+
+    std::vector<std::unique_ptr<char[]>> spacers;
+    fillTree(tree.get(), keys, 0, spacers);
+    return tree;
+}
+
+std::unique_ptr<TreeBase> Benchmark::prepareTree(TreeType type, const std::vector<int>& keys, CacheMode mode,
+    const TreeBase* snapshot, std::vector<std::unique_ptr<char[]>>& spacers) {
+    TraceSpan span("PrepareTree", "setup", getTreeName(type), static_cast<long long>(keys.size()));
+    if (snapshot && mode != CacheMode::TLB_COLD && !cache_simulator) {
+        return snapshot->clone();
+    }
+
+    auto tree = createTree(type);
+    if (!tree) return nullptr;
+    attachCacheSimulator(tree.get());
+
+    size_t spacing = mode == CacheMode::TLB_COLD && !keys.empty()
+        ? std::min(TLB_PAGE_SIZE, TLB_SPREAD_BUDGET / keys.size()) : 0;
+    fillTree(tree.get(), keys, spacing, spacers);
+    return tree;
+}
+
+BenchmarkResult Benchmark::testInsertion(TreeType type, const std::vector<int>& data) {
+    TraceSpan span("Insertion", "phase", getTreeName(type), static_cast<long long>(data.size()));
+    auto tree = createTree(type);
+    if (!tree) return BenchmarkResult();
+    attachCacheSimulator(tree.get());
+
+    BenchmarkResult result;
+    result.tree_type = type;
+    result.operation = "Insertion";
+    result.data_size = data.size();
+    result.timing_batch = timing_batch_size;
+
+    TreeStatistics before = tree->getStatistics();
+    TelemetrySampler telemetry(warming_up ? 0 : telemetry_interval, before);
+    std::vector<long long>* raw = reserveRawLatency(result, data.size());
+    MemorySnapshot memory_before = MemoryTracker::beginPhase();
+
+    startCacheSimulation();
+    perf_counters.start();
+    PhaseProfiler::start();
+    long long timed_ns = timeOperations(tree.get(), data.size(), timing_batch_size, result.latency,
+        [&](size_t i) { return tree->insert(data[i]); }, []() {}, raw,
+        [&](long long op_index, long long latency_ns) {
+            if (telemetry.isDue(op_index)) {
+                sampleTelemetry(telemetry, op_index, tree.get(), latency_ns);
+            }
+        });
+    result.phases = PhaseProfiler::stop();
+    result.counters = perf_counters.stop();
+    result.cache = finishCacheSimulation();
+
+    // Сумма замеров операций: обвязка цикла и замеры динамики в нее не входят
+    fillPhaseTime(result, timed_ns, data.size());
+    result.min_time_ns = result.latency.getMin();
+    result.max_time_ns = result.latency.getMax();
+    result.final_height = tree->getHeight();
+    result.final_nodes = tree->getNodeCount();
+    fillStructureWork(result, tree.get(), before);
+    // Форма построенного дерева - после замера, вне времени и кучи фазы
+    fillMemoryUsage(result, tree, memory_before, [&](TreeBase* built) {
+        if (!warming_up) {
+            statistics.updateStructureMetrics(built, static_cast<int>(std::thread::hardware_concurrency()));
+        }
+        });
+    result.telemetry = telemetry.getSamples();
+
+    return result;
+}
+
+BenchmarkResult Benchmark::probeInsertion(TreeType type, const std::vector<int>& data) {
+    bool was_warming_up = warming_up;
+    warming_up = true;
+    BenchmarkResult result = testInsertion(type, data);
+    warming_up = was_warming_up;
+    return result;
+}
+
+BenchmarkResult Benchmark::testSearch(TreeType type, const std::vector<int>& data_to_insert,
+    const std::vector<int>& data_to_search, CacheMode mode, const TreeBase* snapshot) {
+    TraceSpan span("Search", "phase", getTreeName(type) + "/" + getCacheModeName(mode),
+        static_cast<long long>(data_to_search.size()));
+    std::vector<std::unique_ptr<char[]>> spacers;
+    auto tree = prepareTree(type, data_to_insert, mode, snapshot, spacers);
+    if (!tree) return BenchmarkResult();
+    // Вытеснение стоит миллисекунды, поэтому в режиме COLD замеряется не больше
+    // COLD_MAX_SAMPLES операций по выборке ключей. Кэши вытесняются перед
+    // каждой: в пакете холодной была бы только первая операция
+    bool cold = mode == CacheMode::COLD;
+    int batch = cold ? 1 : timing_batch_size;
+    std::vector<int> keys = orderKeys(data_to_search, mode);
+    if (cold) {
+        keys = sampleKeys(keys, COLD_MAX_SAMPLES);
+    }
+
+    BenchmarkResult result;
+    result.tree_type = type;
+    result.operation = "Search";
+    result.data_size = data_to_search.size();
+    result.timing_batch = batch;
+    result.cache_mode = mode;
+
+    TreeStatistics before = tree->getStatistics();
+    std::vector<long long>* raw = reserveRawLatency(result, keys.size());
+    MemorySnapshot memory_before = MemoryTracker::beginPhase();
+
+    // Счетчики в режиме COLD не снимаются: проход по буферу перекрыл бы работу дерева
+    startCacheSimulation();
+    if (!cold) perf_counters.start();
+    PhaseProfiler::start();
+    long long timed_ns = timeOperations(tree.get(), keys.size(), batch, result.latency,
+        [&](size_t i) { return tree->search(keys[i]); },
+        [&]() { if (cold) evictCaches(); }, raw);
+    result.phases = PhaseProfiler::stop();
+    if (!cold) result.counters = perf_counters.stop();
+    result.cache = finishCacheSimulation();
+
+    // Сумма замеров операций (вытеснения в нее не входят)
+    fillPhaseTime(result, timed_ns, keys.size());
+    result.min_time_ns = result.latency.getMin();
+    result.max_time_ns = result.latency.getMax();
+    result.final_height = tree->getHeight();
+    result.final_nodes = tree->getNodeCount();
+    fillStructureWork(result, tree.get(), before);
+    fillMemoryUsage(result, tree, memory_before);
+
+    return result;
+}
+
+BenchmarkResult Benchmark::testDeletion(TreeType type, const std::vector<int>& data_to_insert,
+    const std::vector<int>& data_to_remove, CacheMode mode, const TreeBase* snapshot) {
+    TraceSpan span("Deletion", "phase", getTreeName(type) + "/" + getCacheModeName(mode),
+        static_cast<long long>(data_to_remove.size()));
+    std::vector<std::unique_ptr<char[]>> spacers;
+    auto tree = prepareTree(type, data_to_insert, mode, snapshot, spacers);
+    if (!tree) return BenchmarkResult();
+    // Вытеснение стоит миллисекунды, поэтому в режиме COLD замеряется не больше
+    // COLD_MAX_SAMPLES операций по выборке ключей. Кэши вытесняются перед
+    // каждой: в пакете холодной была бы только первая операция
+    bool cold = mode == CacheMode::COLD;
+    int batch = cold ? 1 : timing_batch_size;
+    std::vector<int> keys = orderKeys(data_to_remove, mode);
+    if (cold) {
+        keys = sampleKeys(keys, COLD_MAX_SAMPLES);
+    }
+
+    BenchmarkResult result;
+    result.tree_type = type;
+    result.operation = "Deletion";
+    result.data_size = data_to_remove.size();
+    result.timing_batch = batch;
+    result.cache_mode = mode;
+
+    TreeStatistics before = tree->getStatistics();
+    // В режиме COLD удаляется только выборка ключей - динамика не пишется
+    TelemetrySampler telemetry(warming_up || cold ? 0 : telemetry_interval, before);
+    std::vector<long long>* raw = reserveRawLatency(result, keys.size());
+    MemorySnapshot memory_before = MemoryTracker::beginPhase();
+
+    // Счетчики в режиме COLD не снимаются: проход по буферу перекрыл бы работу дерева
+    startCacheSimulation();
+    if (!cold) perf_counters.start();
+    PhaseProfiler::start();
+    long long timed_ns = timeOperations(tree.get(), keys.size(), batch, result.latency,
+        [&](size_t i) { return tree->remove(keys[i]); },
+        [&]() { if (cold) evictCaches(); }, raw,
+        [&](long long op_index, long long latency_ns) {
+            if (telemetry.isDue(op_index)) {
+                sampleTelemetry(telemetry, op_index, tree.get(), latency_ns);
+            }
+        });
+    result.phases = PhaseProfiler::stop();
+    if (!cold) result.counters = perf_counters.stop();
+    result.cache = finishCacheSimulation();
+
+    // Сумма замеров операций (вытеснения и замеры динамики в нее не входят)
+    fillPhaseTime(result, timed_ns, keys.size());
+    result.min_time_ns = result.latency.getMin();
+    result.max_time_ns = result.latency.getMax();
+    result.final_height = tree->getHeight();
+    result.final_nodes = tree->getNodeCount();
+    fillStructureWork(result, tree.get(), before);
+    fillMemoryUsage(result, tree, memory_before);
+    result.telemetry = telemetry.getSamples();
+
+    return result;
+}
+
+void Benchmark::runParallel(int threads, size_t count, LatencyHistogram& latency,
+    const std::function<void(size_t, size_t, LatencyHistogram&)>& body) {
+    if (threads < 1) threads = 1;
+    TraceSpan span("Parallel", "thread", std::string(), threads);
+
+    std::vector<std::thread> workers;
+    std::vector<LatencyHistogram> local_latency(threads);
+    size_t chunk = (count + threads - 1) / threads;
+
+    for (int t = 0; t < threads; t++) {
+        size_t begin = std::min(count, t * chunk);
+        size_t end = std::min(count, begin + chunk);
+        workers.emplace_back([&, t, begin, end]() {
+            if (TraceRecorder::isEnabled()) {
+                TraceRecorder::setThreadName("worker " + std::to_string(t));
+            }
+            TraceSpan worker_span("Worker", "thread", std::string(), static_cast<long long>(end - begin));
+            body(begin, end, local_latency[t]);
+            });
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    // Гистограммы потоков сводятся после завершения всех потоков
+    for (const auto& part : local_latency) {
+        latency.merge(part);
+    }
+}
+
+BenchmarkResult Benchmark::testConcurrentInsertion(TreeType type, const std::vector<int>& data,
+    int threads) {
+    auto tree = createSynchronizedTree(type, SyncMode::MUTEX);
+    if (!tree) return BenchmarkResult();
+
+    BenchmarkResult result;
+    result.tree_type = type;
+    result.operation = "ConcurrentInsertion";
+    result.data_size = data.size();
+    result.threads = threads;
+
+    TreeStatistics before = tree->getStatistics();
+    MemorySnapshot memory_before = MemoryTracker::beginPhase();
+    auto start = std::chrono::high_resolution_clock::now();
+
+    runParallel(threads, data.size(), result.latency,
+        [&](size_t begin, size_t end, LatencyHistogram& latency) {
+        for (size_t i = begin; i < end; i++) {
+            long long time = tree->insert(data[i]).time_ns;
+            statistics.registerInsert(tree.get(), time);
+            latency.record(time);
+        }
+        });
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    result.total_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    result.avg_time_ns = data.empty() ? 0 : result.total_time_ns / data.size();
+    result.min_time_ns = result.latency.getMin();
+    result.max_time_ns = result.latency.getMax();
+    result.final_height = tree->getHeight();
+    result.final_nodes = tree->getNodeCount();
+    fillStructureWork(result, tree.get(), before);
+    fillMemoryUsage(result, tree, memory_before);
+
+    return result;
+}
+
+BenchmarkResult Benchmark::testConcurrentSearch(TreeType type, const std::vector<int>& data_to_insert,
+    const std::vector<int>& data_to_search, int threads) {
+    auto tree = createSynchronizedTree(type, SyncMode::MUTEX);
+    if (!tree) return BenchmarkResult();
+
+    // Сначала заполняем дерево в одном потоке
+    for (int key : data_to_insert) {
+        tree->insert(key);
+    }
+
+    BenchmarkResult result;
+    result.tree_type = type;
+    result.operation = "ConcurrentSearch";
+    result.data_size = data_to_search.size();
+    result.threads = threads;
+
+    TreeStatistics before = tree->getStatistics();
+    MemorySnapshot memory_before = MemoryTracker::beginPhase();
+    auto start = std::chrono::high_resolution_clock::now();
+
+    runParallel(threads, data_to_search.size(), result.latency,
+        [&](size_t begin, size_t end, LatencyHistogram& latency) {
+        for (size_t i = begin; i < end; i++) {
+            long long time = tree->search(data_to_search[i]).time_ns;
+            statistics.registerSearch(tree.get(), time);
+            latency.record(time);
+        }
+        });
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    result.total_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    result.avg_time_ns = data_to_search.empty() ? 0 : result.total_time_ns / data_to_search.size();
+    result.min_time_ns = result.latency.getMin();
+    result.max_time_ns = result.latency.getMax();
+    result.final_height = tree->getHeight();
+    result.final_nodes = tree->getNodeCount();
+    fillStructureWork(result, tree.get(), before);
+    fillMemoryUsage(result, tree, memory_before);
+
+    return result;
+}
+
+BenchmarkResult Benchmark::testShardedInsertion(TreeType type, const std::vector<int>& data,
+    int threads, int shards) {
+    auto tree = std::make_unique<ShardedTree>(type, shards);
+
+    BenchmarkResult result;
+    result.tree_type = type;
+    result.operation = "ShardedInsertion";
+    result.data_size = data.size();
+    result.threads = threads;
+
+    TreeStatistics before = tree->getStatistics();
+    MemorySnapshot memory_before = MemoryTracker::beginPhase();
+    auto start = std::chrono::high_resolution_clock::now();
+
+    runParallel(threads, data.size(), result.latency,
+        [&](size_t begin, size_t end, LatencyHistogram& latency) {
+        for (size_t i = begin; i < end; i++) {
+            long long time = tree->insert(data[i]).time_ns;
+            statistics.registerInsert(tree.get(), time);
+            latency.record(time);
+        }
+        });
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    result.total_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    result.avg_time_ns = data.empty() ? 0 : result.total_time_ns / data.size();
+    result.min_time_ns = result.latency.getMin();
+    result.max_time_ns = result.latency.getMax();
+    result.final_height = tree->getHeight();
+    result.final_nodes = tree->getNodeCount();
+    fillStructureWork(result, tree.get(), before);
+    fillMemoryUsage(result, tree, memory_before);
+
+    return result;
+}
+
+BenchmarkResult Benchmark::testShardedBulkLoad(TreeType type, const std::vector<int>& data,
+    int shards) {
+    auto tree = std::make_unique<ShardedTree>(type, shards);
+
+    BenchmarkResult result;
+    result.tree_type = type;
+    result.operation = "ShardedBulkLoad";
+    result.data_size = data.size();
+    result.threads = shards;
+
+    TreeStatistics before = tree->getStatistics();
+    MemorySnapshot memory_before = MemoryTracker::beginPhase();
+    auto start = std::chrono::high_resolution_clock::now();
+
+    tree->bulkLoad(data);
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    result.total_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    result.avg_time_ns = data.empty() ? 0 : result.total_time_ns / data.size();
+    result.min_time_ns = result.latency.getMin();
+    result.max_time_ns = result.latency.getMax();
+    result.final_height = tree->getHeight();
+    result.final_nodes = tree->getNodeCount();
+    fillStructureWork(result, tree.get(), before);
+    fillMemoryUsage(result, tree, memory_before);
+
+    return result;
+}
+
+BenchmarkResult Benchmark::testSynchronizedMixed(TreeType type, const std::vector<int>& data,
+    int threads, SyncMode mode, int read_percent) {
+    auto tree = createSynchronizedTree(type, mode);
+    if (!tree) return BenchmarkResult();
+
+    // Половина ключей вставляется заранее, чтобы поиск находил элементы
+    for (size_t i = 0; i < data.size(); i += 2) {
+        tree->insert(data[i]);
+    }
+
+    BenchmarkResult result;
+    result.tree_type = type;
+    switch (mode) {
+    case SyncMode::MUTEX:
+        result.operation = "Mixed/Mutex";
+        break;
+    case SyncMode::RW_LOCK:
+        result.operation = "Mixed/RWLock";
+        break;
+    case SyncMode::FLAT_COMBINING:
+        result.operation = "Mixed/FlatCombining";
+        break;
+    }
+    result.data_size = data.size();
+    result.threads = threads;
+
+    TreeStatistics before = tree->getStatistics();
+    MemorySnapshot memory_before = MemoryTracker::beginPhase();
+    auto start = std::chrono::high_resolution_clock::now();
+
+    runParallel(threads, data.size(), result.latency,
+        [&](size_t begin, size_t end, LatencyHistogram& latency) {
+        for (size_t i = begin; i < end; i++) {
+            int key = data[i];
+            if (static_cast<int>(i % 100) < read_percent) {
+                long long time = tree->search(key).time_ns;
+                statistics.registerSearch(tree.get(), time);
+                latency.record(time);
+            }
+            else if (i % 2 == 0) {
+                long long time = tree->remove(key).time_ns;
+                statistics.registerDelete(tree.get(), time);
+                latency.record(time);
+            }
+            else {
+                long long time = tree->insert(key).time_ns;
+                statistics.registerInsert(tree.get(), time);
+                latency.record(time);
+            }
+        }
+        });
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    result.total_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    result.avg_time_ns = data.empty() ? 0 : result.total_time_ns / data.size();
+    result.min_time_ns = result.latency.getMin();
+    result.max_time_ns = result.latency.getMax();
+    result.final_height = tree->getHeight();
+    result.final_nodes = tree->getNodeCount();
+    fillStructureWork(result, tree.get(), before);
+    fillMemoryUsage(result, tree, memory_before);
+
+    return result;
+}
+
+std::vector<BenchmarkResult> Benchmark::runFullTest(int data_size, DataOrder order,
+    int iterations) {
+    std::vector<TreeType> tree_types = {
+        TreeType::AVL,
+        TreeType::AA,
+        TreeType::TREAP,
+        TreeType::TWO_THREE,
+        TreeType::SKIP_LIST
+    };
+    return runFullTest(data_size, order, iterations, tree_types);
+}
+
+std::vector<BenchmarkResult> Benchmark::runFullTest(int data_size, DataOrder order,
+    int iterations, const std::vector<TreeType>& tree_types) {
+    DataGenerator generator;
+    return runFullTest([&]() { return generator.generate(data_size, order); },
+        order, iterations, tree_types);
+}
+
+std::vector<BenchmarkResult> Benchmark::runCell(TreeType type, const std::vector<int>& data) {
+    TraceSpan span("Cell", "cell", getTreeName(type), static_cast<long long>(data.size()));
+    std::vector<BenchmarkResult> cell_results;
+    cell_results.push_back(testInsertion(type, data));
+
+    // Дерево строится один раз: все фазы поиска и удаления работают
+    // с копиями одной формы
+    auto snapshot = buildSnapshot(type, data);
+    for (CacheMode mode : cache_modes) {
+        cell_results.push_back(testSearch(type, data, data, mode, snapshot.get()));
+        cell_results.push_back(testDeletion(type, data, data, mode, snapshot.get()));
+    }
+    return cell_results;
+}
+
+std::vector<BenchmarkResult> Benchmark::runFullTest(const std::function<std::vector<int>()>& make_data,
+    DataOrder order, int iterations, const std::vector<TreeType>& tree_types) {
+    std::vector<BenchmarkResult> results;
+
+    int max_runs = std::max(1, iterations);
+    int min_runs = std::min(std::max(1, repetition_policy.min_runs), max_runs);
+
+    bool isolated = isolation_policy.enabled && CellIsolation::isSupported();
+    if (isolation_policy.enabled && !isolated) {
+        std::cerr << "Изоляция процессами недоступна, ячейки выполняются в текущем процессе" << std::endl;
+    }
+
+    // Прогрев: кэши, предсказатель переходов и аллокатор приходят
+    // в установившееся состояние, результаты отбрасываются. В изолированном
+    // режиме прогрев выполняет каждый дочерний процесс перед своей ячейкой
+    warming_up = true;
+    for (int i = 0; i < repetition_policy.warmup_runs && !isolated; i++) {
+        TraceSpan span("Warmup", "cell", std::string(), i);
+        std::vector<int> data = make_data();
+        for (TreeType type : tree_types) {
+            testInsertion(type, data);
+            auto snapshot = buildSnapshot(type, data);
+            testSearch(type, data, data, CacheMode::WARM, snapshot.get());
+            testDeletion(type, data, data, CacheMode::WARM, snapshot.get());
+        }
+    }
+    warming_up = false;
+
+    // Время на операцию по повторам для каждой ячейки дерева
+    std::map<TreeType, std::map<std::string, std::vector<double>>> samples;
+    std::vector<TreeType> pending = tree_types;
+
+    auto deadline = std::chrono::steady_clock::now() +
+        std::chrono::milliseconds(repetition_policy.time_budget_ms);
+
+    for (int run = 0; run < max_runs && !pending.empty(); run++) {
+        if (run >= min_runs && std::chrono::steady_clock::now() >= deadline) break;
+
+        TraceSpan span("Repetition", "cell", std::string(), run);
+        std::vector<int> data = make_data();
+        std::vector<TreeType> failed;
+
+        for (TreeType type : pending) {
+            std::vector<BenchmarkResult> cell_results;
+            if (isolated) {
+                // События трассы и статистика дочернего процесса переносятся
+                // сюда, события ложатся внутрь интервала ожидания ячейки
+                TraceSpan cell_span("IsolatedCell", "cell", getTreeName(type), static_cast<long long>(data.size()));
+                std::string error;
+                CellIsolation::Status status = CellIsolation::run([&]() {
+                    perf_counters.reopen();
+                    warming_up = true;
+                    for (int i = 0; i < repetition_policy.warmup_runs; i++) {
+                        runCell(type, data);
+                    }
+                    warming_up = false;
+                    return runCell(type, data);
+                    }, isolation_policy.cell_timeout_ms, &statistics, cell_results, error);
+
+                if (status != CellIsolation::COMPLETED) {
+                    std::cerr << getTreeName(type) << ", n = " << data.size() << ", повтор " << run + 1
+                        << ": " << error << "; дерево исключено из дальнейших повторов" << std::endl;
+                    failed.push_back(type);
+                    continue;
+                }
+            }
+            else {
+                cell_results = runCell(type, data);
+            }
+
+            for (BenchmarkResult& result : cell_results) {
+                result.run = run;
+                result.data_order = order;
+                std::string cell = result.operation + "/" + getCacheModeName(result.cache_mode);
+                samples[type][cell].push_back(result.nsPerOperation());
+            }
+            if (cell_observer) {
+                cell_observer(cell_results);
+            }
+            // Сырые замеры уже отданы наблюдателю: за весь прогон они заняли бы гигабайты
+            for (BenchmarkResult& result : cell_results) {
+                std::vector<long long>().swap(result.raw_latency_ns);
+                results.push_back(std::move(result));
+            }
+        }
+
+        for (TreeType type : failed) {
+            pending.erase(std::remove(pending.begin(), pending.end(), type), pending.end());
+        }
+
+        if (run + 1 < min_runs || repetition_policy.target_ci_percent <= 0) continue;
+
+        // Дерево перестает повторяться, когда все его ячейки достигли цели
+        pending.erase(std::remove_if(pending.begin(), pending.end(), [&](TreeType type) {
+            for (const auto& cell : samples[type]) {
+                double width = SampleStatistics::summarize(cell.second).getRelativeCIHalfWidth();
+                if (width < 0 || width > repetition_policy.target_ci_percent) return false;
+            }
+            return true;
+            }), pending.end());
+    }
+
+    return results;
+}
+
+std::vector<BenchmarkResult> Benchmark::runScalingTest(int data_size, DataOrder order,
+    const std::vector<int>& thread_counts, int iterations) {
+    std::vector<BenchmarkResult> results;
+    DataGenerator generator;
+
+    std::vector<TreeType> tree_types = {
+        TreeType::AVL,
+        TreeType::AA,
+        TreeType::TREAP,
+        TreeType::TWO_THREE,
+        TreeType::SKIP_LIST
+    };
+
+    for (int i = 0; i < iterations; i++) {
+        std::vector<int> data = generator.generate(data_size, order);
+
+        for (int threads : thread_counts) {
+            for (TreeType type : tree_types) {
+                results.push_back(testConcurrentInsertion(type, data, threads));
+                results.push_back(testConcurrentSearch(type, data, data, threads));
+
+                // Шардирование имеет смысл только для однопоточных деревьев
+                if (type != TreeType::SKIP_LIST) {
+                    results.push_back(testShardedInsertion(type, data, threads, threads * 4));
+                    results.push_back(testShardedBulkLoad(type, data, threads));
+
+                    // Сравнение способов синхронизации на смешанной нагрузке
+                    results.push_back(testSynchronizedMixed(type, data, threads, SyncMode::MUTEX));
+                    results.push_back(testSynchronizedMixed(type, data, threads, SyncMode::RW_LOCK));
+                    results.push_back(testSynchronizedMixed(type, data, threads, SyncMode::FLAT_COMBINING));
+                }
+            }
+        }
+    }
+
+    return results;
+}
+
+bool Benchmark::saveResultsToCSV(const std::vector<BenchmarkResult>& results,
+    const std::string& filename) {
+    TraceSpan span("WriteCSV", "io", std::string(), static_cast<long long>(results.size()));
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Ќе удалось открыть файл: " << filename << std::endl;
+        return false;
+    }
+
+    // ‡аголовок CSV
+    file << "TreeType;Operation;DataSize;TotalTimeNs;AvgTimeNs;"
+        << "FinalHeight;FinalNodes;Rotations;Threads;MemoryBytes;BytesPerKey;"
+        << "MinTimeNs;MaxTimeNs;P50Ns;P90Ns;P99Ns;P999Ns";
+    for (int i = 0; i < PerfSample::COUNTER_COUNT; i++) {
+        file << ";" << PerfSample::getCounterName(static_cast<PerfSample::Counter>(i)) << "PerOp";
+    }
+    file << ";IPC";
+    for (int i = 0; i < CacheSimulationCounters::LEVEL_COUNT; i++) {
+        file << ";Sim" << CacheSimulationCounters::getLevelName(static_cast<CacheSimulationCounters::Level>(i))
+            << "MissesPerOp";
+    }
+    file << ";Comparisons;NodeVisits;Skews;Splits;Merges;Borrows;Allocations;"
+        << "ComparisonsPerOp;NodeVisitsPerOp;Log2N;"
+        << "HeapBytes;HeapBytesPerKey;PeakHeapBytes;HeapAllocations;RssBytes;"
+        << "Run;NsPerOp;TimerSource;TimerResolutionNs;TimerOverheadNs;TimingBatch;DataOrder;"
+        << "FootprintBytes;CacheMode";
+    for (int i = 0; i < PhaseSample::PHASE_COUNT; i++) {
+        file << ";" << PhaseSample::getPhaseName(static_cast<PhaseSample::Phase>(i)) << "NsPerOp";
+    }
+    file << "\n";
+
+    for (const auto& result : results) {
+        file << tree_names[result.tree_type] << ";"
+            << result.operation << ";"
+            << result.data_size << ";"
+            << result.total_time_ns << ";"
+            << result.avg_time_ns << ";"
+            << result.final_height << ";"
+            << result.final_nodes << ";"
+            << result.rotations << ";"
+            << result.threads << ";"
+            << result.memory_bytes << ";"
+            << result.bytes_per_key << ";"
+            << result.min_time_ns << ";"
+            << result.max_time_ns << ";"
+            << result.latency.getPercentile(50.0) << ";"
+            << result.latency.getPercentile(90.0) << ";"
+            << result.latency.getPercentile(99.0) << ";"
+            << result.latency.getPercentile(99.9);
+
+        // Недоступные счетчики оставляются пустыми
+        for (int i = 0; i < PerfSample::COUNTER_COUNT; i++) {
+            auto counter = static_cast<PerfSample::Counter>(i);
+            file << ";";
+            if (result.counters.isValid(counter)) {
+                file << result.counters.perOperation(counter, result.data_size);
+            }
+        }
+        file << ";";
+        if (result.counters.getIPC() >= 0) {
+            file << result.counters.getIPC();
+        }
+        for (int i = 0; i < CacheSimulationCounters::LEVEL_COUNT; i++) {
+            file << ";";
+            if (result.cache.valid) {
+                file << result.cache.perOperation(static_cast<CacheSimulationCounters::Level>(i), result.data_size);
+            }
+        }
+        file << ";" << result.comparisons
+            << ";" << result.node_visits
+            << ";" << result.skews
+            << ";" << result.splits
+            << ";" << result.merges
+            << ";" << result.borrows
+            << ";" << result.allocations
+            << ";" << result.comparisonsPerOperation()
+            << ";" << result.nodeVisitsPerOperation()
+            << ";" << result.getLog2Size()
+            << ";" << result.heap_bytes
+            << ";" << result.heapBytesPerKey()
+            << ";" << result.peak_heap_bytes
+            << ";" << result.heap_allocations
+            << ";" << result.rss_bytes
+            << ";" << result.run
+            << ";" << result.nsPerOperation()
+            << ";" << Timer::getSourceName()
+            << ";" << Timer::getResolutionNs()
+            << ";" << Timer::getOverheadNs()
+            << ";" << result.timing_batch
+            << ";" << DataGenerator::getOrderName(result.data_order)
+            << ";" << result.footprint_bytes
+            << ";" << getCacheModeName(result.cache_mode);
+
+        // Без ENABLE_PHASE_PROFILING столбцы фаз пустые
+        for (int i = 0; i < PhaseSample::PHASE_COUNT; i++) {
+            file << ";";
+            if (result.phases.valid) {
+                file << result.phases.perOperation(static_cast<PhaseSample::Phase>(i));
+            }
+        }
+        file << "\n";
+    }
+
+    file.close();
+    if (file.fail()) {
+        std::cerr << "Ошибка записи файла: " << filename << std::endl;
+        return false;
+    }
+    std::cout << "Результаты сохранены в: " << filename << std::endl;
+    return true;
+}
+
+bool Benchmark::saveTelemetryToCSV(const std::vector<BenchmarkResult>& results,
+    const std::string& filename) {
+    TraceSpan span("WriteCSV", "io", "telemetry", static_cast<long long>(results.size()));
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Не удалось открыть файл: " << filename << std::endl;
+        return false;
+    }
+
+    file << "TreeType;Operation;DataSize;DataOrder;Run;OpIndex;Height;Nodes;"
+        << "Rotations;Skews;Splits;Merges;LastLatencyNs\n";
+
+    for (const auto& result : results) {
+        for (const auto& sample : result.telemetry) {
+            file << tree_names[result.tree_type] << ";" << result.operation << ";" << result.data_size << ";"
+                << DataGenerator::getOrderName(result.data_order) << ";" << result.run << ";"
+                << sample.op_index << ";" << sample.height << ";" << sample.nodes << ";"
+                << sample.rotations << ";" << sample.skews << ";" << sample.splits << ";"
+                << sample.merges << ";" << sample.last_latency_ns << "\n";
+        }
+    }
+
+    file.close();
+    if (file.fail()) {
+        std::cerr << "Ошибка записи файла: " << filename << std::endl;
+        return false;
+    }
+    std::cout << "Динамика структуры сохранена в: " << filename << std::endl;
+    return true;
+}
+
+void Benchmark::printCounters(const std::vector<BenchmarkResult>& result_group) {
+    // Суммы по всем прогонам группы, затем деление на общее число операций
+    PerfSample total;
+    long long operations = 0;
+    for (const auto& result : result_group) {
+        for (int i = 0; i < PerfSample::COUNTER_COUNT; i++) {
+            if (result.counters.valid[i]) {
+                total.values[i] += result.counters.values[i];
+                total.valid[i] = true;
+            }
+        }
+        operations += result.data_size;
+    }
+
+    std::cout << "  Счетчики на операцию:";
+    for (int i = 0; i < PerfSample::COUNTER_COUNT; i++) {
+        auto counter = static_cast<PerfSample::Counter>(i);
+        if (total.isValid(counter)) {
+            std::cout << " " << PerfSample::getCounterName(counter) << "="
+                << std::fixed << std::setprecision(1) << total.perOperation(counter, operations);
+        }
+    }
+    if (total.getIPC() >= 0) {
+        std::cout << " IPC=" << std::setprecision(2) << total.getIPC();
+    }
+    std::cout << "\n";
+}
+
+void Benchmark::printStructureWork(const std::vector<BenchmarkResult>& result_group) {
+    // Суммы по прогонам группы в пересчете на одну операцию
+    BenchmarkResult total;
+    for (const auto& result : result_group) {
+        total.data_size += result.data_size;
+        total.comparisons += result.comparisons;
+        total.node_visits += result.node_visits;
+        total.rotations += result.rotations;
+        total.skews += result.skews;
+        total.splits += result.splits;
+        total.merges += result.merges;
+        total.borrows += result.borrows;
+        total.allocations += result.allocations;
+    }
+    if (total.data_size == 0 || total.node_visits == 0) return;
+
+    double log2_size = result_group[0].getLog2Size();
+    std::cout << "  Сравнений на операцию: " << std::fixed << std::setprecision(2)
+        << total.comparisonsPerOperation() << ", узлов: " << total.nodeVisitsPerOperation()
+        << " (log2 n = " << log2_size;
+    if (log2_size > 0) {
+        std::cout << ", отношение " << total.nodeVisitsPerOperation() / log2_size;
+    }
+    std::cout << ")\n";
+
+    double operations = total.data_size;
+    std::cout << "  Работа по структуре на операцию: повороты=" << std::setprecision(3)
+        << total.rotations / operations
+        << " skew=" << total.skews / operations
+        << " split=" << total.splits / operations
+        << " merge=" << total.merges / operations
+        << " borrow=" << total.borrows / operations
+        << " выделений=" << total.allocations / operations << "\n";
+}
+
+void Benchmark::printMemory(const std::vector<BenchmarkResult>& result_group) {
+    // Объем дерева одинаков для всех прогонов группы; пик и RSS берутся максимальные
+    const BenchmarkResult& first = result_group[0];
+    long long peak = 0;
+    long long rss = 0;
+    long long allocations = 0;
+    long long operations = 0;
+    for (const auto& result : result_group) {
+        peak = std::max(peak, result.peak_heap_bytes);
+        rss = std::max(rss, result.rss_bytes);
+        allocations += result.heap_allocations;
+        operations += result.data_size;
+    }
+
+    std::cout << "  Память дерева: " << Visualizer::formatMemory(first.heap_bytes);
+    if (first.final_nodes > 0) {
+        std::cout << " (" << std::fixed << std::setprecision(1) << first.heapBytesPerKey()
+            << " байт на ключ, оценка getMemoryUsage: " << first.bytes_per_key << ")";
+    }
+    std::cout << "\n";
+
+    std::cout << "  Пик кучи за фазу: " << Visualizer::formatMemory(peak)
+        << ", выделений на операцию: " << std::setprecision(2)
+        << (operations > 0 ? static_cast<double>(allocations) / operations : 0.0);
+    if (rss > 0) {
+        std::cout << ", RSS: " << Visualizer::formatMemory(rss);
+    }
+    std::cout << "\n";
+}
+
+void Benchmark::printSummary(const std::vector<BenchmarkResult>& result_group) {
+    std::vector<double> values;
+    for (const auto& result : result_group) {
+        values.push_back(result.nsPerOperation());
+    }
+    SampleSummary summary = SampleStatistics::summarize(values);
+
+    std::cout << "  По повторам (нс/оп): " << summary.toString()
+        << " (повторов: " << summary.count << ")\n";
+
+    // Ячейки, где разница между деревьями может оказаться в пределах шума
+    double width = summary.getRelativeCIHalfWidth();
+    double threshold = repetition_policy.getNoisePercent();
+    if (width < 0) {
+        std::cout << "  ВНИМАНИЕ: один повтор, разброс не оценен\n";
+    }
+    else if (width > threshold || summary.outliers > 0) {
+        std::cout << "  ВНИМАНИЕ: шумная ячейка - полуширина ДИ " << std::setprecision(1) << width
+            << "% (порог " << threshold << "%), выбросов: " << summary.outliers << "\n";
+    }
+}
+
+void Benchmark::printCacheSimulation(const std::vector<BenchmarkResult>& result_group) {
+    CacheSimulationCounters total;
+    total.valid = true;
+    long long operations = 0;
+    for (const auto& result : result_group) {
+        total.accesses += result.cache.accesses;
+        for (int i = 0; i < CacheSimulationCounters::LEVEL_COUNT; i++) {
+            total.misses[i] += result.cache.misses[i];
+        }
+        operations += result.data_size;
+    }
+
+    std::cout << "  Модель кэша, промахов на операцию:";
+    for (int i = 0; i < CacheSimulationCounters::LEVEL_COUNT; i++) {
+        auto level = static_cast<CacheSimulationCounters::Level>(i);
+        std::cout << " " << CacheSimulationCounters::getLevelName(level) << "="
+            << std::fixed << std::setprecision(2) << total.perOperation(level, operations);
+    }
+    std::cout << " (строк на операцию: " << std::setprecision(1)
+        << (operations > 0 ? static_cast<double>(total.accesses) / operations : 0.0) << ")\n";
+}
+
+void Benchmark::printPhases(const std::vector<BenchmarkResult>& result_group) {
+    PhaseSample total;
+    for (const auto& result : result_group) {
+        total.add(result.phases);
+    }
+
+    std::cout << "  Фазы операции (нс/оп):";
+    for (int i = 0; i < PhaseSample::PHASE_COUNT; i++) {
+        auto phase = static_cast<PhaseSample::Phase>(i);
+        std::cout << " " << PhaseSample::getPhaseName(phase) << "="
+            << std::fixed << std::setprecision(1) << total.perOperation(phase)
+            << " (" << std::setprecision(0) << total.getShare(phase) << "%)";
+    }
+    std::cout << "\n";
+}
+
+void Benchmark::printResults(const std::vector<BenchmarkResult>& results) {
+    std::cout << "\n=== РЕЗУЛЬТАТЫ ТЕСТИРОВАНИЯ ===\n\n";
+    std::cout << "Таймер: " << Timer::describe() << "\n\n";
+
+    std::map<std::tuple<TreeType, std::string, int, CacheMode>, std::vector<BenchmarkResult>> grouped_results;
+
+    for (const auto& result : results) {
+        auto key = std::make_tuple(result.tree_type, result.operation, result.threads, result.cache_mode);
+        grouped_results[key].push_back(result);
+    }
+
+    for (const auto& entry : grouped_results) {
+        TreeType tree_type = std::get<0>(entry.first);
+        std::string operation = std::get<1>(entry.first);
+        int threads = std::get<2>(entry.first);
+        CacheMode mode = std::get<3>(entry.first);
+        const std::vector<BenchmarkResult>& result_group = entry.second;
+        std::string tree_name = tree_names[tree_type];
+
+        std::cout << tree_name << " - " << operation;
+        if (mode != CacheMode::WARM) {
+            std::cout << " [" << getCacheModeName(mode) << "]";
+        }
+        if (threads > 1) {
+            std::cout << " (потоков: " << threads << ")";
+        }
+        std::cout << ":\n";
+
+        if (!result_group.empty()) {
+            double total_time_sum = 0.0;
+            double avg_time_sum = 0.0;
+            LatencyHistogram latency;
+
+            for (const auto& result : result_group) {
+                total_time_sum += result.total_time_ns;
+                avg_time_sum += result.nsPerOperation();
+                latency.merge(result.latency);
+            }
+
+            double avg_total_time = total_time_sum / result_group.size();
+            double avg_avg_time = avg_time_sum / result_group.size();
+
+            std::cout << std::fixed << std::setprecision(0)
+                << "  ‘реднее общее время: " << avg_total_time << " нс\n";
+            std::cout << std::setprecision(1)
+                << "  ‘реднее время на операцию: " << avg_avg_time << " нс\n";
+            printSummary(result_group);
+            std::cout << "  ”инальная высота: " << result_group[0].final_height << "\n";
+            std::cout << "  ”инальное количество узлов: " << result_group[0].final_nodes << "\n";
+            if (result_group[0].rotations > 0) {
+                std::cout << "  Љоличество поворотов: " << result_group[0].rotations << "\n";
+            }
+            if (latency.getCount() > 0) {
+                std::cout << "  Время операции (нс): " << latency.toString() << "\n";
+            }
+            printStructureWork(result_group);
+            if (result_group[0].counters.hasAny()) {
+                printCounters(result_group);
+            }
+            if (result_group[0].cache.valid) {
+                printCacheSimulation(result_group);
+            }
+            if (result_group[0].phases.valid) {
+                printPhases(result_group);
+            }
+            if (MemoryTracker::isAvailable()) {
+                printMemory(result_group);
+            }
+            else if (result_group[0].bytes_per_key > 0) {
+                std::cout << "  Память на ключ: " << std::fixed << std::setprecision(1)
+                    << result_group[0].bytes_per_key << " байт\n";
+            }
+        }
+        std::cout << "-------------------------\n";
+    }
+
+    printCacheModes(results);
+    printPhaseBreakdown(results);
+}
+
+void Benchmark::printCacheModes(const std::vector<BenchmarkResult>& results) {
+    // Сводная таблица нужна, только если фазы выполнялись в нескольких режимах
+    std::vector<CacheMode> modes;
+    for (const auto& result : results) {
+        if (std::find(modes.begin(), modes.end(), result.cache_mode) == modes.end()) {
+            modes.push_back(result.cache_mode);
+        }
+    }
+    if (modes.size() < 2) return;
+    std::sort(modes.begin(), modes.end());
+
+    std::map<std::pair<TreeType, std::string>, std::map<CacheMode, std::vector<double>>> cells;
+    for (const auto& result : results) {
+        if (result.operation != "Search" && result.operation != "Deletion") continue;
+        cells[{ result.tree_type, result.operation }][result.cache_mode].push_back(result.nsPerOperation());
+    }
+
+    std::cout << "\n=== РЕЖИМЫ КЭША (медиана нс/операцию) ===\n";
+    std::cout << std::left << std::setw(12) << "Tree" << std::setw(10) << "Operation" << std::right;
+    for (CacheMode mode : modes) {
+        std::cout << std::setw(10) << getCacheModeName(mode);
+    }
+    std::cout << "\n";
+
+    for (const auto& cell : cells) {
+        std::cout << std::left << std::setw(12) << tree_names[cell.first.first]
+            << std::setw(10) << cell.first.second << std::right << std::fixed << std::setprecision(1);
+        for (CacheMode mode : modes) {
+            auto it = cell.second.find(mode);
+            if (it == cell.second.end()) {
+                std::cout << std::setw(10) << "-";
+                continue;
+            }
+            std::cout << std::setw(10) << SampleStatistics::summarize(it->second).median;
+        }
+        std::cout << "\n";
+    }
+}
+
+void Benchmark::printPhaseBreakdown(const std::vector<BenchmarkResult>& results) {
+    // Режимы кэша меняют стоимость спуска, поэтому сводка - по теплому режиму
+    std::map<std::pair<TreeType, std::string>, PhaseSample> cells;
+    for (const auto& result : results) {
+        if (!result.phases.valid || result.cache_mode != CacheMode::WARM || result.threads > 1) continue;
+        cells[{ result.tree_type, result.operation }].add(result.phases);
+    }
+    if (cells.empty()) return;
+
+    std::cout << "\n=== ФАЗЫ ОПЕРАЦИЙ (нс/операцию, доля) ===\n";
+    std::cout << std::left << std::setw(12) << "Tree" << std::setw(10) << "Operation" << std::right;
+    for (int i = 0; i < PhaseSample::PHASE_COUNT; i++) {
+        std::cout << std::setw(20) << PhaseSample::getPhaseName(static_cast<PhaseSample::Phase>(i));
+    }
+    std::cout << "\n";
+
+    for (const auto& cell : cells) {
+        std::cout << std::left << std::setw(12) << tree_names[cell.first.first]
+            << std::setw(10) << cell.first.second << std::right;
+        for (int i = 0; i < PhaseSample::PHASE_COUNT; i++) {
+            auto phase = static_cast<PhaseSample::Phase>(i);
+            std::ostringstream value;
+            value << std::fixed << std::setprecision(1) << cell.second.perOperation(phase)
+                << " (" << std::setprecision(0) << cell.second.getShare(phase) << "%)";
+            std::cout << std::setw(20) << value.str();
+        }
+        std::cout << "\n";
+    }
 }
\ No newline at end of file
@@ -1,58 +1,295 @@
-#pragma once
-// include/Benchmark.h
-#ifndef BENCHMARK_H
-#define BENCHMARK_H
-
-#include <vector>
-#include <memory>
-#include <map>
-#include <string>
-
-#include "CommonTypes.h"
-#include "TreeBase.h"
-
-struct BenchmarkResult {
-    TreeType tree_type;
-    std::string operation;
-    int data_size;
-    DataOrder data_order;
-
-    long long total_time_ns;
-    long long avg_time_ns;
-    long long min_time_ns;
-    long long max_time_ns;
-
-    int final_height;
-    int final_nodes;
-    int rotations;
-    int comparisons;
-};
-
-class Benchmark {
-private:
-    std::map<TreeType, std::string> tree_names;
-    std::unique_ptr<TreeBase> createTree(TreeType type);
-
-public:
-    Benchmark();
-
-    //   
-    BenchmarkResult testInsertion(TreeType type, const std::vector<int>& data);
-    BenchmarkResult testSearch(TreeType type, const std::vector<int>& data_to_insert,
-        const std::vector<int>& data_to_search);
-    BenchmarkResult testDeletion(TreeType type, const std::vector<int>& data_to_insert,
-        const std::vector<int>& data_to_remove);
-
-    //  
-    std::vector<BenchmarkResult> runFullTest(int data_size, DataOrder order,
-        int iterations = 10);
-
-    //  
-    void saveResultsToCSV(const std::vector<BenchmarkResult>& results,
-        const std::string& filename);
-
-    //   
-    void printResults(const std::vector<BenchmarkResult>& results);
-};
-
+#pragma once
+// include/Benchmark.h
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <functional>
+#include <vector>
+#include <memory>
+#include <map>
+#include <string>
+
+#include "CacheSimulator.h"
+#include "CommonTypes.h"
+#include "ConcurrentTree.h"
+#include "LatencyHistogram.h"
+#include "MemoryTracker.h"
+#include "PerfCounters.h"
+#include "PhaseProfiler.h"
+#include "SampleStatistics.h"
+#include "Statistics.h"
+#include "TelemetrySampler.h"
+#include "TreeBase.h"
+
+struct BenchmarkResult {
+    TreeType tree_type = TreeType::UNKNOWN;
+    std::string operation;
+    int data_size = 0;
+    DataOrder data_order = DataOrder::RANDOM;
+    CacheMode cache_mode = CacheMode::WARM;
+    int run = 0;                    // Номер повтора (прогревочные не сохраняются)
+    int timing_batch = 1;           // Операций на одну пару отметок времени
+
+    long long total_time_ns = 0;
+    long long avg_time_ns = 0;
+    long long min_time_ns = 0;
+    long long max_time_ns = 0;
+
+    double nsPerOperation() const;  // Без целочисленного деления avg_time_ns
+
+    int final_height = 0;
+    int final_nodes = 0;
+
+    // Работа по структуре за фазу (разность счетчиков дерева до и после)
+    int rotations = 0;
+    long long comparisons = 0;
+    long long node_visits = 0;
+    int skews = 0;                  // АА
+    int splits = 0;                 // АА, Treap, 2-3
+    int merges = 0;                 // Treap, 2-3
+    int borrows = 0;                // 2-3
+    long long allocations = 0;
+
+    double comparisonsPerOperation() const;
+    double nodeVisitsPerOperation() const;
+    double getLog2Size() const;     // Теоретическая оценка глубины спуска
+
+    int threads = 1;                // Количество потоков, выполнявших операцию
+    long long memory_bytes = 0;     // Оценка getMemoryUsage() после операции
+    double bytes_per_key = 0.0;
+
+    // Измерения MemoryTracker. heap_bytes - объем кучи, освобожденный при
+    // уничтожении дерева после фазы (узлы, буферы векторов 2-3 дерева, шарды)
+    long long heap_bytes = 0;
+    long long peak_heap_bytes = 0;  // Пик кучи за фазу сверх уровня до ее начала
+    long long heap_allocations = 0; // Вызовов operator new за фазу
+    long long rss_bytes = 0;        // Резидентная память процесса после фазы
+    long long footprint_bytes = 0;  // Объем дерева из data_size ключей (проход по уровням кэша)
+
+    double heapBytesPerKey() const;
+
+    LatencyHistogram latency;       // Распределение времени отдельных операций
+    PerfSample counters;            // Аппаратные счетчики за всю фазу (если доступны)
+    CacheSimulationCounters cache;  // Промахи модели кэша (только в режиме трассировки)
+    PhaseSample phases;             // Время по фазам операций (сборка с ENABLE_PHASE_PROFILING)
+
+    // Динамика структуры во время вставки и удаления (пусто, если замер выключен)
+    std::vector<TelemetrySample> telemetry;
+
+    // Время каждой замеренной операции (при пакетном замере - среднее пакета)
+    // в порядке выполнения. Пусто, если сбор выключен; runFullTest отдает
+    // их наблюдателю ячейки и в results не хранит
+    std::vector<long long> raw_latency_ns;
+};
+
+// Правила повторов runFullTest: после прогрева дерево повторяется,
+// пока 95% ДИ времени на операцию всех его ячеек не станет уже цели
+// (но не меньше min_runs), либо пока не кончатся повторы или время
+struct RepetitionPolicy {
+    int warmup_runs = 1;
+    int min_runs = 3;
+    double target_ci_percent = 2.0;     // Полуширина ДИ в % от среднего; 0 - все повторы
+    long long time_budget_ms = 120000;  // На все повторы теста
+
+    // Порог пометки шумных ячеек при выводе
+    static constexpr double DEFAULT_NOISE_PERCENT = 5.0;
+    double getNoisePercent() const;
+};
+
+// Изоляция ячеек runFullTest (дерево x повтор) дочерними процессами
+struct IsolationPolicy {
+    bool enabled = false;
+    long long cell_timeout_ms = 600000;     // 0 - без предела
+};
+
+class Benchmark {
+private:
+    std::map<TreeType, std::string> tree_names;
+    std::unique_ptr<TreeBase> createSynchronizedTree(TreeType type, SyncMode mode);
+
+    // Дерево, заполненное один раз без замера; фазы поиска и удаления получают его копии
+    std::unique_ptr<TreeBase> buildSnapshot(TreeType type, const std::vector<int>& keys);
+
+    // Дерево для фазы: копия snapshot или заполнение заново. Заново заполняются
+    // дерево режима TLB_COLD (промежутки между узлами) и дерево при модели кэша
+    // (трасса заполнения прогревает моделируемый кэш)
+    std::unique_ptr<TreeBase> prepareTree(TreeType type, const std::vector<int>& keys, CacheMode mode,
+        const TreeBase* snapshot, std::vector<std::unique_ptr<char[]>>& spacers);
+
+    // Ячейка runFullTest: вставка, затем поиск и удаление во всех режимах кэша
+    std::vector<BenchmarkResult> runCell(TreeType type, const std::vector<int>& data);
+
+    // Время отдельных операций многопоточных тестов (шард на каждый поток)
+    StatisticsCollector statistics;
+
+    // Счетчики открываются один раз и снимаются вокруг однопоточных фаз
+    PerfCounters perf_counters;
+    void printCounters(const std::vector<BenchmarkResult>& result_group);
+    void printCacheSimulation(const std::vector<BenchmarkResult>& result_group);
+    void printStructureWork(const std::vector<BenchmarkResult>& result_group);
+    void printMemory(const std::vector<BenchmarkResult>& result_group);
+    void printSummary(const std::vector<BenchmarkResult>& result_group);
+    void printCacheModes(const std::vector<BenchmarkResult>& results);
+    void printPhases(const std::vector<BenchmarkResult>& result_group);
+    void printPhaseBreakdown(const std::vector<BenchmarkResult>& results);
+
+    RepetitionPolicy repetition_policy;
+    IsolationPolicy isolation_policy;
+    bool warming_up = false;        // Прогревочные прогоны не попадают в статистику
+
+    // Пакетный замер однопоточных тестов: одна пара отметок Timer на
+    // timing_batch_size операций (1 - время каждой операции замеряет дерево)
+    int timing_batch_size = 1;
+
+    // Замер структуры каждые telemetry_interval операций вставки и удаления (0 - выключен)
+    long long telemetry_interval = 0;
+
+    // Сбор raw_latency_ns во вставке, поиске и удалении (кроме прогрева)
+    bool capture_raw_latency = false;
+
+    // Режимы кэша фаз поиска и удаления в runFullTest
+    std::vector<CacheMode> cache_modes = { CacheMode::WARM };
+
+    std::function<void(const std::vector<BenchmarkResult>&)> cell_observer;
+
+    // Буфер вытеснения режима COLD: вдвое больше наибольшего уровня кэша.
+    // Проход делается вне замеров операций
+    std::vector<char> eviction_buffer;
+    void evictCaches();
+    static constexpr size_t COLD_MAX_SAMPLES = 64;    // Замеров (операций) на фазу
+
+    // Режим TLB_COLD: после каждого узла выделяется промежуток до страницы,
+    // всего не больше TLB_SPREAD_BUDGET (на больших деревьях промежутки меньше)
+    static constexpr size_t TLB_PAGE_SIZE = 4096;
+    static constexpr size_t TLB_SPREAD_BUDGET = 256 * 1024 * 1024;
+
+    // Заполняет счетчики работы результата по разности статистики дерева
+    void fillStructureWork(BenchmarkResult& result, TreeBase* tree, const TreeStatistics& before);
+
+    // Куда timeOperations пишет сырые замеры фазы (nullptr - не пишет).
+    // Память под замеры count операций резервируется здесь, до начала фазы
+    std::vector<long long>* reserveRawLatency(BenchmarkResult& result, size_t count);
+
+    // Модель кэша, подключаемая к деревьям в режиме трассировки
+    std::unique_ptr<CacheSimulator> cache_simulator;
+    void attachCacheSimulator(TreeBase* tree);
+    void startCacheSimulation();
+    CacheSimulationCounters finishCacheSimulation();
+
+    // Замер динамики структуры посреди фазы. Счетчики процессора и модель
+    // кэша на время обхода приостанавливаются. В замеры операций он не входит
+    void sampleTelemetry(TelemetrySampler& telemetry, long long op_index, TreeBase* tree,
+        long long latency_ns);
+
+    // Разбивает [0, count) на равные части и обрабатывает каждую в своем потоке.
+    // Каждый поток пишет время операций в свою гистограмму, затем они сводятся в latency
+    void runParallel(int threads, size_t count, LatencyHistogram& latency,
+        const std::function<void(size_t, size_t, LatencyHistogram&)>& body);
+
+public:
+    Benchmark();
+
+    std::unique_ptr<TreeBase> createTree(TreeType type);
+
+    // 2-3 дерево при вставке теряет и дублирует ключи (из 3 ключей получается 4),
+    // поэтому размерные, длительные и нагрузочные прогоны его пропускают
+    static bool keepsKeySet(TreeType type) { return type != TreeType::TWO_THREE; }
+
+    // Тестирование отдельных операций. snapshot - дерево, уже заполненное
+    // data_to_insert: фаза работает с его копией вместо повторной вставки
+    BenchmarkResult testInsertion(TreeType type, const std::vector<int>& data);
+    // Вставка как при прогреве: в статистику и сырые замеры не попадает
+    BenchmarkResult probeInsertion(TreeType type, const std::vector<int>& data);
+    BenchmarkResult testSearch(TreeType type, const std::vector<int>& data_to_insert,
+        const std::vector<int>& data_to_search, CacheMode mode = CacheMode::WARM,
+        const TreeBase* snapshot = nullptr);
+    BenchmarkResult testDeletion(TreeType type, const std::vector<int>& data_to_insert,
+        const std::vector<int>& data_to_remove, CacheMode mode = CacheMode::WARM,
+        const TreeBase* snapshot = nullptr);
+
+    // Многопоточное тестирование. Деревья без собственной синхронизации
+    // оборачиваются в LockedTree с одним мьютексом
+    BenchmarkResult testConcurrentInsertion(TreeType type, const std::vector<int>& data,
+        int threads);
+    BenchmarkResult testConcurrentSearch(TreeType type, const std::vector<int>& data_to_insert,
+        const std::vector<int>& data_to_search, int threads);
+
+    // Тестирование шардированного контейнера (каждый шард - отдельное дерево)
+    BenchmarkResult testShardedInsertion(TreeType type, const std::vector<int>& data,
+        int threads, int shards);
+    BenchmarkResult testShardedBulkLoad(TreeType type, const std::vector<int>& data,
+        int shards);
+
+    // Смешанная нагрузка (поиск/вставка/удаление) при заданном способе синхронизации
+    BenchmarkResult testSynchronizedMixed(TreeType type, const std::vector<int>& data,
+        int threads, SyncMode mode, int read_percent = 80);
+
+    // Комплексное тестирование. iterations - максимальное число повторов,
+    // фактическое определяется RepetitionPolicy
+    std::vector<BenchmarkResult> runFullTest(int data_size, DataOrder order,
+        int iterations = 10);
+    std::vector<BenchmarkResult> runFullTest(int data_size, DataOrder order,
+        int iterations, const std::vector<TreeType>& tree_types);
+    // Данные каждого повтора строит make_data (порядок order только записывается в результаты)
+    std::vector<BenchmarkResult> runFullTest(const std::function<std::vector<int>()>& make_data,
+        DataOrder order, int iterations, const std::vector<TreeType>& tree_types);
+
+    // Поиск и удаление выполняются в каждом режиме (вставка от режима не зависит).
+    // Буфер вытеснения COLD выделяется здесь, вне окон памяти фаз
+    void setCacheModes(const std::vector<CacheMode>& modes, long long largest_cache_bytes);
+    const std::vector<CacheMode>& getCacheModes() const { return cache_modes; }
+    static const char* getCacheModeName(CacheMode mode);    // "Warm", "Cold", ...
+
+    void setRepetitionPolicy(const RepetitionPolicy& policy) { repetition_policy = policy; }
+    void setTimingBatchSize(int batch_size) { timing_batch_size = batch_size < 1 ? 1 : batch_size; }
+    int getTimingBatchSize() const { return timing_batch_size; }
+    void setTelemetryInterval(long long interval) { telemetry_interval = interval < 0 ? 0 : interval; }
+    long long getTelemetryInterval() const { return telemetry_interval; }
+    void setRawLatencyCapture(bool enabled) { capture_raw_latency = enabled; }
+    bool getRawLatencyCapture() const { return capture_raw_latency; }
+    const RepetitionPolicy& getRepetitionPolicy() const { return repetition_policy; }
+
+    // Вызывается после каждой завершенной ячейки runFullTest с ее результатами
+    // (номер повтора и порядок данных уже проставлены), в потоке прогона
+    void setCellObserver(const std::function<void(const std::vector<BenchmarkResult>&)>& observer) {
+        cell_observer = observer;
+    }
+
+    // В изолированном режиме каждая ячейка, включая свой прогрев, выполняется
+    // в отдельном процессе (см. CellIsolation). Дерево, ячейка которого
+    // зависла или упала, дальше не повторяется. Без fork ячейки идут в этом процессе
+    void setIsolationPolicy(const IsolationPolicy& policy) { isolation_policy = policy; }
+    const IsolationPolicy& getIsolationPolicy() const { return isolation_policy; }
+
+    // Масштабирование по числу потоков
+    std::vector<BenchmarkResult> runScalingTest(int data_size, DataOrder order,
+        const std::vector<int>& thread_counts, int iterations = 3);
+
+    // Режим трассировки обращений к узлам с моделированием кэша.
+    // Замеры времени в этом режиме включают накладные расходы модели
+    void setCacheSimulation(bool enabled,
+        const CacheSimulatorConfig& config = CacheSimulatorConfig::getDefault());
+    bool isCacheSimulationEnabled() const { return cache_simulator != nullptr; }
+
+    // Имя дерева в файлах результатов ("AVL Tree", ...)
+    std::string getTreeName(TreeType type) const;
+
+    // Состояние аппаратных счетчиков
+    std::string getPerfCountersStatus() const { return perf_counters.getStatus(); }
+
+    // Статистика операций многопоточных тестов
+    const StatisticsCollector& getStatistics() const { return statistics; }
+    void clearStatistics() { statistics.clear(); }
+
+    // Сохранение результатов (false - файл не открыт или не записан)
+    bool saveResultsToCSV(const std::vector<BenchmarkResult>& results,
+        const std::string& filename);
+    // Замеры структуры всех результатов, одна строка на замер
+    bool saveTelemetryToCSV(const std::vector<BenchmarkResult>& results,
+        const std::string& filename);
+
+    // Вывод в консоль
+    void printResults(const std::vector<BenchmarkResult>& results);
+};
+
 #endif // BENCHMARK_H
\ No newline at end of file
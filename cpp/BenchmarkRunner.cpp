@@ -0,0 +1,576 @@
+// src/BenchmarkRunner.cpp
+#include <cstdlib>
+#include <ctime>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <system_error>
+#include <vector>
+
+#include "BenchmarkRunner.h"
+#include "CacheSweep.h"
+#include "ColumnarFile.h"
+#include "LoadGenerator.h"
+#include "MetricsExporter.h"
+#include "RegressionChecker.h"
+#include "SoakTest.h"
+#include "TraceRecorder.h"
+
+namespace {
+
+// Колонки файла сырых замеров. Строковые колонки и параметры ячейки
+// постоянны внутри ячейки, номер замера растет на 1 - после дельта-кодирования
+// на строку приходится по байту, основной объем - сама задержка
+enum RawColumn { RAW_TREE, RAW_OPERATION, RAW_CACHE_MODE, RAW_DATA_ORDER, RAW_DATA_SIZE, RAW_RUN,
+    RAW_TIMING_BATCH, RAW_SAMPLE, RAW_LATENCY_NS };
+
+std::vector<ColumnSpec> rawColumns() {
+    return {
+        { "Tree", ColumnType::STRING, ColumnEncoding::DELTA_VARINT },
+        { "Operation", ColumnType::STRING, ColumnEncoding::DELTA_VARINT },
+        { "CacheMode", ColumnType::STRING, ColumnEncoding::DELTA_VARINT },
+        { "DataOrder", ColumnType::STRING, ColumnEncoding::DELTA_VARINT },
+        { "DataSize", ColumnType::INT64, ColumnEncoding::DELTA_VARINT },
+        { "Run", ColumnType::INT64, ColumnEncoding::DELTA_VARINT },
+        { "TimingBatch", ColumnType::INT64, ColumnEncoding::DELTA_VARINT },
+        { "Sample", ColumnType::INT64, ColumnEncoding::DELTA_VARINT },
+        { "LatencyNs", ColumnType::INT64, ColumnEncoding::DELTA_VARINT }
+    };
+}
+
+// Сырые замеры ячейки; файл сбрасывается на диск после каждой ячейки
+void writeRawLatencies(ColumnarWriter& writer, const std::vector<BenchmarkResult>& cell, const Benchmark& benchmark) {
+    for (const BenchmarkResult& result : cell) {
+        std::string tree = benchmark.getTreeName(result.tree_type);
+        std::string cache_mode = Benchmark::getCacheModeName(result.cache_mode);
+        std::string order = DataGenerator::getOrderName(result.data_order);
+        for (size_t i = 0; i < result.raw_latency_ns.size(); i++) {
+            writer.set(RAW_TREE, tree);
+            writer.set(RAW_OPERATION, result.operation);
+            writer.set(RAW_CACHE_MODE, cache_mode);
+            writer.set(RAW_DATA_ORDER, order);
+            writer.set(RAW_DATA_SIZE, static_cast<long long>(result.data_size));
+            writer.set(RAW_RUN, static_cast<long long>(result.run));
+            writer.set(RAW_TIMING_BATCH, static_cast<long long>(result.timing_batch));
+            writer.set(RAW_SAMPLE, static_cast<long long>(i));
+            writer.set(RAW_LATENCY_NS, result.raw_latency_ns[i]);
+            writer.endRow();
+        }
+    }
+    writer.flush();
+}
+
+// Последняя запись метрик с running = 0. Деструктор делает ее на любом
+// выходе из прогона, в том числе по ошибке или исключению: иначе
+// trees_benchmark_running оставался бы 1 до следующего прогона
+class FinalMetricsGuard {
+private:
+    const std::unique_ptr<MetricsExporter>& metrics;
+    const StatisticsCollector* statistics;
+    bool finished = false;
+
+public:
+    FinalMetricsGuard(const std::unique_ptr<MetricsExporter>& exporter, const StatisticsCollector* collector)
+        : metrics(exporter), statistics(collector) {
+    }
+
+    ~FinalMetricsGuard() {
+        if (finished || !metrics) return;
+        try {
+            metrics->publish(statistics, false);
+        }
+        catch (...) {
+        }
+    }
+
+    FinalMetricsGuard(const FinalMetricsGuard&) = delete;
+    FinalMetricsGuard& operator=(const FinalMetricsGuard&) = delete;
+
+    bool finish() {
+        finished = true;
+        return !metrics || metrics->publish(statistics, false);
+    }
+};
+
+}
+
+BenchmarkRunner::BenchmarkRunner(const BenchmarkConfig& benchmarkConfig)
+    : config(benchmarkConfig) {
+}
+
+int BenchmarkRunner::run() {
+    if (!config.validate()) return EXIT_CONFIG_ERROR;
+
+    const auto& test = config.testConfig;
+    const auto& output = config.outputConfig;
+
+    try {
+        Benchmark benchmark;
+
+        RepetitionPolicy policy;
+        policy.warmup_runs = test.warmup_runs;
+        policy.min_runs = test.min_runs;
+        policy.target_ci_percent = test.target_ci_percent;
+        policy.time_budget_ms = test.time_budget_ms;
+        benchmark.setRepetitionPolicy(policy);
+        benchmark.setTimingBatchSize(test.timing_batch_size);
+        benchmark.setTelemetryInterval(test.telemetry_interval);
+        benchmark.setCacheSimulation(test.cache_simulation);
+        benchmark.setCacheModes(test.cache_modes, CacheSweep::getLargestCacheSize());
+
+        IsolationPolicy isolation;
+        isolation.enabled = test.isolate_cells;
+        isolation.cell_timeout_ms = test.cell_timeout_ms;
+        benchmark.setIsolationPolicy(isolation);
+
+        // Каталог создается до прогона, чтобы ошибка не обнаружилась через час
+        std::filesystem::path directory(output.output_directory);
+        if (output.save_to_file && !directory.empty()) {
+            std::error_code error;
+            std::filesystem::create_directories(directory, error);
+            if (error) {
+                std::cerr << "Не удалось создать каталог " << directory.string() << ": "
+                    << error.message() << std::endl;
+                return EXIT_OUTPUT_ERROR;
+            }
+        }
+
+        // Трасса и метрики включаются до выбора режима: длительная и
+        // разомкнутая нагрузка пишут их так же, как сетка размеров
+        if (output.export_trace) {
+            TraceRecorder::setThreadName("main");
+            TraceRecorder::setEnabled(true);
+        }
+
+        // Метрики для node_exporter обновляются по ходу прогона после ячеек.
+        // Ошибка записи не прерывает прогон, но меняет код завершения
+        std::unique_ptr<MetricsExporter> metrics;
+        FinalMetricsGuard final_metrics(metrics, &benchmark.getStatistics());
+        bool metrics_failed = false;
+        if (!output.metrics_directory.empty()) {
+            std::error_code error;
+            std::filesystem::create_directories(output.metrics_directory, error);
+            if (error) {
+                std::cerr << "Не удалось создать каталог " << output.metrics_directory << ": "
+                    << error.message() << std::endl;
+                return EXIT_OUTPUT_ERROR;
+            }
+
+            metrics = std::make_unique<MetricsExporter>(output.metrics_directory, output.metrics_interval_s * 1000);
+            if (!metrics->publish(&benchmark.getStatistics())) {
+                return EXIT_OUTPUT_ERROR;
+            }
+        }
+
+        // Метка времени файлов выбирается до прогона, чтобы сырые замеры
+        // легли рядом с остальными
+        std::string stamp = std::to_string(std::time(nullptr));
+
+        if (test.soak || test.load_sweep) {
+            int status = test.soak ? runSoak(benchmark, directory, stamp, metrics.get(), metrics_failed)
+                : runLoadSweep(benchmark, directory, stamp, metrics.get(), metrics_failed);
+            if (!final_metrics.finish()) {
+                metrics_failed = true;
+            }
+            if (metrics) {
+                std::cout << "Метрики Prometheus: " << metrics->getPath() << std::endl;
+            }
+            if (metrics_failed && status == EXIT_OK) {
+                std::cerr << "Ошибка записи метрик Prometheus" << std::endl;
+                return EXIT_OUTPUT_ERROR;
+            }
+            return status;
+        }
+
+        // Время каждой операции - в колоночный файл по мере завершения ячеек:
+        // в CSV в конце прогона оно заняло бы гигабайты
+        std::unique_ptr<ColumnarWriter> raw;
+        if (output.save_to_file && output.export_raw_data) {
+            raw = std::make_unique<ColumnarWriter>((directory / ("benchmark_" + stamp + "_raw.col")).string(),
+                rawColumns());
+            if (!raw->isGood()) {
+                return EXIT_OUTPUT_ERROR;
+            }
+            benchmark.setRawLatencyCapture(true);
+        }
+
+        if (metrics || raw) {
+            benchmark.setCellObserver([&](const std::vector<BenchmarkResult>& cell) {
+                if (raw) {
+                    writeRawLatencies(*raw, cell, benchmark);
+                }
+                if (metrics) {
+                    metrics->update(cell, benchmark);
+                    if (!metrics->publishIfDue(&benchmark.getStatistics())) {
+                        metrics_failed = true;
+                    }
+                }
+                });
+        }
+
+        std::vector<TreeType> tree_types = config.getTreeTypes();
+        int steps = (test.max_data_size - test.min_data_size) / test.step_size + 1;
+        int total = steps * static_cast<int>(test.data_orders.size());
+        int done = 0;
+
+        std::vector<BenchmarkResult> results;
+        std::unique_ptr<CacheSweep> sweep;
+        if (test.cache_sweep) {
+            // Размеры подбираются по уровням кэша, сетка min..max не используется
+            sweep = std::make_unique<CacheSweep>(benchmark);
+            sweep->setMaxKeys(test.sweep_max_keys);
+            sweep->printLevels();
+            results = sweep->run(tree_types, test.iterations_per_step);
+        }
+        else {
+            for (DataOrder order : test.data_orders) {
+                for (int size = test.min_data_size; size <= test.max_data_size; size += test.step_size) {
+                    TraceSpan span("Step", "run", DataGenerator::getOrderName(order), size);
+                    std::vector<BenchmarkResult> part =
+                        benchmark.runFullTest(size, order, test.iterations_per_step, tree_types);
+                    results.insert(results.end(), part.begin(), part.end());
+
+                    done++;
+                    if (metrics) {
+                        metrics->setProgress(done, total);
+                    }
+                    if (test.enable_progress_bar) {
+                        std::cout << "[" << done << "/" << total << "] "
+                            << DataGenerator::getOrderName(order) << ", n = " << size
+                            << ", замеров: " << part.size() << std::endl;
+                    }
+                }
+            }
+        }
+
+        if (!final_metrics.finish()) {
+            metrics_failed = true;
+        }
+        if (metrics) {
+            std::cout << "Метрики Prometheus: " << metrics->getPath() << std::endl;
+        }
+
+        if (raw) {
+            if (!raw->close()) {
+                std::cerr << "Ошибка записи сырых замеров" << std::endl;
+                return EXIT_OUTPUT_ERROR;
+            }
+            std::cout << "Сырые замеры (" << raw->getRowCount() << " строк, блоков: " << raw->getChunkCount()
+                << "): " << (directory / ("benchmark_" + stamp + "_raw.col")).string() << std::endl;
+        }
+
+        if (results.empty()) {
+            std::cerr << "Прогон не дал результатов" << std::endl;
+            return EXIT_RUN_ERROR;
+        }
+
+        if (output.show_console_output) {
+            benchmark.printResults(results);
+        }
+
+        if (output.save_to_file) {
+            if (!benchmark.saveResultsToCSV(results, (directory / ("benchmark_" + stamp + ".csv")).string())) {
+                return EXIT_OUTPUT_ERROR;
+            }
+
+            if (test.telemetry_interval > 0 &&
+                !benchmark.saveTelemetryToCSV(results, (directory / ("benchmark_" + stamp + "_telemetry.csv")).string())) {
+                return EXIT_OUTPUT_ERROR;
+            }
+
+            // Границы уровней для графика время/объем
+            if (sweep && !sweep->saveLevelsToCSV((directory / ("benchmark_" + stamp + "_cache.csv")).string())) {
+                return EXIT_OUTPUT_ERROR;
+            }
+
+            // Копия конфигурации рядом с результатами - для воспроизведения прогона
+            BenchmarkConfig used = config;
+            if (!used.saveToFile((directory / ("benchmark_" + stamp + ".cfg")).string())) {
+                return EXIT_OUTPUT_ERROR;
+            }
+
+            if (test.save_detailed_logs) {
+                benchmark.getStatistics().exportToJSON((directory / ("statistics_" + stamp + ".json")).string());
+            }
+
+            // Трасса пишется последней, чтобы в нее попала запись остальных файлов
+            if (!writeTrace(directory, stamp)) {
+                return EXIT_OUTPUT_ERROR;
+            }
+        }
+
+        int status = EXIT_OK;
+        if (!config.regressionConfig.baseline_file.empty()) {
+            std::string report;
+            if (output.save_to_file) {
+                report = (directory / ("regression_" + stamp + ".csv")).string();
+            }
+            status = checkRegression(benchmark, results, report);
+        }
+
+        if (metrics_failed && status == EXIT_OK) {
+            std::cerr << "Ошибка записи метрик Prometheus" << std::endl;
+            return EXIT_OUTPUT_ERROR;
+        }
+        return status;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Ошибка при выполнении прогона: " << e.what() << std::endl;
+        return EXIT_RUN_ERROR;
+    }
+
+    return EXIT_OK;
+}
+
+bool BenchmarkRunner::writeTrace(const std::filesystem::path& directory, const std::string& stamp) const {
+    if (!config.outputConfig.export_trace) return true;
+
+    TraceRecorder::setEnabled(false);
+    std::string trace_file = (directory / ("trace_" + stamp + ".json")).string();
+    if (!TraceRecorder::writeJSON(trace_file)) {
+        return false;
+    }
+    std::cout << "Трасса прогона (" << TraceRecorder::getEventCount() << " событий): "
+        << trace_file << std::endl;
+    return true;
+}
+
+int BenchmarkRunner::runSoak(Benchmark& benchmark, const std::filesystem::path& directory, const std::string& stamp,
+    MetricsExporter* metrics, bool& metrics_failed) const {
+    const auto& test = config.testConfig;
+    const auto& output = config.outputConfig;
+
+    SoakTest soak(benchmark);
+    soak.setKeys(test.soak_keys);
+    soak.setDurationMs(test.soak_duration_s * 1000);
+    soak.setIntervalMs(test.soak_interval_s * 1000);
+    if (metrics) {
+        soak.setSampleObserver([&](const SoakSample& sample) {
+            metrics->update(sample, benchmark);
+            if (!metrics->publishIfDue(&benchmark.getStatistics())) {
+                metrics_failed = true;
+            }
+            });
+    }
+
+    std::vector<SoakSample> samples = soak.run(config.getTreeTypes());
+    if (samples.empty()) {
+        std::cerr << "Прогон не дал результатов" << std::endl;
+        return EXIT_RUN_ERROR;
+    }
+
+    if (output.show_console_output) {
+        soak.printSummary(samples);
+    }
+
+    if (output.save_to_file) {
+        if (!soak.saveToCSV(samples, (directory / ("soak_" + stamp + ".csv")).string())) {
+            return EXIT_OUTPUT_ERROR;
+        }
+
+        BenchmarkConfig used = config;
+        if (!used.saveToFile((directory / ("soak_" + stamp + ".cfg")).string())) {
+            return EXIT_OUTPUT_ERROR;
+        }
+
+        if (!writeTrace(directory, stamp)) {
+            return EXIT_OUTPUT_ERROR;
+        }
+    }
+    return EXIT_OK;
+}
+
+int BenchmarkRunner::runLoadSweep(Benchmark& benchmark, const std::filesystem::path& directory,
+    const std::string& stamp, MetricsExporter* metrics, bool& metrics_failed) const {
+    const auto& test = config.testConfig;
+    const auto& output = config.outputConfig;
+
+    LoadGenerator generator(benchmark);
+    generator.setKeys(test.load_keys);
+    generator.setPointMs(test.load_point_ms);
+    generator.setWritePercent(test.load_write_percent);
+    generator.setArrivalProcess(test.load_arrivals);
+    generator.setLoadFractions(test.load_fractions);
+    if (metrics) {
+        generator.setPointObserver([&](const LoadPoint& point) {
+            metrics->update(point, benchmark);
+            if (!metrics->publishIfDue(&benchmark.getStatistics())) {
+                metrics_failed = true;
+            }
+            });
+    }
+
+    std::vector<LoadPoint> points = generator.run(config.getTreeTypes());
+    if (points.empty()) {
+        std::cerr << "Прогон не дал результатов" << std::endl;
+        return EXIT_RUN_ERROR;
+    }
+
+    if (output.show_console_output) {
+        generator.printTable(points);
+    }
+
+    if (output.save_to_file) {
+        if (!generator.saveToCSV(points, (directory / ("load_" + stamp + ".csv")).string())) {
+            return EXIT_OUTPUT_ERROR;
+        }
+
+        BenchmarkConfig used = config;
+        if (!used.saveToFile((directory / ("load_" + stamp + ".cfg")).string())) {
+            return EXIT_OUTPUT_ERROR;
+        }
+
+        if (!writeTrace(directory, stamp)) {
+            return EXIT_OUTPUT_ERROR;
+        }
+    }
+    return EXIT_OK;
+}
+
+int BenchmarkRunner::checkRegression(const Benchmark& benchmark, const std::vector<BenchmarkResult>& results,
+    const std::string& reportFile) const {
+    const auto& regression = config.regressionConfig;
+
+    RegressionChecker checker(regression.threshold_percent, regression.alpha);
+    if (!checker.loadBaseline(regression.baseline_file)) return EXIT_CONFIG_ERROR;
+
+    for (const auto& result : results) {
+        CellKey key;
+        key.tree = benchmark.getTreeName(result.tree_type);
+        key.operation = result.operation;
+        key.dataSize = result.data_size;
+        key.order = DataGenerator::getOrderName(result.data_order);
+        key.threads = result.threads;
+        key.cacheMode = Benchmark::getCacheModeName(result.cache_mode);
+        checker.addCurrent(key, result.nsPerOperation());
+    }
+
+    std::vector<CellComparison> comparisons = checker.compare();
+    checker.printTable(comparisons);
+
+    if (!reportFile.empty() && !RegressionChecker::saveToCSV(comparisons, reportFile)) {
+        return EXIT_OUTPUT_ERROR;
+    }
+    return RegressionChecker::hasRegression(comparisons) ? EXIT_REGRESSION : EXIT_OK;
+}
+
+int BenchmarkRunner::compareFiles(const std::string& baselineFile, const std::string& currentFile,
+    double thresholdPercent, double alpha) {
+    RegressionChecker checker(thresholdPercent, alpha);
+    if (!checker.loadBaseline(baselineFile) || !checker.loadCurrent(currentFile)) {
+        return EXIT_CONFIG_ERROR;
+    }
+
+    std::vector<CellComparison> comparisons = checker.compare();
+    checker.printTable(comparisons);
+    return RegressionChecker::hasRegression(comparisons) ? EXIT_REGRESSION : EXIT_OK;
+}
+
+int BenchmarkRunner::convertFile(const std::string& inputFile, const std::string& outputFile,
+    const std::string& separator) {
+    if (!ColumnarReader::convertToCSV(inputFile, outputFile, separator)) {
+        return EXIT_OUTPUT_ERROR;
+    }
+    std::cout << "Записан " << outputFile << std::endl;
+    return EXIT_OK;
+}
+
+int BenchmarkRunner::runFromCommandLine(int argc, char* argv[]) {
+    if (argc < 2) return -1;
+
+    std::string configFile;
+    std::string writeConfigFile;
+    std::string baselineFile;
+    std::string compareBaseline;
+    std::string compareCurrent;
+    std::string convertInput;
+    std::string convertOutput;
+    double threshold = -1.0;
+    double alpha = -1.0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        int needed = (option == "--compare" || option == "--convert") ? 2 :
+            (option == "--config" || option == "--write-config" || option == "--baseline" ||
+             option == "--threshold" || option == "--alpha") ? 1 : 0;
+
+        if (option == "--help" || option == "-h") {
+            printUsage(argv[0]);
+            return EXIT_OK;
+        }
+        if (needed == 0) {
+            std::cerr << "Неизвестный параметр: " << option << std::endl;
+            printUsage(argv[0]);
+            return EXIT_CONFIG_ERROR;
+        }
+        if (i + needed >= argc) {
+            std::cerr << "Не указано значение для " << option << std::endl;
+            printUsage(argv[0]);
+            return EXIT_CONFIG_ERROR;
+        }
+
+        if (option == "--config") configFile = argv[i + 1];
+        else if (option == "--write-config") writeConfigFile = argv[i + 1];
+        else if (option == "--baseline") baselineFile = argv[i + 1];
+        else if (option == "--threshold") threshold = std::atof(argv[i + 1]);
+        else if (option == "--alpha") alpha = std::atof(argv[i + 1]);
+        else if (option == "--convert") {
+            convertInput = argv[i + 1];
+            convertOutput = argv[i + 2];
+        }
+        else {
+            compareBaseline = argv[i + 1];
+            compareCurrent = argv[i + 2];
+        }
+        i += needed;
+    }
+
+    if (!writeConfigFile.empty()) {
+        BenchmarkConfig defaults = BenchmarkConfig::getDefaultConfig();
+        return defaults.saveToFile(writeConfigFile) ? EXIT_OK : EXIT_OUTPUT_ERROR;
+    }
+
+    BenchmarkConfig loaded = BenchmarkConfig::getDefaultConfig();
+    if (!configFile.empty() && !loaded.loadFromFile(configFile)) return EXIT_CONFIG_ERROR;
+
+    // Параметры командной строки важнее значений из файла
+    if (!baselineFile.empty()) loaded.regressionConfig.baseline_file = baselineFile;
+    if (threshold >= 0) loaded.regressionConfig.threshold_percent = threshold;
+    if (alpha >= 0) loaded.regressionConfig.alpha = alpha;
+
+    // Разделитель CSV - из конфигурации, если она указана
+    if (!convertInput.empty()) {
+        return convertFile(convertInput, convertOutput, loaded.outputConfig.csv_separator);
+    }
+
+    if (!compareBaseline.empty()) {
+        if (!loaded.validate()) return EXIT_CONFIG_ERROR;
+        return compareFiles(compareBaseline, compareCurrent,
+            loaded.regressionConfig.threshold_percent, loaded.regressionConfig.alpha);
+    }
+
+    if (configFile.empty()) {
+        std::cerr << "Не указан файл конфигурации (--config)" << std::endl;
+        printUsage(argv[0]);
+        return EXIT_CONFIG_ERROR;
+    }
+    return BenchmarkRunner(loaded).run();
+}
+
+void BenchmarkRunner::printUsage(const char* program) {
+    std::cout << "Использование:\n"
+        << "  " << program << "                        интерактивный режим\n"
+        << "  " << program << " --config <файл>        прогон по конфигурации без диалога\n"
+        << "  " << program << " --write-config <файл>  записать конфигурацию по умолчанию\n"
+        << "  " << program << " --compare <база.csv> <текущий.csv>\n"
+        << "                              сравнить два сохраненных прогона\n"
+        << "  " << program << " --convert <файл.col> <файл.csv>\n"
+        << "                              перевести сырые замеры (export_raw_data) в CSV\n"
+        << "Параметры сравнения (дополняют --config и --compare):\n"
+        << "  --baseline <файл.csv>   базовый прогон\n"
+        << "  --threshold <процент>   допустимое замедление медианы (по умолчанию 5)\n"
+        << "  --alpha <уровень>       уровень значимости t-теста (по умолчанию 0.05)\n"
+        << "Коды завершения: 0 - успех, 1 - ошибка конфигурации, "
+        << "2 - ошибка записи результатов, 3 - ошибка прогона, 4 - регрессия\n";
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+// include/BenchmarkRunner.h
+#ifndef BENCHMARKRUNNER_H
+#define BENCHMARKRUNNER_H
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Config.h"
+#include "MetricsExporter.h"
+
+// Неинтерактивный прогон по конфигурации (режим --config):
+// все порядки данных x размеры от min до max с шагом step
+// (или проход по уровням кэша, длительная или разомкнутая нагрузка).
+// Если задан baseline_file, результаты сравниваются с базовым прогоном
+class BenchmarkRunner {
+public:
+    // Коды завершения процесса
+    enum ExitCode {
+        EXIT_OK = 0,
+        EXIT_CONFIG_ERROR = 1,      // Файл не прочитан или значения неверны
+        EXIT_OUTPUT_ERROR = 2,      // Не удалось записать результаты
+        EXIT_RUN_ERROR = 3,         // Исключение или пустые результаты
+        EXIT_REGRESSION = 4         // Есть регрессия относительно базового прогона
+    };
+
+private:
+    BenchmarkConfig config;
+
+    // metrics (может быть nullptr) обновляется после каждого интервала или
+    // точки; ошибка записи не прерывает нагрузку, а выставляет metrics_failed
+    int runSoak(Benchmark& benchmark, const std::filesystem::path& directory, const std::string& stamp,
+        MetricsExporter* metrics, bool& metrics_failed) const;
+    int runLoadSweep(Benchmark& benchmark, const std::filesystem::path& directory, const std::string& stamp,
+        MetricsExporter* metrics, bool& metrics_failed) const;
+    // Трасса прогона (если включена) в directory/trace_<stamp>.json
+    bool writeTrace(const std::filesystem::path& directory, const std::string& stamp) const;
+    int checkRegression(const Benchmark& benchmark, const std::vector<BenchmarkResult>& results,
+        const std::string& reportFile) const;
+
+public:
+    explicit BenchmarkRunner(const BenchmarkConfig& benchmarkConfig);
+
+    int run();
+
+    // Разбор командной строки. Возвращает -1, если нужен интерактивный режим
+    static int runFromCommandLine(int argc, char* argv[]);
+    // Сравнение двух сохраненных CSV без прогона (режим --compare)
+    static int compareFiles(const std::string& baselineFile, const std::string& currentFile,
+        double thresholdPercent, double alpha);
+    // Перевод файла сырых замеров в CSV (режим --convert)
+    static int convertFile(const std::string& inputFile, const std::string& outputFile,
+        const std::string& separator);
+    static void printUsage(const char* program);
+};
+
+#endif // BENCHMARKRUNNER_H
\ No newline at end of file
@@ -0,0 +1,122 @@
+// src/CacheSimulator.cpp
+#include <algorithm>
+
+#include "CacheSimulator.h"
+
+// =============== КОНФИГУРАЦИЯ ===============
+
+CacheSimulatorConfig CacheSimulatorConfig::getDefault() {
+    CacheSimulatorConfig config;
+    config.l1 = { 32 * 1024, 8, 64 };
+    config.l2 = { 1024 * 1024, 16, 64 };
+    config.l3 = { 16 * 1024 * 1024, 16, 64 };
+    config.tlb = { 64 * 4096, 4, 4096 };
+    return config;
+}
+
+double CacheSimulationCounters::perOperation(Level level, long long operations) const {
+    if (!valid || operations <= 0) return -1.0;
+    return static_cast<double>(misses[level]) / operations;
+}
+
+const char* CacheSimulationCounters::getLevelName(Level level) {
+    switch (level) {
+    case L1: return "L1";
+    case L2: return "L2";
+    case L3: return "L3";
+    case TLB: return "TLB";
+    default: return "Unknown";
+    }
+}
+
+// =============== УРОВЕНЬ КЭША ===============
+
+namespace {
+const std::uint64_t INVALID_TAG = ~0ULL;
+}
+
+CacheSimulator::CacheLevel::CacheLevel(const CacheConfig& config) : clock(0) {
+    int lineSize = std::max(1, config.lineSize);
+    lineBits = 0;
+    while ((1 << (lineBits + 1)) <= lineSize) lineBits++;
+
+    associativity = std::max(1, config.associativity);
+    setCount = std::max<size_t>(1, config.size / (static_cast<size_t>(associativity) << lineBits));
+
+    tags.assign(setCount * associativity, INVALID_TAG);
+    lastUsed.assign(setCount * associativity, 0);
+}
+
+bool CacheSimulator::CacheLevel::access(std::uint64_t address) {
+    std::uint64_t line = address >> lineBits;
+    size_t base = static_cast<size_t>(line % setCount) * associativity;
+    clock++;
+
+    size_t victim = base;
+    for (size_t way = base; way < base + associativity; way++) {
+        if (tags[way] == line) {
+            lastUsed[way] = clock;
+            return true;
+        }
+        // Пустые записи имеют lastUsed = 0 и вытесняются первыми
+        if (lastUsed[way] < lastUsed[victim]) {
+            victim = way;
+        }
+    }
+
+    tags[victim] = line;
+    lastUsed[victim] = clock;
+    return false;
+}
+
+void CacheSimulator::CacheLevel::flush() {
+    std::fill(tags.begin(), tags.end(), INVALID_TAG);
+    std::fill(lastUsed.begin(), lastUsed.end(), 0);
+    clock = 0;
+}
+
+// =============== СИМУЛЯТОР ===============
+
+CacheSimulator::CacheSimulator(const CacheSimulatorConfig& simulatorConfig)
+    : config(simulatorConfig), tlb(simulatorConfig.tlb) {
+    levels.emplace_back(config.l1);
+    levels.emplace_back(config.l2);
+    levels.emplace_back(config.l3);
+    counters.valid = true;
+}
+
+void CacheSimulator::onAccess(const void* address, size_t size) {
+    if (size == 0) size = 1;
+
+    std::uint64_t first = reinterpret_cast<std::uintptr_t>(address);
+    std::uint64_t last = first + size - 1;
+
+    // Каждая затронутая строка проходит иерархию сверху вниз
+    int lineBits = levels[0].getLineBits();
+    for (std::uint64_t line = first >> lineBits; line <= last >> lineBits; line++) {
+        counters.accesses++;
+        for (size_t level = 0; level < levels.size(); level++) {
+            if (levels[level].access(line << lineBits)) break;
+            counters.misses[level]++;
+        }
+    }
+
+    int pageBits = tlb.getLineBits();
+    for (std::uint64_t page = first >> pageBits; page <= last >> pageBits; page++) {
+        if (!tlb.access(page << pageBits)) {
+            counters.misses[CacheSimulationCounters::TLB]++;
+        }
+    }
+}
+
+void CacheSimulator::resetCounters() {
+    counters = CacheSimulationCounters();
+    counters.valid = true;
+}
+
+void CacheSimulator::flush() {
+    for (auto& level : levels) {
+        level.flush();
+    }
+    tlb.flush();
+}
\ No newline at end of file
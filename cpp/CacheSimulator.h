@@ -0,0 +1,92 @@
+#pragma once
+// include/CacheSimulator.h
+#ifndef CACHESIMULATOR_H
+#define CACHESIMULATOR_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "AccessTracer.h"
+
+// Параметры одного уровня: для TLB lineSize - размер страницы,
+// а size - число записей, умноженное на размер страницы
+struct CacheConfig {
+    size_t size = 0;
+    int associativity = 1;
+    int lineSize = 64;
+};
+
+struct CacheSimulatorConfig {
+    CacheConfig l1;
+    CacheConfig l2;
+    CacheConfig l3;
+    CacheConfig tlb;
+
+    // Типичный настольный x86: 32 КБ / 1 МБ / 16 МБ, 64 записи dTLB
+    static CacheSimulatorConfig getDefault();
+};
+
+// Результат моделирования за один замер
+struct CacheSimulationCounters {
+    enum Level {
+        L1 = 0,
+        L2,
+        L3,
+        TLB,
+        LEVEL_COUNT
+    };
+
+    bool valid = false;
+    long long accesses = 0;                 // Обращения к строкам кэша
+    long long misses[LEVEL_COUNT] = {};
+
+    double perOperation(Level level, long long operations) const;
+    static const char* getLevelName(Level level);
+};
+
+// Модель иерархии кэшей: множественно-ассоциативные уровни с вытеснением LRU.
+// Промах на уровне передает обращение следующему уровню, строка загружается
+// во все уровни, где ее не было. TLB моделируется отдельно, по страницам
+class CacheSimulator : public AccessTracer {
+private:
+    class CacheLevel {
+    private:
+        size_t setCount;
+        int associativity;
+        int lineBits;
+        std::vector<std::uint64_t> tags;        // setCount * associativity
+        std::vector<std::uint64_t> lastUsed;    // Время последнего обращения (для LRU)
+        std::uint64_t clock;
+
+    public:
+        explicit CacheLevel(const CacheConfig& config);
+
+        // true - попадание; при промахе строка загружается
+        bool access(std::uint64_t address);
+        void flush();
+        int getLineBits() const { return lineBits; }
+    };
+
+    CacheSimulatorConfig config;
+    std::vector<CacheLevel> levels;     // L1, L2, L3
+    CacheLevel tlb;
+    CacheSimulationCounters counters;
+
+public:
+    explicit CacheSimulator(const CacheSimulatorConfig& simulatorConfig = CacheSimulatorConfig::getDefault());
+
+    // Реализация AccessTracer
+    void onAccess(const void* address, size_t size) override;
+
+    // Сброс счетчиков (содержимое кэшей сохраняется)
+    void resetCounters();
+
+    // Очистка содержимого всех уровней
+    void flush();
+
+    CacheSimulationCounters getCounters() const { return counters; }
+    const CacheSimulatorConfig& getConfig() const { return config; }
+};
+
+#endif // CACHESIMULATOR_H
\ No newline at end of file
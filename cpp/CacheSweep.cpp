@@ -0,0 +1,284 @@
+// src/CacheSweep.cpp
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "CacheSimulator.h"
+#include "CacheSweep.h"
+#include "DataGenerator.h"
+#include "Visualizer.h"
+
+std::string CacheLevelInfo::getName() const {
+    std::string name = "L" + std::to_string(level);
+    if (type == "Data") name += "d";
+    return name;
+}
+
+CacheSweep::CacheSweep(Benchmark& sweepBenchmark)
+    : benchmark(sweepBenchmark), levels(detectCacheLevels()) {
+    // Дерево, данные повтора и копия для поиска должны поместиться в память
+    memory_limit_bytes = getPhysicalMemory() / 4;
+}
+
+// =============== УРОВНИ КЭША ===============
+
+namespace {
+
+#ifndef _WIN32
+std::string readFirstLine(const std::string& filename) {
+    std::ifstream file(filename);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+// "48K", "2048K", "32M"
+long long parseCacheSize(const std::string& value) {
+    long long size = std::atoll(value.c_str());
+    if (value.find('K') != std::string::npos) size *= 1024;
+    else if (value.find('M') != std::string::npos) size *= 1024 * 1024;
+    return size;
+}
+#endif
+
+}
+
+std::vector<CacheLevelInfo> CacheSweep::detectCacheLevels() {
+    std::vector<CacheLevelInfo> detected;
+
+#ifdef _WIN32
+    DWORD length = 0;
+    GetLogicalProcessorInformation(nullptr, &length);
+    std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> buffer(
+        length / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+    if (!buffer.empty() && GetLogicalProcessorInformation(buffer.data(), &length)) {
+        for (const auto& info : buffer) {
+            if (info.Relationship != RelationCache) continue;
+            const CACHE_DESCRIPTOR& cache = info.Cache;
+            if (cache.Type != CacheData && cache.Type != CacheUnified) continue;
+
+            // Записи повторяются для каждого ядра
+            bool seen = false;
+            for (const auto& level : detected) {
+                if (level.level == cache.Level) seen = true;
+            }
+            if (seen) continue;
+
+            CacheLevelInfo level;
+            level.level = cache.Level;
+            level.type = cache.Type == CacheData ? "Data" : "Unified";
+            level.size = cache.Size;
+            level.lineSize = cache.LineSize;
+            level.associativity = cache.Associativity;
+            detected.push_back(level);
+        }
+    }
+#else
+    const std::string base = "/sys/devices/system/cpu/cpu0/cache/index";
+    for (int index = 0; index < 16; index++) {
+        std::string directory = base + std::to_string(index) + "/";
+        std::string level = readFirstLine(directory + "level");
+        if (level.empty()) break;
+
+        CacheLevelInfo info;
+        info.type = readFirstLine(directory + "type");
+        if (info.type == "Instruction") continue;
+
+        info.level = std::atoi(level.c_str());
+        info.size = parseCacheSize(readFirstLine(directory + "size"));
+        info.lineSize = std::atoi(readFirstLine(directory + "coherency_line_size").c_str());
+        info.associativity = std::atoi(readFirstLine(directory + "ways_of_associativity").c_str());
+        if (info.size > 0) detected.push_back(info);
+    }
+#endif
+
+    if (detected.empty()) {
+        CacheSimulatorConfig defaults = CacheSimulatorConfig::getDefault();
+        const CacheConfig* configs[] = { &defaults.l1, &defaults.l2, &defaults.l3 };
+        for (int i = 0; i < 3; i++) {
+            CacheLevelInfo info;
+            info.level = i + 1;
+            info.type = i == 0 ? "Data" : "Unified";
+            info.size = static_cast<long long>(configs[i]->size);
+            info.lineSize = configs[i]->lineSize;
+            info.associativity = configs[i]->associativity;
+            detected.push_back(info);
+        }
+    }
+
+    std::sort(detected.begin(), detected.end(), [](const CacheLevelInfo& a, const CacheLevelInfo& b) {
+        return a.level < b.level;
+        });
+    return detected;
+}
+
+long long CacheSweep::getLargestCacheSize() {
+    long long largest = 0;
+    for (const auto& level : detectCacheLevels()) {
+        largest = std::max(largest, level.size);
+    }
+    return largest;
+}
+
+long long CacheSweep::getPhysicalMemory() {
+#ifdef _WIN32
+    MEMORYSTATUSEX status;
+    status.dwLength = sizeof(status);
+    if (GlobalMemoryStatusEx(&status)) {
+        return static_cast<long long>(status.ullTotalPhys);
+    }
+    return 0;
+#else
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long pageSize = sysconf(_SC_PAGE_SIZE);
+    return pages > 0 && pageSize > 0 ? static_cast<long long>(pages) * pageSize : 0;
+#endif
+}
+
+std::string CacheSweep::getFootprintLevel(long long footprint_bytes) const {
+    for (const auto& level : levels) {
+        if (footprint_bytes <= level.size) return level.getName();
+    }
+    return "DRAM";
+}
+
+// =============== ВЫБОР РАЗМЕРОВ ===============
+
+double CacheSweep::calibrateBytesPerKey(TreeType type) {
+    DataGenerator generator(42);
+    std::vector<int> keys = generator.generateUnique(CALIBRATION_KEYS);
+
+    // Фактический объем кучи точнее оценки getMemoryUsage()
+    BenchmarkResult probe = benchmark.probeInsertion(type, keys);
+    long long bytes = probe.heap_bytes > 0 ? probe.heap_bytes : probe.memory_bytes;
+    return static_cast<double>(bytes) / CALIBRATION_KEYS;
+}
+
+std::vector<int> CacheSweep::chooseSizes(double bytes_per_key) const {
+    std::vector<double> footprints;
+    for (const auto& level : levels) {
+        footprints.push_back(level.size * 0.5);
+        footprints.push_back(static_cast<double>(level.size));
+        footprints.push_back(level.size * 2.0);
+    }
+
+    double max_footprint = bytes_per_key * max_keys;
+    if (memory_limit_bytes > 0) max_footprint = std::min(max_footprint, static_cast<double>(memory_limit_bytes));
+
+    double last = levels.empty() ? 1024.0 * 1024.0 : static_cast<double>(levels.back().size);
+    for (double footprint = last * 8.0; footprint < max_footprint; footprint *= 4.0) {
+        footprints.push_back(footprint);
+    }
+    footprints.push_back(max_footprint);
+
+    std::vector<int> sizes;
+    for (double footprint : footprints) {
+        if (footprint > max_footprint) continue;
+        double keys = footprint / std::max(1.0, bytes_per_key);
+        // Меньше ~1000 ключей время операции определяет накладной расход замера
+        if (keys < 1000.0) continue;
+        sizes.push_back(static_cast<int>(std::min(keys, static_cast<double>(max_keys))));
+    }
+
+    std::sort(sizes.begin(), sizes.end());
+    sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+    return sizes;
+}
+
+// =============== ПРОГОН ===============
+
+std::vector<BenchmarkResult> CacheSweep::run(const std::vector<TreeType>& tree_types, int iterations) {
+    std::vector<BenchmarkResult> results;
+    RepetitionPolicy policy = benchmark.getRepetitionPolicy();
+
+    long long last_level = levels.empty() ? 0 : levels.back().size;
+
+    for (TreeType type : tree_types) {
+        if (!Benchmark::keepsKeySet(type)) {
+            std::cout << benchmark.getTreeName(type) << ": пропущено, дерево не сохраняет набор ключей" << std::endl;
+            continue;
+        }
+
+        double bytes_per_key = calibrateBytesPerKey(type);
+        std::vector<int> sizes = chooseSizes(bytes_per_key);
+
+        std::cout << benchmark.getTreeName(type) << ": " << bytes_per_key << " байт/ключ, размеров: "
+            << sizes.size() << std::endl;
+
+        for (int size : sizes) {
+            // Прогрев имеет смысл, пока дерево помещается в кэш: дальше
+            // он только удваивает время самых долгих точек
+            RepetitionPolicy point_policy = policy;
+            if (bytes_per_key * size > last_level) point_policy.warmup_runs = 0;
+            benchmark.setRepetitionPolicy(point_policy);
+
+            DataGenerator generator;
+            std::vector<BenchmarkResult> part = benchmark.runFullTest(
+                [&]() { return generator.generateUnique(size); },
+                DataOrder::RANDOM, iterations, { type });
+
+            // Ось X - объем дерева со всеми ключами: по замеру кучи после вставки,
+            // иначе по оценке дерева
+            long long footprint = 0;
+            bool lost_keys = false;
+            for (const auto& result : part) {
+                if (result.operation != "Insertion") continue;
+                // У остальных деревьев узел хранит ровно один ключ
+                if (result.final_nodes != size) lost_keys = true;
+                long long measured = result.heap_bytes > 0 ? result.heap_bytes : result.memory_bytes;
+                footprint = std::max(footprint, measured);
+            }
+            if (lost_keys) {
+                std::cerr << "  n = " << size << ": число узлов после вставки не совпадает с числом ключей, точка отброшена"
+                    << std::endl;
+                continue;
+            }
+            for (auto& result : part) {
+                result.footprint_bytes = footprint;
+            }
+
+            std::cout << "  n = " << size << ", " << Visualizer::formatMemory(static_cast<size_t>(footprint))
+                << " (" << getFootprintLevel(footprint) << "), замеров: " << part.size() << std::endl;
+            results.insert(results.end(), part.begin(), part.end());
+        }
+    }
+
+    benchmark.setRepetitionPolicy(policy);
+    return results;
+}
+
+// =============== ВЫВОД ===============
+
+void CacheSweep::printLevels() const {
+    std::cout << "Уровни кэша:";
+    for (const auto& level : levels) {
+        std::cout << " " << level.getName() << " " << Visualizer::formatMemory(static_cast<size_t>(level.size));
+    }
+    std::cout << "\nПредел объема дерева: "
+        << (memory_limit_bytes > 0 ? Visualizer::formatMemory(static_cast<size_t>(memory_limit_bytes)) : "нет")
+        << ", ключей не больше " << max_keys << std::endl;
+}
+
+bool CacheSweep::saveLevelsToCSV(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Не удалось открыть файл: " << filename << std::endl;
+        return false;
+    }
+
+    file << "Level;Name;Type;SizeBytes;LineSize;Associativity\n";
+    for (const auto& level : levels) {
+        file << level.level << ";" << level.getName() << ";" << level.type << ";"
+            << level.size << ";" << level.lineSize << ";" << level.associativity << "\n";
+    }
+
+    file.close();
+    return !file.fail();
+}
\ No newline at end of file
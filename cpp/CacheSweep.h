@@ -0,0 +1,61 @@
+#pragma once
+// include/CacheSweep.h
+#ifndef CACHESWEEP_H
+#define CACHESWEEP_H
+
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+
+// Уровень кэша данных процессора
+struct CacheLevelInfo {
+    int level = 0;
+    std::string type;           // Data / Unified
+    long long size = 0;         // Байт
+    int lineSize = 64;
+    int associativity = 0;
+
+    std::string getName() const;    // "L1d", "L2", "L3"
+};
+
+// Проход по размерам, при которых объем дерева переходит через каждый
+// уровень кэша и уходит в DRAM. Размеры подбираются для каждого дерева
+// отдельно по его байтам на ключ; ключи уникальные и в случайном порядке
+class CacheSweep {
+private:
+    Benchmark& benchmark;
+    std::vector<CacheLevelInfo> levels;
+
+    long long max_keys = 100000000;
+    long long memory_limit_bytes = 0;   // Предел объема дерева (0 - без предела)
+
+    // Байт на ключ по пробному дереву из CALIBRATION_KEYS ключей
+    static constexpr int CALIBRATION_KEYS = 1 << 16;
+    double calibrateBytesPerKey(TreeType type);
+
+public:
+    explicit CacheSweep(Benchmark& benchmark);
+
+    // Уровни из /sys/devices/system/cpu/cpu0/cache (Linux) или
+    // GetLogicalProcessorInformation (Windows); без них - CacheSimulatorConfig::getDefault()
+    static std::vector<CacheLevelInfo> detectCacheLevels();
+    static long long getLargestCacheSize();     // Объем наибольшего уровня, байт
+    static long long getPhysicalMemory();
+
+    const std::vector<CacheLevelInfo>& getLevels() const { return levels; }
+    void setMaxKeys(long long keys) { max_keys = keys < 1 ? 1 : keys; }
+
+    // Объемы по 0.5x, 1x и 2x каждого уровня, затем x4 за последним до max_keys
+    std::vector<int> chooseSizes(double bytes_per_key) const;
+
+    // Наименьший уровень, в который помещается объем ("DRAM" - ни один)
+    std::string getFootprintLevel(long long footprint_bytes) const;
+
+    std::vector<BenchmarkResult> run(const std::vector<TreeType>& tree_types, int iterations);
+
+    void printLevels() const;
+    bool saveLevelsToCSV(const std::string& filename) const;
+};
+
+#endif // CACHESWEEP_H
\ No newline at end of file
@@ -0,0 +1,513 @@
+// src/CellIsolation.cpp
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <thread>
+
+#ifndef _WIN32
+#include <csignal>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "CellIsolation.h"
+
+bool CellIsolation::isSupported() {
+#ifdef _WIN32
+    return false;
+#else
+    return true;
+#endif
+}
+
+const char* CellIsolation::getStatusName(Status status) {
+    switch (status) {
+    case COMPLETED: return "Completed";
+    case TIMED_OUT: return "TimedOut";
+    case FAILED: return "Failed";
+    case UNSUPPORTED: return "Unsupported";
+    default: return "Unknown";
+    }
+}
+
+// =============== СЕРИАЛИЗАЦИЯ ===============
+
+namespace {
+
+// Родитель и потомок - один и тот же исполняемый файл, поэтому поля
+// пишутся в машинном представлении без преобразований
+class ByteWriter {
+private:
+    std::string& out;
+
+public:
+    explicit ByteWriter(std::string& buffer) : out(buffer) {}
+
+    template <typename T>
+    void put(const T& value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void putString(const std::string& value) {
+        put(value.size());
+        out.append(value);
+    }
+
+    void putValues(const std::vector<long long>& values) {
+        put(values.size());
+        out.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(long long));
+    }
+
+    template <typename T>
+    void putRecords(const std::vector<T>& records) {
+        put(records.size());
+        out.append(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(T));
+    }
+};
+
+class ByteReader {
+private:
+    const char* position;
+    const char* end;
+    bool valid = true;
+
+public:
+    ByteReader(const char* data, size_t size) : position(data), end(data + size) {}
+
+    bool isValid() const { return valid; }
+
+    template <typename T>
+    void get(T& value) {
+        if (!valid || static_cast<size_t>(end - position) < sizeof(T)) {
+            valid = false;
+            return;
+        }
+        std::memcpy(&value, position, sizeof(T));
+        position += sizeof(T);
+    }
+
+    void getString(std::string& value) {
+        size_t size = 0;
+        get(size);
+        if (!valid || static_cast<size_t>(end - position) < size) {
+            valid = false;
+            return;
+        }
+        value.assign(position, size);
+        position += size;
+    }
+
+    void getValues(std::vector<long long>& values) {
+        size_t count = 0;
+        get(count);
+        if (!valid || static_cast<size_t>(end - position) / sizeof(long long) < count) {
+            valid = false;
+            return;
+        }
+        values.resize(count);
+        std::memcpy(values.data(), position, count * sizeof(long long));
+        position += count * sizeof(long long);
+    }
+
+    template <typename T>
+    void getRecords(std::vector<T>& records) {
+        size_t count = 0;
+        get(count);
+        if (!valid || static_cast<size_t>(end - position) / sizeof(T) < count) {
+            valid = false;
+            return;
+        }
+        records.resize(count);
+        std::memcpy(static_cast<void*>(records.data()), position, count * sizeof(T));
+        position += count * sizeof(T);
+    }
+};
+
+void putStatistics(ByteWriter& writer, const DetailedStatistics& stats) {
+    writer.put(stats.treeType);
+    writer.putString(stats.treeName);
+    writer.put(stats.timeMetrics);
+
+    const DetailedStatistics::StructureMetrics& structure = stats.structureMetrics;
+    writer.put(structure.samples);
+    writer.put(structure.maxHeight);
+    writer.put(structure.minHeight);
+    writer.put(structure.avgHeight);
+    writer.put(structure.nodeCount);
+    writer.put(structure.leafCount);
+    writer.put(structure.balanceFactor);
+    writer.put(structure.avgDepth);
+    writer.put(structure.internalPathLength);
+    writer.put(structure.successfulComparisons);
+    writer.put(structure.unsuccessfulComparisons);
+    writer.put(structure.fillFactor);
+    writer.putValues(structure.depthHistogram);
+
+    writer.put(stats.avlRotations);
+    writer.put(stats.avlBalanceOperations);
+    writer.put(stats.aaSkewOperations);
+    writer.put(stats.aaSplitOperations);
+    writer.put(stats.treapSplitOperations);
+    writer.put(stats.treapMergeOperations);
+    writer.put(stats.treapPriorityChanges);
+    writer.put(stats.twoThreeSplits);
+    writer.put(stats.twoThreeMerges);
+    writer.put(stats.twoThreeBorrows);
+    writer.put(stats.comparisons);
+    writer.put(stats.nodeVisits);
+    writer.put(stats.allocations);
+    writer.putValues(stats.insertLatency.save());
+    writer.putValues(stats.searchLatency.save());
+    writer.putValues(stats.deleteLatency.save());
+}
+
+bool getStatistics(ByteReader& reader, DetailedStatistics& stats) {
+    reader.get(stats.treeType);
+    reader.getString(stats.treeName);
+    reader.get(stats.timeMetrics);
+
+    DetailedStatistics::StructureMetrics& structure = stats.structureMetrics;
+    reader.get(structure.samples);
+    reader.get(structure.maxHeight);
+    reader.get(structure.minHeight);
+    reader.get(structure.avgHeight);
+    reader.get(structure.nodeCount);
+    reader.get(structure.leafCount);
+    reader.get(structure.balanceFactor);
+    reader.get(structure.avgDepth);
+    reader.get(structure.internalPathLength);
+    reader.get(structure.successfulComparisons);
+    reader.get(structure.unsuccessfulComparisons);
+    reader.get(structure.fillFactor);
+    reader.getValues(structure.depthHistogram);
+
+    reader.get(stats.avlRotations);
+    reader.get(stats.avlBalanceOperations);
+    reader.get(stats.aaSkewOperations);
+    reader.get(stats.aaSplitOperations);
+    reader.get(stats.treapSplitOperations);
+    reader.get(stats.treapMergeOperations);
+    reader.get(stats.treapPriorityChanges);
+    reader.get(stats.twoThreeSplits);
+    reader.get(stats.twoThreeMerges);
+    reader.get(stats.twoThreeBorrows);
+    reader.get(stats.comparisons);
+    reader.get(stats.nodeVisits);
+    reader.get(stats.allocations);
+
+    LatencyHistogram* histograms[] = { &stats.insertLatency, &stats.searchLatency, &stats.deleteLatency };
+    for (LatencyHistogram* histogram : histograms) {
+        std::vector<long long> state;
+        reader.getValues(state);
+        if (reader.isValid() && !histogram->load(state)) return false;
+    }
+    return reader.isValid();
+}
+
+}
+
+std::string CellIsolation::serialize(const CellOutput& output) {
+    std::string buffer;
+    ByteWriter writer(buffer);
+
+    const std::vector<BenchmarkResult>& results = output.results;
+    writer.put(results.size());
+    for (const auto& result : results) {
+        writer.put(result.tree_type);
+        writer.putString(result.operation);
+        writer.put(result.data_size);
+        writer.put(result.data_order);
+        writer.put(result.cache_mode);
+        writer.put(result.run);
+        writer.put(result.timing_batch);
+        writer.put(result.total_time_ns);
+        writer.put(result.avg_time_ns);
+        writer.put(result.min_time_ns);
+        writer.put(result.max_time_ns);
+        writer.put(result.final_height);
+        writer.put(result.final_nodes);
+        writer.put(result.rotations);
+        writer.put(result.comparisons);
+        writer.put(result.node_visits);
+        writer.put(result.skews);
+        writer.put(result.splits);
+        writer.put(result.merges);
+        writer.put(result.borrows);
+        writer.put(result.allocations);
+        writer.put(result.threads);
+        writer.put(result.memory_bytes);
+        writer.put(result.bytes_per_key);
+        writer.put(result.heap_bytes);
+        writer.put(result.peak_heap_bytes);
+        writer.put(result.heap_allocations);
+        writer.put(result.rss_bytes);
+        writer.put(result.footprint_bytes);
+        writer.putValues(result.latency.save());
+        writer.put(result.counters);
+        writer.put(result.cache);
+        writer.put(result.phases);
+        writer.putRecords(result.telemetry);
+        writer.putValues(result.raw_latency_ns);
+    }
+
+    writer.put(output.statistics.size());
+    for (const DetailedStatistics& stats : output.statistics) {
+        putStatistics(writer, stats);
+    }
+
+    writer.put(output.trace.size());
+    for (const TraceRecorder::ThreadEvents& thread : output.trace) {
+        writer.putString(thread.thread_name);
+        writer.putRecords(thread.events);
+    }
+    return buffer;
+}
+
+bool CellIsolation::deserialize(const char* data, size_t size, CellOutput& output) {
+    ByteReader reader(data, size);
+
+    size_t count = 0;
+    reader.get(count);
+    if (!reader.isValid()) return false;
+
+    std::vector<BenchmarkResult>& results = output.results;
+    results.clear();
+    for (size_t i = 0; i < count && reader.isValid(); i++) {
+        BenchmarkResult result;
+        reader.get(result.tree_type);
+        reader.getString(result.operation);
+        reader.get(result.data_size);
+        reader.get(result.data_order);
+        reader.get(result.cache_mode);
+        reader.get(result.run);
+        reader.get(result.timing_batch);
+        reader.get(result.total_time_ns);
+        reader.get(result.avg_time_ns);
+        reader.get(result.min_time_ns);
+        reader.get(result.max_time_ns);
+        reader.get(result.final_height);
+        reader.get(result.final_nodes);
+        reader.get(result.rotations);
+        reader.get(result.comparisons);
+        reader.get(result.node_visits);
+        reader.get(result.skews);
+        reader.get(result.splits);
+        reader.get(result.merges);
+        reader.get(result.borrows);
+        reader.get(result.allocations);
+        reader.get(result.threads);
+        reader.get(result.memory_bytes);
+        reader.get(result.bytes_per_key);
+        reader.get(result.heap_bytes);
+        reader.get(result.peak_heap_bytes);
+        reader.get(result.heap_allocations);
+        reader.get(result.rss_bytes);
+        reader.get(result.footprint_bytes);
+
+        std::vector<long long> latency;
+        reader.getValues(latency);
+        if (reader.isValid() && !result.latency.load(latency)) return false;
+
+        reader.get(result.counters);
+        reader.get(result.cache);
+        reader.get(result.phases);
+        reader.getRecords(result.telemetry);
+        reader.getValues(result.raw_latency_ns);
+        results.push_back(result);
+    }
+
+    count = 0;
+    reader.get(count);
+    output.statistics.clear();
+    for (size_t i = 0; i < count && reader.isValid(); i++) {
+        DetailedStatistics stats;
+        if (!getStatistics(reader, stats)) return false;
+        output.statistics.push_back(stats);
+    }
+
+    count = 0;
+    reader.get(count);
+    output.trace.clear();
+    for (size_t i = 0; i < count && reader.isValid(); i++) {
+        TraceRecorder::ThreadEvents thread;
+        reader.getString(thread.thread_name);
+        reader.getRecords(thread.events);
+        output.trace.push_back(thread);
+    }
+    return reader.isValid();
+}
+
+// =============== ЗАПУСК ===============
+
+#ifdef _WIN32
+
+CellIsolation::Status CellIsolation::run(const std::function<std::vector<BenchmarkResult>()>& body,
+    long long timeout_ms, StatisticsCollector* statistics, std::vector<BenchmarkResult>& results,
+    std::string& error) {
+    error = "изоляция процессом недоступна на этой платформе";
+    return UNSUPPORTED;
+}
+
+#else
+
+namespace {
+
+// Первый байт ответа: за ним результаты или текст ошибки
+const char REPLY_RESULTS = 1;
+const char REPLY_ERROR = 0;
+
+bool writeAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+// false - конец канала (потомок закрыл его или завершился)
+bool readAvailable(int fd, std::string& received) {
+    char chunk[64 * 1024];
+    ssize_t count = read(fd, chunk, sizeof(chunk));
+    if (count > 0) {
+        received.append(chunk, static_cast<size_t>(count));
+        return true;
+    }
+    return count < 0 && errno == EINTR;
+}
+
+}
+
+CellIsolation::Status CellIsolation::run(const std::function<std::vector<BenchmarkResult>()>& body,
+    long long timeout_ms, StatisticsCollector* statistics, std::vector<BenchmarkResult>& results,
+    std::string& error) {
+    int channel[2];
+    if (pipe(channel) != 0) {
+        error = std::string("pipe: ") + std::strerror(errno);
+        return FAILED;
+    }
+
+    // Иначе недописанный буфер вывода напечатают оба процесса
+    std::cout.flush();
+    std::cerr.flush();
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        error = std::string("fork: ") + std::strerror(errno);
+        close(channel[0]);
+        close(channel[1]);
+        return FAILED;
+    }
+
+    if (pid == 0) {
+        // Потомок завершается через _exit: деструкторы и atexit родителя не выполняются.
+        // Статистика и трасса - копии родительских, в ответ идет только записанное ячейкой
+        close(channel[0]);
+        int code = 0;
+        std::string reply(1, REPLY_RESULTS);
+        try {
+            if (statistics) statistics->clear();
+            TraceRecorder::clear();
+
+            CellOutput output;
+            output.results = body();
+            if (statistics) output.statistics = statistics->getAllStatistics();
+            if (TraceRecorder::isEnabled()) output.trace = TraceRecorder::exportEvents();
+            reply += serialize(output);
+        }
+        catch (const std::exception& e) {
+            reply.assign(1, REPLY_ERROR);
+            reply += e.what();
+            code = 1;
+        }
+        catch (...) {
+            reply.assign(1, REPLY_ERROR);
+            reply += "неизвестное исключение";
+            code = 1;
+        }
+        if (!writeAll(channel[1], reply.data(), reply.size())) {
+            code = 1;
+        }
+        close(channel[1]);
+        std::cout.flush();
+        std::cerr.flush();
+        _exit(code);
+    }
+
+    // Родитель читает канал по мере записи (иначе потомок встанет на полном
+    // канале) и опрашивает потомка до завершения или истечения времени
+    close(channel[1]);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    std::string received;
+    bool reading = true;
+    int status = 0;
+    bool timedOut = false;
+    while (true) {
+        if (reading) {
+            pollfd descriptor = { channel[0], POLLIN, 0 };
+            if (poll(&descriptor, 1, 5) > 0) {
+                reading = readAvailable(channel[0], received);
+            }
+        }
+        else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+
+        pid_t done = waitpid(pid, &status, WNOHANG);
+        if (done == pid) break;
+        if (done < 0 && errno != EINTR) break;
+
+        if (timeout_ms > 0 && std::chrono::steady_clock::now() >= deadline) {
+            kill(pid, SIGKILL);
+            waitpid(pid, &status, 0);
+            timedOut = true;
+            break;
+        }
+    }
+
+    // Остаток ответа в канале после завершения потомка
+    while (reading && !timedOut) {
+        reading = readAvailable(channel[0], received);
+    }
+    close(channel[0]);
+
+    CellOutput output;
+    Status result = COMPLETED;
+    if (timedOut) {
+        error = "превышено время " + std::to_string(timeout_ms) + " мс";
+        result = TIMED_OUT;
+    }
+    else if (WIFSIGNALED(status)) {
+        error = std::string("процесс завершен сигналом ") + std::to_string(WTERMSIG(status));
+        result = FAILED;
+    }
+    else if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || received.empty() || received[0] != REPLY_RESULTS) {
+        error = received.size() > 1 && received[0] == REPLY_ERROR ? received.substr(1)
+            : "процесс завершился без результатов";
+        result = FAILED;
+    }
+    else if (!deserialize(received.data() + 1, received.size() - 1, output)) {
+        error = "поврежденные результаты";
+        result = FAILED;
+    }
+
+    if (result == COMPLETED) {
+        results = std::move(output.results);
+        if (statistics) {
+            for (const DetailedStatistics& stats : output.statistics) {
+                statistics->merge(stats);
+            }
+        }
+        TraceRecorder::importEvents(output.trace);
+    }
+    return result;
+}
+
+#endif
@@ -0,0 +1,50 @@
+#pragma once
+// include/CellIsolation.h
+#ifndef CELLISOLATION_H
+#define CELLISOLATION_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Statistics.h"
+#include "TraceRecorder.h"
+
+// Выполнение ячейки теста в дочернем процессе (fork). Куча, кэши и состояние
+// аллокатора одной ячейки не переходят в следующую, а зависшую или упавшую
+// ячейку можно снять, не теряя остальной прогон. Результаты, статистика
+// и события трассы передаются родителю через канал (pipe), который родитель
+// читает по мере записи, - объем ответа заранее не ограничен
+class CellIsolation {
+public:
+    enum Status {
+        COMPLETED,
+        TIMED_OUT,      // Процесс снят по истечении времени
+        FAILED,         // Исключение, сигнал, ненулевой код или поврежденный ответ
+        UNSUPPORTED     // Нет fork (Windows)
+    };
+
+    static bool isSupported();
+    static const char* getStatusName(Status status);
+
+    // Выполняет body в дочернем процессе, ждет не больше timeout_ms (0 - без
+    // предела). При COMPLETED results - результаты body, а то, что body
+    // записал в statistics (если задан) и в трассу, добавлено в этот процесс.
+    // Иначе error - причина
+    static Status run(const std::function<std::vector<BenchmarkResult>()>& body, long long timeout_ms,
+        StatisticsCollector* statistics, std::vector<BenchmarkResult>& results, std::string& error);
+
+private:
+    // Ответ дочернего процесса
+    struct CellOutput {
+        std::vector<BenchmarkResult> results;
+        std::vector<DetailedStatistics> statistics;
+        std::vector<TraceRecorder::ThreadEvents> trace;
+    };
+
+    static std::string serialize(const CellOutput& output);
+    static bool deserialize(const char* data, size_t size, CellOutput& output);
+};
+
+#endif // CELLISOLATION_H
\ No newline at end of file
@@ -0,0 +1,444 @@
+// src/ColumnarFile.cpp
+#include <cstring>
+#include <iostream>
+
+#include "ColumnarFile.h"
+
+// =============== КОДИРОВАНИЕ ===============
+
+namespace {
+
+const char FILE_MAGIC[8] = { 'T', 'R', 'E', 'E', 'C', 'O', 'L', '1' };
+const char CHUNK_MARKER[4] = { 'C', 'H', 'N', 'K' };
+const char END_MARKER[4] = { 'T', 'E', 'N', 'D' };
+
+// Числа пишутся побайтово: файл переносим между платформами
+void putUnsigned(std::string& out, std::uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        out += static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+}
+
+void putVarint(std::string& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out += static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+std::uint64_t zigzag(std::uint64_t delta) {
+    return (delta << 1) ^ static_cast<std::uint64_t>(static_cast<std::int64_t>(delta) >> 63);
+}
+
+std::uint64_t unzigzag(std::uint64_t value) {
+    return (value >> 1) ^ (~(value & 1) + 1);
+}
+
+std::uint64_t doubleBits(double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double bitsDouble(std::uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Чтение из потока: false - данных меньше, чем нужно
+bool readUnsigned(std::istream& in, std::uint64_t& value, int bytes) {
+    unsigned char buffer[8];
+    if (!in.read(reinterpret_cast<char*>(buffer), bytes)) return false;
+    value = 0;
+    for (int i = 0; i < bytes; i++) {
+        value |= static_cast<std::uint64_t>(buffer[i]) << (8 * i);
+    }
+    return true;
+}
+
+bool readString(std::istream& in, std::string& value, size_t size) {
+    value.resize(size);
+    return size == 0 || static_cast<bool>(in.read(&value[0], static_cast<std::streamsize>(size)));
+}
+
+// Разбор данных колонки блока
+class PayloadReader {
+private:
+    const unsigned char* position;
+    const unsigned char* end;
+
+public:
+    explicit PayloadReader(const std::string& data)
+        : position(reinterpret_cast<const unsigned char*>(data.data())),
+        end(reinterpret_cast<const unsigned char*>(data.data()) + data.size()) {}
+
+    bool getFixed(std::uint64_t& value) {
+        if (end - position < 8) return false;
+        value = 0;
+        for (int i = 0; i < 8; i++) {
+            value |= static_cast<std::uint64_t>(position[i]) << (8 * i);
+        }
+        position += 8;
+        return true;
+    }
+
+    bool getVarint(std::uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64 && position < end; shift += 7) {
+            unsigned char byte = *position++;
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    bool isFinished() const { return position == end; }
+};
+
+}
+
+// =============== ЗАПИСЬ ===============
+
+ColumnarWriter::ColumnarWriter(const std::string& filename, const std::vector<ColumnSpec>& columnSpecs,
+    size_t chunkRows)
+    : file(filename, std::ios::binary | std::ios::trunc), columns(columnSpecs),
+    chunk_rows(chunkRows > 0 ? chunkRows : DEFAULT_CHUNK_ROWS),
+    ints(columnSpecs.size()), doubles(columnSpecs.size()),
+    dictionaries(columnSpecs.size()), pending(columnSpecs.size()) {
+    if (!file.is_open()) {
+        std::cerr << "Не удалось открыть файл: " << filename << std::endl;
+        failed = true;
+        return;
+    }
+
+    std::string header(FILE_MAGIC, sizeof(FILE_MAGIC));
+    putUnsigned(header, columns.size(), 4);
+    for (ColumnSpec& column : columns) {
+        if (column.type == ColumnType::FLOAT64) {
+            column.encoding = ColumnEncoding::PLAIN;
+        }
+        putUnsigned(header, static_cast<std::uint8_t>(column.type), 1);
+        putUnsigned(header, static_cast<std::uint8_t>(column.encoding), 1);
+        putUnsigned(header, column.name.size(), 2);
+        header += column.name;
+    }
+    failed = !file.write(header.data(), static_cast<std::streamsize>(header.size()));
+}
+
+ColumnarWriter::~ColumnarWriter() {
+    close();
+}
+
+void ColumnarWriter::set(size_t column, long long value) {
+    ints[column].push_back(value);
+}
+
+void ColumnarWriter::set(size_t column, double value) {
+    doubles[column].push_back(value);
+}
+
+void ColumnarWriter::set(size_t column, const std::string& value) {
+    auto& dictionary = dictionaries[column];
+    auto it = dictionary.find(value);
+    if (it == dictionary.end()) {
+        it = dictionary.emplace(value, static_cast<long long>(dictionary.size())).first;
+        pending[column].push_back(value);
+    }
+    ints[column].push_back(it->second);
+}
+
+void ColumnarWriter::endRow() {
+    rows_in_chunk++;
+    total_rows++;
+    if (rows_in_chunk >= chunk_rows) {
+        writeChunk();
+    }
+}
+
+bool ColumnarWriter::writeChunk() {
+    if (failed || rows_in_chunk == 0) return !failed;
+
+    std::string buffer(CHUNK_MARKER, sizeof(CHUNK_MARKER));
+    putUnsigned(buffer, rows_in_chunk, 4);
+
+    std::string payload;
+    for (size_t c = 0; c < columns.size(); c++) {
+        const ColumnSpec& column = columns[c];
+        bool is_double = column.type == ColumnType::FLOAT64;
+        size_t values = is_double ? doubles[c].size() : ints[c].size();
+        if (values != rows_in_chunk) {
+            std::cerr << "Колонка " << column.name << ": " << values << " значений на "
+                << rows_in_chunk << " строк" << std::endl;
+            failed = true;
+            return false;
+        }
+
+        if (column.type == ColumnType::STRING) {
+            putUnsigned(buffer, pending[c].size(), 4);
+            for (const std::string& value : pending[c]) {
+                putUnsigned(buffer, value.size(), 4);
+                buffer += value;
+            }
+            pending[c].clear();
+        }
+
+        payload.clear();
+        if (is_double) {
+            for (double value : doubles[c]) {
+                putUnsigned(payload, doubleBits(value), 8);
+            }
+        }
+        else if (column.encoding == ColumnEncoding::DELTA_VARINT) {
+            // Разности - в беззнаковой арифметике, без переполнения знаковых
+            std::uint64_t previous = 0;
+            for (long long value : ints[c]) {
+                std::uint64_t current = static_cast<std::uint64_t>(value);
+                putVarint(payload, zigzag(current - previous));
+                previous = current;
+            }
+        }
+        else {
+            for (long long value : ints[c]) {
+                putUnsigned(payload, static_cast<std::uint64_t>(value), 8);
+            }
+        }
+        putUnsigned(buffer, payload.size(), 4);
+        buffer += payload;
+
+        ints[c].clear();
+        doubles[c].clear();
+    }
+
+    rows_in_chunk = 0;
+    chunks_written++;
+    failed = !file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    return !failed;
+}
+
+bool ColumnarWriter::flush() {
+    if (closed) return !failed;
+    writeChunk();
+    if (!failed) {
+        failed = !file.flush();
+    }
+    return !failed;
+}
+
+bool ColumnarWriter::close() {
+    if (closed) return !failed;
+    closed = true;
+    if (!file.is_open()) return false;
+
+    writeChunk();
+    if (!failed) {
+        std::string trailer(END_MARKER, sizeof(END_MARKER));
+        putUnsigned(trailer, static_cast<std::uint64_t>(total_rows), 8);
+        failed = !file.write(trailer.data(), static_cast<std::streamsize>(trailer.size()));
+    }
+    file.close();
+    failed = failed || file.fail();
+    return !failed;
+}
+
+// =============== ЧТЕНИЕ ===============
+
+bool ColumnarReader::open(const std::string& filename) {
+    file.open(filename, std::ios::binary);
+    if (!file.is_open()) {
+        error = "не удалось открыть файл " + filename;
+        return false;
+    }
+
+    char magic[sizeof(FILE_MAGIC)];
+    std::uint64_t count = 0;
+    if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, FILE_MAGIC, sizeof(magic)) != 0 ||
+        !readUnsigned(file, count, 4)) {
+        error = "не колоночный файл результатов";
+        return false;
+    }
+
+    columns.resize(count);
+    dictionaries.resize(count);
+    for (ColumnSpec& column : columns) {
+        std::uint64_t type = 0;
+        std::uint64_t encoding = 0;
+        std::uint64_t length = 0;
+        if (!readUnsigned(file, type, 1) || !readUnsigned(file, encoding, 1) ||
+            !readUnsigned(file, length, 2) || !readString(file, column.name, length)) {
+            error = "заголовок оборван";
+            return false;
+        }
+        if (type < 1 || type > 3 || encoding > 1) {
+            error = "неизвестный тип колонки " + column.name;
+            return false;
+        }
+        column.type = static_cast<ColumnType>(type);
+        column.encoding = static_cast<ColumnEncoding>(encoding);
+    }
+    return true;
+}
+
+bool ColumnarReader::readChunk(ColumnarChunk& chunk) {
+    if (complete || !error.empty() || !file.is_open()) return false;
+
+    char marker[4];
+    if (!file.read(marker, sizeof(marker))) {
+        // Конец без завершения: прогон прерван, записанные блоки прочитаны
+        return false;
+    }
+
+    if (std::memcmp(marker, END_MARKER, sizeof(marker)) == 0) {
+        std::uint64_t total = 0;
+        if (!readUnsigned(file, total, 8)) {
+            return false;
+        }
+        if (static_cast<long long>(total) != rows_read) {
+            error = "в файле " + std::to_string(rows_read) + " строк вместо " + std::to_string(total);
+        }
+        else {
+            complete = true;
+        }
+        return false;
+    }
+    if (std::memcmp(marker, CHUNK_MARKER, sizeof(marker)) != 0) {
+        error = "нарушена структура блоков";
+        return false;
+    }
+
+    // Блок, оборванный на середине, - не ошибка: прогон прерван во время
+    // записи, прочитанные ранее блоки целы
+    std::uint64_t rows = 0;
+    if (!readUnsigned(file, rows, 4)) {
+        return false;
+    }
+
+    chunk.rows = static_cast<size_t>(rows);
+    chunk.ints.assign(columns.size(), std::vector<long long>());
+    chunk.doubles.assign(columns.size(), std::vector<double>());
+
+    std::string payload;
+    for (size_t c = 0; c < columns.size(); c++) {
+        const ColumnSpec& column = columns[c];
+
+        if (column.type == ColumnType::STRING) {
+            std::uint64_t added = 0;
+            if (!readUnsigned(file, added, 4)) {
+                return false;
+            }
+            for (std::uint64_t i = 0; i < added; i++) {
+                std::uint64_t length = 0;
+                std::string value;
+                if (!readUnsigned(file, length, 4) || !readString(file, value, length)) {
+                    return false;
+                }
+                dictionaries[c].push_back(value);
+            }
+        }
+
+        std::uint64_t length = 0;
+        if (!readUnsigned(file, length, 4) || !readString(file, payload, length)) {
+            return false;
+        }
+
+        PayloadReader reader(payload);
+        bool valid = true;
+        if (column.type == ColumnType::FLOAT64) {
+            auto& values = chunk.doubles[c];
+            values.reserve(chunk.rows);
+            for (size_t i = 0; i < chunk.rows && valid; i++) {
+                std::uint64_t bits = 0;
+                valid = reader.getFixed(bits);
+                values.push_back(bitsDouble(bits));
+            }
+        }
+        else {
+            auto& values = chunk.ints[c];
+            values.reserve(chunk.rows);
+            std::uint64_t previous = 0;
+            for (size_t i = 0; i < chunk.rows && valid; i++) {
+                std::uint64_t raw = 0;
+                if (column.encoding == ColumnEncoding::DELTA_VARINT) {
+                    valid = reader.getVarint(raw);
+                    previous += unzigzag(raw);
+                }
+                else {
+                    valid = reader.getFixed(previous);
+                }
+                values.push_back(static_cast<long long>(previous));
+            }
+        }
+        if (!valid || !reader.isFinished()) {
+            error = "данные колонки " + column.name + " повреждены";
+            return false;
+        }
+    }
+
+    rows_read += static_cast<long long>(chunk.rows);
+    return true;
+}
+
+const std::string& ColumnarReader::getString(size_t column, long long code) const {
+    static const std::string unknown;
+    const auto& dictionary = dictionaries[column];
+    return code >= 0 && static_cast<size_t>(code) < dictionary.size() ? dictionary[code] : unknown;
+}
+
+bool ColumnarReader::convertToCSV(const std::string& input, const std::string& output,
+    const std::string& separator) {
+    ColumnarReader reader;
+    if (!reader.open(input)) {
+        std::cerr << input << ": " << reader.getError() << std::endl;
+        return false;
+    }
+
+    std::ofstream file(output);
+    if (!file.is_open()) {
+        std::cerr << "Не удалось открыть файл: " << output << std::endl;
+        return false;
+    }
+
+    const auto& columns = reader.getColumns();
+    for (size_t c = 0; c < columns.size(); c++) {
+        file << (c > 0 ? separator : "") << columns[c].name;
+    }
+    file << "\n";
+
+    ColumnarChunk chunk;
+    while (reader.readChunk(chunk)) {
+        for (size_t row = 0; row < chunk.rows; row++) {
+            for (size_t c = 0; c < columns.size(); c++) {
+                if (c > 0) file << separator;
+                switch (columns[c].type) {
+                case ColumnType::INT64:
+                    file << chunk.ints[c][row];
+                    break;
+                case ColumnType::FLOAT64:
+                    file << chunk.doubles[c][row];
+                    break;
+                case ColumnType::STRING:
+                    file << reader.getString(c, chunk.ints[c][row]);
+                    break;
+                }
+            }
+            file << "\n";
+        }
+    }
+
+    if (!reader.getError().empty()) {
+        std::cerr << input << ": " << reader.getError() << std::endl;
+        return false;
+    }
+    if (!reader.isComplete()) {
+        std::cerr << input << ": файл не завершен (прогон прерван), прочитано строк: "
+            << reader.getRowsRead() << std::endl;
+    }
+
+    file.close();
+    if (file.fail()) {
+        std::cerr << "Ошибка записи файла: " << output << std::endl;
+        return false;
+    }
+    return true;
+}
\ No newline at end of file
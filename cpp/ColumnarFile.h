@@ -0,0 +1,131 @@
+#pragma once
+// include/ColumnarFile.h
+#ifndef COLUMNARFILE_H
+#define COLUMNARFILE_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Тип значений колонки. Строки хранятся кодами словаря (INT64)
+enum class ColumnType : std::uint8_t {
+    INT64 = 1,
+    FLOAT64 = 2,
+    STRING = 3
+};
+
+// Кодирование колонки в блоке. DELTA_VARINT - разность с предыдущим
+// значением блока, zigzag и varint: постоянная колонка или счетчик
+// занимают байт на строку. FLOAT64 всегда PLAIN
+enum class ColumnEncoding : std::uint8_t {
+    PLAIN = 0,                  // 8 байт на значение
+    DELTA_VARINT = 1
+};
+
+struct ColumnSpec {
+    std::string name;
+    ColumnType type = ColumnType::INT64;
+    ColumnEncoding encoding = ColumnEncoding::PLAIN;
+};
+
+// Блок строк, прочитанный ColumnarReader: значения по колонкам.
+// Для INT64 и STRING заполнен ints[колонка], для FLOAT64 - doubles[колонка]
+struct ColumnarChunk {
+    size_t rows = 0;
+    std::vector<std::vector<long long>> ints;
+    std::vector<std::vector<double>> doubles;
+};
+
+// Двоичный колоночный файл (числа - little-endian):
+//   "TREECOL1", u32 число колонок, по колонке: u8 тип, u8 кодирование,
+//   u16 длина имени, имя;
+//   блоки: "CHNK", u32 строк, по колонке: [для STRING - u32 новых строк
+//   словаря, каждая u32 длина + байты], u32 длина данных, данные;
+//   завершение: "TEND", u64 всего строк.
+// Блок пишется целиком, поэтому файл прерванного прогона читается до
+// последнего записанного блока.
+// Потоковая запись: значения строки задаются по колонкам (каждая ровно
+// раз), endRow завершает строку. Заполненный блок (chunkRows строк) сразу
+// пишется в файл, flush дописывает неполный - например, после ячейки
+class ColumnarWriter {
+public:
+    static constexpr size_t DEFAULT_CHUNK_ROWS = 65536;
+
+private:
+    std::ofstream file;
+    std::vector<ColumnSpec> columns;
+    size_t chunk_rows;
+    bool failed = false;
+    bool closed = false;
+
+    size_t rows_in_chunk = 0;
+    long long total_rows = 0;
+    long long chunks_written = 0;
+
+    std::vector<std::vector<long long>> ints;
+    std::vector<std::vector<double>> doubles;
+
+    // Словари строковых колонок; pending - строки, еще не записанные в файл
+    std::vector<std::unordered_map<std::string, long long>> dictionaries;
+    std::vector<std::vector<std::string>> pending;
+
+    bool writeChunk();
+
+public:
+    ColumnarWriter(const std::string& filename, const std::vector<ColumnSpec>& columnSpecs,
+        size_t chunkRows = DEFAULT_CHUNK_ROWS);
+    ~ColumnarWriter();
+
+    ColumnarWriter(const ColumnarWriter&) = delete;
+    ColumnarWriter& operator=(const ColumnarWriter&) = delete;
+
+    // false - файл не открыт или запись не удалась
+    bool isGood() const { return !failed; }
+
+    void set(size_t column, long long value);
+    void set(size_t column, double value);
+    void set(size_t column, const std::string& value);
+    void endRow();
+
+    // Записывает неполный блок и сбрасывает поток на диск
+    bool flush();
+    // Записывает остаток и завершение; вызывается и деструктором
+    bool close();
+
+    long long getRowCount() const { return total_rows; }
+    long long getChunkCount() const { return chunks_written; }
+};
+
+// Последовательное чтение блоков ColumnarWriter
+class ColumnarReader {
+private:
+    std::ifstream file;
+    std::vector<ColumnSpec> columns;
+    std::vector<std::vector<std::string>> dictionaries;
+    std::string error;
+    bool complete = false;          // Прочитано завершение файла
+    long long rows_read = 0;
+
+public:
+    bool open(const std::string& filename);
+
+    const std::vector<ColumnSpec>& getColumns() const { return columns; }
+
+    // false - блоков больше нет: конец файла, обрыв или ошибка (getError)
+    bool readChunk(ColumnarChunk& chunk);
+
+    // Строка по коду словаря колонки STRING
+    const std::string& getString(size_t column, long long code) const;
+
+    bool isComplete() const { return complete; }
+    long long getRowsRead() const { return rows_read; }
+    const std::string& getError() const { return error; }
+
+    // Перевод в CSV (одна строка файла - строка CSV) для существующих скриптов
+    static bool convertToCSV(const std::string& input, const std::string& output,
+        const std::string& separator = ";");
+};
+
+#endif // COLUMNARFILE_H
\ No newline at end of file
@@ -0,0 +1,324 @@
+// src/ConcurrentTree.cpp
+#include <algorithm>
+#include <iterator>
+#include <thread>
+#include <unordered_map>
+
+#include "ConcurrentTree.h"
+
+// =============== LockedTree ===============
+
+LockedTree::LockedTree(std::unique_ptr<TreeBase> inner, SyncMode syncMode)
+    : tree(std::move(inner)), mode(syncMode) {
+    // Операции засекает обертка
+    tree->setOperationTiming(false);
+}
+
+OperationResult LockedTree::insert(int key) {
+    return measureWrapped([&]() {
+        std::unique_lock<std::shared_mutex> lock(treeMutex);
+        return tree->insert(key);
+        });
+}
+
+OperationResult LockedTree::remove(int key) {
+    return measureWrapped([&]() {
+        std::unique_lock<std::shared_mutex> lock(treeMutex);
+        return tree->remove(key);
+        });
+}
+
+OperationResult LockedTree::search(int key) {
+    // Поиск одинаков в обоих режимах: contains не трогает статистику дерева,
+    // поэтому под разделяемой блокировкой читатели идут параллельно
+    OperationResult result = measureWrapped([&]() {
+        OperationResult found;
+        if (mode == SyncMode::RW_LOCK) {
+            std::shared_lock<std::shared_mutex> lock(treeMutex);
+            found.success = tree->contains(key);
+        }
+        else {
+            std::unique_lock<std::shared_mutex> lock(treeMutex);
+            found.success = tree->contains(key);
+        }
+        return found;
+        });
+
+    result.message = result.success ? "Ключ найден" : "Ключ не найден";
+    return result;
+}
+
+OperationResult LockedTree::clear() {
+    std::unique_lock<std::shared_mutex> lock(treeMutex);
+    return tree->clear();
+}
+
+bool LockedTree::contains(int key) const {
+    std::shared_lock<std::shared_mutex> lock(treeMutex);
+    return tree->contains(key);
+}
+
+std::unique_ptr<TreeBase> LockedTree::clone() const {
+    std::shared_lock<std::shared_mutex> lock(treeMutex);
+    return std::make_unique<LockedTree>(tree->clone(), mode);
+}
+
+std::vector<int> LockedTree::traverse(TraversalType type) {
+    std::unique_lock<std::shared_mutex> lock(treeMutex);
+    return tree->traverse(type);
+}
+
+int LockedTree::getHeight() const {
+    std::shared_lock<std::shared_mutex> lock(treeMutex);
+    return tree->getHeight();
+}
+
+int LockedTree::getNodeCount() const {
+    std::shared_lock<std::shared_mutex> lock(treeMutex);
+    return tree->getNodeCount();
+}
+
+bool LockedTree::isEmpty() const {
+    std::shared_lock<std::shared_mutex> lock(treeMutex);
+    return tree->isEmpty();
+}
+
+size_t LockedTree::getMemoryUsage() const {
+    std::shared_lock<std::shared_mutex> lock(treeMutex);
+    return sizeof(*this) + tree->getMemoryUsage();
+}
+
+StructureProfile LockedTree::analyzeStructure(int threads) const {
+    std::shared_lock<std::shared_mutex> lock(treeMutex);
+    return tree->analyzeStructure(threads);
+}
+
+std::string LockedTree::toString() const {
+    std::shared_lock<std::shared_mutex> lock(treeMutex);
+    return tree->toString();
+}
+
+void LockedTree::resetStatistics() {
+    std::unique_lock<std::shared_mutex> lock(treeMutex);
+    tree->resetStatistics();
+}
+
+TreeStatistics LockedTree::getStatistics() const {
+    std::shared_lock<std::shared_mutex> lock(treeMutex);
+    return tree->getStatistics();
+}
+
+// =============== FlatCombiningTree ===============
+
+namespace {
+std::atomic<unsigned long long> nextInstanceId{ 1 };
+}
+
+FlatCombiningTree::FlatCombiningTree(std::unique_ptr<TreeBase> inner, bool sortByKey)
+    : tree(std::move(inner)), sortBatches(sortByKey), instanceId(nextInstanceId++),
+    slotTable(std::make_shared<SlotTable>()), batchCount(0), combinedOperations(0) {
+    // Операции засекает обертка: вместе с ожиданием комбайнера
+    tree->setOperationTiming(false);
+    batch.reserve(MAX_SLOTS);
+}
+
+FlatCombiningTree::Slot* FlatCombiningTree::acquireSlot() {
+    // Слот закрепляется за парой (экземпляр, поток) и возвращается, когда
+    // поток завершается. Таблица держится слабой ссылкой: если экземпляр
+    // уже уничтожен, возвращать некуда
+    struct OwnedSlots {
+        struct Entry {
+            std::weak_ptr<SlotTable> table;
+            Slot* slot;
+        };
+        std::unordered_map<unsigned long long, Entry> entries;
+
+        ~OwnedSlots() {
+            for (auto& pair : entries) {
+                if (std::shared_ptr<SlotTable> table = pair.second.table.lock()) {
+                    pair.second.slot->owned.store(false, std::memory_order_release);
+                }
+            }
+        }
+    };
+    thread_local OwnedSlots ownedSlots;
+
+    auto it = ownedSlots.entries.find(instanceId);
+    if (it != ownedSlots.entries.end()) return it->second.slot;
+
+    // Записи уничтоженных экземпляров не копятся у долгоживущего потока
+    for (auto entry = ownedSlots.entries.begin(); entry != ownedSlots.entries.end();) {
+        entry = entry->second.table.expired() ? ownedSlots.entries.erase(entry) : std::next(entry);
+    }
+
+    SlotTable& table = *slotTable;
+    for (int i = 0; i < MAX_SLOTS; i++) {
+        bool expected = false;
+        if (table.slots[i].owned.compare_exchange_strong(expected, true)) {
+            // Комбайнер просматривает только первые slotCount слотов
+            int count = table.slotCount.load();
+            while (count < i + 1 && !table.slotCount.compare_exchange_weak(count, i + 1)) {
+            }
+            ownedSlots.entries[instanceId] = { slotTable, &table.slots[i] };
+            return &table.slots[i];
+        }
+    }
+
+    // Слоты закончились - поток будет выполнять операции сам под блокировкой
+    return nullptr;
+}
+
+OperationResult FlatCombiningTree::apply(OperationKind kind, int key) {
+    switch (kind) {
+    case OperationKind::INSERT:
+        return tree->insert(key);
+    case OperationKind::REMOVE:
+        return tree->remove(key);
+    default: {
+        // Тот же поиск, что у LockedTree в обоих режимах
+        OperationResult result;
+        result.success = tree->contains(key);
+        result.message = result.success ? "Ключ найден" : "Ключ не найден";
+        return result;
+    }
+    }
+}
+
+void FlatCombiningTree::combine() {
+    // Вызывается только под combinerMutex
+    batch.clear();
+
+    Slot* slots = slotTable->slots;
+    int count = slotTable->slotCount.load(std::memory_order_acquire);
+    for (int i = 0; i < count; i++) {
+        if (slots[i].state.load(std::memory_order_acquire) == SLOT_PENDING) {
+            batch.push_back(i);
+        }
+    }
+
+    if (batch.empty()) return;
+
+    // Упорядочивание по ключу улучшает локальность спусков по дереву
+    if (sortBatches && batch.size() > 1) {
+        std::sort(batch.begin(), batch.end(), [slots](int a, int b) {
+            return slots[a].key < slots[b].key;
+            });
+    }
+
+    for (int index : batch) {
+        Slot& slot = slots[index];
+        slot.result = apply(slot.kind, slot.key);
+        slot.state.store(SLOT_DONE, std::memory_order_release);
+    }
+
+    batchCount.fetch_add(1, std::memory_order_relaxed);
+    combinedOperations.fetch_add(static_cast<long long>(batch.size()), std::memory_order_relaxed);
+}
+
+OperationResult FlatCombiningTree::execute(OperationKind kind, int key) {
+    Slot* slot = acquireSlot();
+
+    if (!slot) {
+        std::lock_guard<std::mutex> lock(combinerMutex);
+        return apply(kind, key);
+    }
+
+    slot->kind = kind;
+    slot->key = key;
+    slot->state.store(SLOT_PENDING, std::memory_order_release);
+
+    while (slot->state.load(std::memory_order_acquire) != SLOT_DONE) {
+        if (combinerMutex.try_lock()) {
+            combine();
+            combinerMutex.unlock();
+        }
+        else {
+            // Комбайнер уже работает - уступаем ему процессор
+            std::this_thread::yield();
+        }
+    }
+
+    OperationResult result = std::move(slot->result);
+    slot->state.store(SLOT_EMPTY, std::memory_order_relaxed);
+    return result;
+}
+
+double FlatCombiningTree::getAverageBatchSize() const {
+    long long batches = batchCount.load(std::memory_order_relaxed);
+    return batches > 0 ?
+        static_cast<double>(combinedOperations.load(std::memory_order_relaxed)) / batches : 0.0;
+}
+
+OperationResult FlatCombiningTree::insert(int key) {
+    return measureWrapped([&]() { return execute(OperationKind::INSERT, key); });
+}
+
+OperationResult FlatCombiningTree::remove(int key) {
+    return measureWrapped([&]() { return execute(OperationKind::REMOVE, key); });
+}
+
+OperationResult FlatCombiningTree::search(int key) {
+    return measureWrapped([&]() { return execute(OperationKind::SEARCH, key); });
+}
+
+OperationResult FlatCombiningTree::clear() {
+    std::lock_guard<std::mutex> lock(combinerMutex);
+    return tree->clear();
+}
+
+bool FlatCombiningTree::contains(int key) const {
+    std::lock_guard<std::mutex> lock(combinerMutex);
+    return tree->contains(key);
+}
+
+std::unique_ptr<TreeBase> FlatCombiningTree::clone() const {
+    std::lock_guard<std::mutex> lock(combinerMutex);
+    return std::make_unique<FlatCombiningTree>(tree->clone(), sortBatches);
+}
+
+std::vector<int> FlatCombiningTree::traverse(TraversalType type) {
+    std::lock_guard<std::mutex> lock(combinerMutex);
+    return tree->traverse(type);
+}
+
+int FlatCombiningTree::getHeight() const {
+    std::lock_guard<std::mutex> lock(combinerMutex);
+    return tree->getHeight();
+}
+
+int FlatCombiningTree::getNodeCount() const {
+    std::lock_guard<std::mutex> lock(combinerMutex);
+    return tree->getNodeCount();
+}
+
+bool FlatCombiningTree::isEmpty() const {
+    std::lock_guard<std::mutex> lock(combinerMutex);
+    return tree->isEmpty();
+}
+
+size_t FlatCombiningTree::getMemoryUsage() const {
+    std::lock_guard<std::mutex> lock(combinerMutex);
+    return sizeof(*this) + sizeof(SlotTable) + tree->getMemoryUsage();
+}
+
+StructureProfile FlatCombiningTree::analyzeStructure(int threads) const {
+    std::lock_guard<std::mutex> lock(combinerMutex);
+    return tree->analyzeStructure(threads);
+}
+
+std::string FlatCombiningTree::toString() const {
+    std::lock_guard<std::mutex> lock(combinerMutex);
+    return tree->toString();
+}
+
+void FlatCombiningTree::resetStatistics() {
+    std::lock_guard<std::mutex> lock(combinerMutex);
+    tree->resetStatistics();
+    batchCount = 0;
+    combinedOperations = 0;
+}
+
+TreeStatistics FlatCombiningTree::getStatistics() const {
+    std::lock_guard<std::mutex> lock(combinerMutex);
+    return tree->getStatistics();
+}
\ No newline at end of file
@@ -0,0 +1,134 @@
+#pragma once
+// include/ConcurrentTree.h
+#ifndef CONCURRENTTREE_H
+#define CONCURRENTTREE_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+#include "TreeBase.h"
+
+// Способы синхронизации однопоточного дерева
+enum class SyncMode {
+    MUTEX,           // Один мьютекс на все операции
+    RW_LOCK,         // Разделяемая блокировка для поиска, эксклюзивная для изменений
+    FLAT_COMBINING   // Потоки публикуют операции, один поток-комбайнер выполняет пакет
+};
+
+// Обертка с грубой блокировкой (мьютекс или блокировка читателей-писателей)
+class LockedTree : public TreeBase {
+private:
+    std::unique_ptr<TreeBase> tree;
+    SyncMode mode;
+    mutable std::shared_mutex treeMutex;
+
+public:
+    LockedTree(std::unique_ptr<TreeBase> inner, SyncMode syncMode = SyncMode::MUTEX);
+
+    // Реализация интерфейса TreeBase
+    OperationResult insert(int key) override;
+    OperationResult remove(int key) override;
+    OperationResult search(int key) override;
+    OperationResult clear() override;
+    bool contains(int key) const override;
+    std::unique_ptr<TreeBase> clone() const override;
+
+    std::vector<int> traverse(TraversalType type) override;
+
+    int getHeight() const override;
+    int getNodeCount() const override;
+    bool isEmpty() const override;
+    size_t getMemoryUsage() const override;
+    StructureProfile analyzeStructure(int threads = 1) const override;
+    bool isThreadSafe() const override { return true; }
+
+    std::string toString() const override;
+
+    void resetStatistics() override;
+    TreeStatistics getStatistics() const override;
+
+    TreeType getType() const override { return tree->getType(); }
+};
+
+// Обертка flat combining: каждый поток кладет операцию в свой слот,
+// поток, захвативший блокировку комбайнера, выполняет все ожидающие
+// операции одним пакетом (при необходимости отсортированным по ключу)
+class FlatCombiningTree : public TreeBase {
+public:
+    static const int MAX_SLOTS = 128;
+
+private:
+    enum class OperationKind { INSERT, REMOVE, SEARCH };
+
+    enum SlotState {
+        SLOT_EMPTY = 0,
+        SLOT_PENDING = 1,
+        SLOT_DONE = 2
+    };
+
+    // Слот выровнен по строке кэша, чтобы потоки не мешали друг другу
+    struct alignas(64) Slot {
+        std::atomic<int> state{ SLOT_EMPTY };
+        std::atomic<bool> owned{ false };
+        OperationKind kind = OperationKind::SEARCH;
+        int key = 0;
+        OperationResult result;
+    };
+
+    // Слоты в отдельном объекте: поток, завершаясь, возвращает свой слот,
+    // а экземпляр к этому моменту может быть уже уничтожен
+    struct SlotTable {
+        Slot slots[MAX_SLOTS];
+        std::atomic<int> slotCount{ 0 };
+    };
+
+    std::unique_ptr<TreeBase> tree;
+    bool sortBatches;
+    unsigned long long instanceId;
+    std::shared_ptr<SlotTable> slotTable;
+    mutable std::mutex combinerMutex;
+    std::vector<int> batch;              // Используется только комбайнером
+
+    // Счетчики пакетов
+    std::atomic<long long> batchCount;
+    std::atomic<long long> combinedOperations;
+
+    Slot* acquireSlot();
+    OperationResult apply(OperationKind kind, int key);
+    OperationResult execute(OperationKind kind, int key);
+    void combine();
+
+public:
+    FlatCombiningTree(std::unique_ptr<TreeBase> inner, bool sortByKey = true);
+
+    // Средний размер пакета - показатель того, насколько эффективно комбинирование
+    double getAverageBatchSize() const;
+
+    // Реализация интерфейса TreeBase
+    OperationResult insert(int key) override;
+    OperationResult remove(int key) override;
+    OperationResult search(int key) override;
+    OperationResult clear() override;
+    bool contains(int key) const override;
+    std::unique_ptr<TreeBase> clone() const override;
+
+    std::vector<int> traverse(TraversalType type) override;
+
+    int getHeight() const override;
+    int getNodeCount() const override;
+    bool isEmpty() const override;
+    size_t getMemoryUsage() const override;
+    StructureProfile analyzeStructure(int threads = 1) const override;
+    bool isThreadSafe() const override { return true; }
+
+    std::string toString() const override;
+
+    void resetStatistics() override;
+    TreeStatistics getStatistics() const override;
+
+    TreeType getType() const override { return tree->getType(); }
+};
+
+#endif // CONCURRENTTREE_H
\ No newline at end of file
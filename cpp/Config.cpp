@@ -0,0 +1,416 @@
+// src/Config.cpp
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "Benchmark.h"
+#include "Config.h"
+#include "LoadGenerator.h"
+
+namespace {
+
+std::string trim(const std::string& str) {
+    size_t begin = str.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) return "";
+    size_t end = str.find_last_not_of(" \t\r\n");
+    return str.substr(begin, end - begin + 1);
+}
+
+// Имена сравниваются без учета регистра и символов '_' и '-'
+std::string normalize(const std::string& str) {
+    std::string result;
+    for (char c : str) {
+        if (c == '_' || c == '-') continue;
+        result += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return result;
+}
+
+bool parseBool(const std::string& value, bool& out) {
+    std::string v = normalize(value);
+    if (v == "true" || v == "1" || v == "yes" || v == "on") { out = true; return true; }
+    if (v == "false" || v == "0" || v == "no" || v == "off") { out = false; return true; }
+    return false;
+}
+
+bool parseInt(const std::string& value, int& out) {
+    std::istringstream ss(value);
+    int parsed;
+    if (!(ss >> parsed) || !(ss >> std::ws).eof()) return false;
+    out = parsed;
+    return true;
+}
+
+bool parseLong(const std::string& value, long long& out) {
+    std::istringstream ss(value);
+    long long parsed;
+    if (!(ss >> parsed) || !(ss >> std::ws).eof()) return false;
+    out = parsed;
+    return true;
+}
+
+bool parseDouble(const std::string& value, double& out) {
+    std::istringstream ss(value);
+    double parsed;
+    if (!(ss >> parsed) || !(ss >> std::ws).eof()) return false;
+    out = parsed;
+    return true;
+}
+
+bool parseOrders(const std::string& value, std::vector<DataOrder>& out) {
+    const DataOrder all[] = {
+        DataOrder::RANDOM, DataOrder::ASCENDING, DataOrder::DESCENDING,
+        DataOrder::ALMOST_SORTED, DataOrder::SORTED_WITH_DUPLICATES,
+        DataOrder::REVERSE_ALMOST_SORTED
+    };
+
+    std::vector<DataOrder> orders;
+    std::istringstream ss(value);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        std::string name = normalize(trim(item));
+        if (name.empty()) continue;
+
+        bool found = false;
+        for (DataOrder order : all) {
+            if (normalize(DataGenerator::getOrderName(order)) == name) {
+                orders.push_back(order);
+                found = true;
+                break;
+            }
+        }
+        if (!found) return false;
+    }
+
+    if (orders.empty()) return false;
+    out = orders;
+    return true;
+}
+
+bool parseModes(const std::string& value, std::vector<CacheMode>& out) {
+    const CacheMode all[] = {
+        CacheMode::WARM, CacheMode::COLD, CacheMode::SHUFFLED, CacheMode::TLB_COLD
+    };
+
+    std::vector<CacheMode> modes;
+    std::istringstream ss(value);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        std::string name = normalize(trim(item));
+        if (name.empty()) continue;
+
+        bool found = false;
+        for (CacheMode mode : all) {
+            if (normalize(Benchmark::getCacheModeName(mode)) == name) {
+                modes.push_back(mode);
+                found = true;
+                break;
+            }
+        }
+        if (!found) return false;
+    }
+
+    if (modes.empty()) return false;
+    out = modes;
+    return true;
+}
+
+bool parseArrivals(const std::string& value, ArrivalProcess& out) {
+    const ArrivalProcess all[] = { ArrivalProcess::CONSTANT, ArrivalProcess::POISSON };
+
+    std::string name = normalize(value);
+    for (ArrivalProcess process : all) {
+        if (normalize(LoadGenerator::getArrivalName(process)) == name) {
+            out = process;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseDoubles(const std::string& value, std::vector<double>& out) {
+    std::vector<double> values;
+    std::istringstream ss(value);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        std::string text = trim(item);
+        if (text.empty()) continue;
+
+        double parsed;
+        if (!parseDouble(text, parsed)) return false;
+        values.push_back(parsed);
+    }
+
+    if (values.empty()) return false;
+    out = values;
+    return true;
+}
+
+}
+
+// =============== ЗАГРУЗКА ===============
+
+bool BenchmarkConfig::loadFromFile(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Не удалось открыть файл конфигурации: " << filename << std::endl;
+        return false;
+    }
+
+    std::string section;
+    std::string line;
+    int lineNumber = 0;
+    bool ok = true;
+
+    while (std::getline(file, line)) {
+        lineNumber++;
+        line = trim(line);
+        if (line.empty() || line[0] == '#' || line[0] == ';') continue;
+
+        if (line.front() == '[' && line.back() == ']') {
+            section = normalize(trim(line.substr(1, line.size() - 2)));
+            continue;
+        }
+
+        size_t eq = line.find('=');
+        if (eq == std::string::npos) {
+            std::cerr << filename << ":" << lineNumber << ": ожидается \"ключ = значение\"" << std::endl;
+            ok = false;
+            continue;
+        }
+
+        std::string key = normalize(trim(line.substr(0, eq)));
+        std::string value = trim(line.substr(eq + 1));
+        bool known = true;
+        bool valid = true;
+
+        if (section == "test") {
+            if (key == "mindatasize") valid = parseInt(value, testConfig.min_data_size);
+            else if (key == "maxdatasize") valid = parseInt(value, testConfig.max_data_size);
+            else if (key == "stepsize") valid = parseInt(value, testConfig.step_size);
+            else if (key == "iterationsperstep") valid = parseInt(value, testConfig.iterations_per_step);
+            else if (key == "dataorders") valid = parseOrders(value, testConfig.data_orders);
+            else if (key == "enableprogressbar") valid = parseBool(value, testConfig.enable_progress_bar);
+            else if (key == "savedetailedlogs") valid = parseBool(value, testConfig.save_detailed_logs);
+            else if (key == "warmupruns") valid = parseInt(value, testConfig.warmup_runs);
+            else if (key == "minruns") valid = parseInt(value, testConfig.min_runs);
+            else if (key == "targetcipercent") valid = parseDouble(value, testConfig.target_ci_percent);
+            else if (key == "timebudgetms") valid = parseLong(value, testConfig.time_budget_ms);
+            else if (key == "timingbatchsize") valid = parseInt(value, testConfig.timing_batch_size);
+            else if (key == "telemetryinterval") valid = parseLong(value, testConfig.telemetry_interval);
+            else if (key == "cachesimulation") valid = parseBool(value, testConfig.cache_simulation);
+            else if (key == "cachemodes") valid = parseModes(value, testConfig.cache_modes);
+            else if (key == "isolatecells") valid = parseBool(value, testConfig.isolate_cells);
+            else if (key == "celltimeoutms") valid = parseLong(value, testConfig.cell_timeout_ms);
+            else if (key == "cachesweep") valid = parseBool(value, testConfig.cache_sweep);
+            else if (key == "sweepmaxkeys") valid = parseLong(value, testConfig.sweep_max_keys);
+            else if (key == "soak") valid = parseBool(value, testConfig.soak);
+            else if (key == "soakkeys") valid = parseInt(value, testConfig.soak_keys);
+            else if (key == "soakdurations") valid = parseLong(value, testConfig.soak_duration_s);
+            else if (key == "soakintervals") valid = parseLong(value, testConfig.soak_interval_s);
+            else if (key == "loadsweep") valid = parseBool(value, testConfig.load_sweep);
+            else if (key == "loadkeys") valid = parseInt(value, testConfig.load_keys);
+            else if (key == "loadpointms") valid = parseLong(value, testConfig.load_point_ms);
+            else if (key == "loadwritepercent") valid = parseInt(value, testConfig.load_write_percent);
+            else if (key == "loadarrivals") valid = parseArrivals(value, testConfig.load_arrivals);
+            else if (key == "loadfractions") valid = parseDoubles(value, testConfig.load_fractions);
+            else known = false;
+        }
+        else if (section == "output") {
+            if (key == "showconsoleoutput") valid = parseBool(value, outputConfig.show_console_output);
+            else if (key == "savetofile") valid = parseBool(value, outputConfig.save_to_file);
+            else if (key == "outputdirectory") outputConfig.output_directory = value;
+            else if (key == "csvseparator") outputConfig.csv_separator = value;
+            else if (key == "generateplots") valid = parseBool(value, outputConfig.generate_plots);
+            else if (key == "exportrawdata") valid = parseBool(value, outputConfig.export_raw_data);
+            else if (key == "exporttrace") valid = parseBool(value, outputConfig.export_trace);
+            else if (key == "metricsdirectory") outputConfig.metrics_directory = value;
+            else if (key == "metricsintervals") valid = parseLong(value, outputConfig.metrics_interval_s);
+            else known = false;
+        }
+        else if (section == "trees") {
+            if (key == "testavl") valid = parseBool(value, treeConfig.test_avl);
+            else if (key == "testaa") valid = parseBool(value, treeConfig.test_aa);
+            else if (key == "testtreap") valid = parseBool(value, treeConfig.test_treap);
+            else if (key == "testtwothree") valid = parseBool(value, treeConfig.test_two_three);
+            else if (key == "testskiplist") valid = parseBool(value, treeConfig.test_skip_list);
+            else if (key == "treapmaxpriority") valid = parseInt(value, treeConfig.treap_max_priority);
+            else if (key == "twothreenodecapacity") valid = parseInt(value, treeConfig.two_three_node_capacity);
+            else known = false;
+        }
+        else if (section == "regression") {
+            if (key == "baselinefile") regressionConfig.baseline_file = value;
+            else if (key == "thresholdpercent") valid = parseDouble(value, regressionConfig.threshold_percent);
+            else if (key == "alpha") valid = parseDouble(value, regressionConfig.alpha);
+            else known = false;
+        }
+        else {
+            known = false;
+        }
+
+        if (!known) {
+            std::cerr << filename << ":" << lineNumber << ": неизвестный ключ \"" << trim(line.substr(0, eq))
+                << "\" в секции [" << section << "]" << std::endl;
+            ok = false;
+        }
+        else if (!valid) {
+            std::cerr << filename << ":" << lineNumber << ": неверное значение \"" << value << "\"" << std::endl;
+            ok = false;
+        }
+    }
+
+    return ok && validate();
+}
+
+// =============== СОХРАНЕНИЕ ===============
+
+bool BenchmarkConfig::saveToFile(const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Не удалось открыть файл: " << filename << std::endl;
+        return false;
+    }
+
+    auto boolean = [](bool value) { return value ? "true" : "false"; };
+
+    file << "# Конфигурация исследования деревьев\n\n";
+
+    file << "[test]\n";
+    file << "min_data_size = " << testConfig.min_data_size << "\n";
+    file << "max_data_size = " << testConfig.max_data_size << "\n";
+    file << "step_size = " << testConfig.step_size << "\n";
+    file << "iterations_per_step = " << testConfig.iterations_per_step << "\n";
+    file << "data_orders = ";
+    for (size_t i = 0; i < testConfig.data_orders.size(); i++) {
+        if (i > 0) file << ", ";
+        file << DataGenerator::getOrderName(testConfig.data_orders[i]);
+    }
+    file << "\n";
+    file << "enable_progress_bar = " << boolean(testConfig.enable_progress_bar) << "\n";
+    file << "save_detailed_logs = " << boolean(testConfig.save_detailed_logs) << "\n";
+    file << "warmup_runs = " << testConfig.warmup_runs << "\n";
+    file << "min_runs = " << testConfig.min_runs << "\n";
+    file << "target_ci_percent = " << testConfig.target_ci_percent << "\n";
+    file << "time_budget_ms = " << testConfig.time_budget_ms << "\n";
+    file << "timing_batch_size = " << testConfig.timing_batch_size << "\n";
+    file << "telemetry_interval = " << testConfig.telemetry_interval << "\n";
+    file << "cache_simulation = " << boolean(testConfig.cache_simulation) << "\n";
+    file << "cache_modes = ";
+    for (size_t i = 0; i < testConfig.cache_modes.size(); i++) {
+        if (i > 0) file << ", ";
+        file << Benchmark::getCacheModeName(testConfig.cache_modes[i]);
+    }
+    file << "\n";
+    file << "isolate_cells = " << boolean(testConfig.isolate_cells) << "\n";
+    file << "cell_timeout_ms = " << testConfig.cell_timeout_ms << "\n";
+    file << "cache_sweep = " << boolean(testConfig.cache_sweep) << "\n";
+    file << "sweep_max_keys = " << testConfig.sweep_max_keys << "\n";
+    file << "soak = " << boolean(testConfig.soak) << "\n";
+    file << "soak_keys = " << testConfig.soak_keys << "\n";
+    file << "soak_duration_s = " << testConfig.soak_duration_s << "\n";
+    file << "soak_interval_s = " << testConfig.soak_interval_s << "\n";
+    file << "load_sweep = " << boolean(testConfig.load_sweep) << "\n";
+    file << "load_keys = " << testConfig.load_keys << "\n";
+    file << "load_point_ms = " << testConfig.load_point_ms << "\n";
+    file << "load_write_percent = " << testConfig.load_write_percent << "\n";
+    file << "load_arrivals = " << LoadGenerator::getArrivalName(testConfig.load_arrivals) << "\n";
+    file << "load_fractions = ";
+    for (size_t i = 0; i < testConfig.load_fractions.size(); i++) {
+        if (i > 0) file << ", ";
+        file << testConfig.load_fractions[i];
+    }
+    file << "\n\n";
+
+    file << "[output]\n";
+    file << "show_console_output = " << boolean(outputConfig.show_console_output) << "\n";
+    file << "save_to_file = " << boolean(outputConfig.save_to_file) << "\n";
+    file << "output_directory = " << outputConfig.output_directory << "\n";
+    file << "csv_separator = " << outputConfig.csv_separator << "\n";
+    file << "generate_plots = " << boolean(outputConfig.generate_plots) << "\n";
+    file << "export_raw_data = " << boolean(outputConfig.export_raw_data) << "\n";
+    file << "export_trace = " << boolean(outputConfig.export_trace) << "\n";
+    file << "metrics_directory = " << outputConfig.metrics_directory << "\n";
+    file << "metrics_interval_s = " << outputConfig.metrics_interval_s << "\n\n";
+
+    file << "[trees]\n";
+    file << "test_avl = " << boolean(treeConfig.test_avl) << "\n";
+    file << "test_aa = " << boolean(treeConfig.test_aa) << "\n";
+    file << "test_treap = " << boolean(treeConfig.test_treap) << "\n";
+    file << "test_two_three = " << boolean(treeConfig.test_two_three) << "\n";
+    file << "test_skip_list = " << boolean(treeConfig.test_skip_list) << "\n";
+    file << "treap_max_priority = " << treeConfig.treap_max_priority << "\n";
+    file << "two_three_node_capacity = " << treeConfig.two_three_node_capacity << "\n\n";
+
+    file << "[regression]\n";
+    file << "baseline_file = " << regressionConfig.baseline_file << "\n";
+    file << "threshold_percent = " << regressionConfig.threshold_percent << "\n";
+    file << "alpha = " << regressionConfig.alpha << "\n";
+
+    file.close();
+    return !file.fail();
+}
+
+// =============== ПРОВЕРКА ===============
+
+bool BenchmarkConfig::validate() const {
+    bool ok = true;
+    auto fail = [&ok](const char* message) {
+        std::cerr << "Ошибка конфигурации: " << message << std::endl;
+        ok = false;
+    };
+
+    if (testConfig.min_data_size < 1) fail("min_data_size должен быть положительным");
+    if (testConfig.max_data_size < testConfig.min_data_size) fail("max_data_size меньше min_data_size");
+    if (testConfig.step_size < 1) fail("step_size должен быть положительным");
+    if (testConfig.iterations_per_step < 1) fail("iterations_per_step должен быть положительным");
+    if (testConfig.data_orders.empty()) fail("не задан ни один порядок данных");
+    if (testConfig.cache_modes.empty()) fail("не задан ни один режим кэша");
+    if (testConfig.warmup_runs < 0) fail("warmup_runs не может быть отрицательным");
+    if (testConfig.min_runs < 1) fail("min_runs должен быть положительным");
+    if (testConfig.target_ci_percent < 0) fail("target_ci_percent не может быть отрицательным");
+    if (testConfig.time_budget_ms < 0) fail("time_budget_ms не может быть отрицательным");
+    if (testConfig.timing_batch_size < 1) fail("timing_batch_size должен быть положительным");
+    if (testConfig.telemetry_interval < 0) fail("telemetry_interval не может быть отрицательным");
+    if (testConfig.cell_timeout_ms < 0) fail("cell_timeout_ms не может быть отрицательным");
+    if (testConfig.sweep_max_keys < 1 || testConfig.sweep_max_keys > 2000000000LL) {
+        fail("sweep_max_keys должен быть от 1 до 2000000000");
+    }
+    if (testConfig.soak_keys < 1) fail("soak_keys должен быть положительным");
+    if (testConfig.soak_duration_s < 1) fail("soak_duration_s должен быть положительным");
+    if (testConfig.soak_interval_s < 1) fail("soak_interval_s должен быть положительным");
+    if (testConfig.load_keys < 1) fail("load_keys должен быть положительным");
+    if (testConfig.load_point_ms < 1) fail("load_point_ms должен быть положительным");
+    if (testConfig.load_write_percent < 0 || testConfig.load_write_percent > 100) {
+        fail("load_write_percent должен быть от 0 до 100");
+    }
+    for (double fraction : testConfig.load_fractions) {
+        if (fraction <= 0) {
+            fail("load_fractions должны быть положительными");
+            break;
+        }
+    }
+    if (testConfig.soak && testConfig.load_sweep) fail("soak и load_sweep не могут быть включены вместе");
+    if (outputConfig.export_trace && !outputConfig.save_to_file) fail("export_trace требует save_to_file = true");
+    if (outputConfig.metrics_interval_s < 1) fail("metrics_interval_s должен быть положительным");
+    if (getTreeTypes().empty()) fail("не выбрано ни одно дерево");
+    if (regressionConfig.threshold_percent < 0) fail("threshold_percent не может быть отрицательным");
+    if (regressionConfig.alpha <= 0 || regressionConfig.alpha >= 1) fail("alpha должен быть в интервале (0, 1)");
+
+    return ok;
+}
+
+std::vector<TreeType> BenchmarkConfig::getTreeTypes() const {
+    std::vector<TreeType> types;
+    if (treeConfig.test_avl) types.push_back(TreeType::AVL);
+    if (treeConfig.test_aa) types.push_back(TreeType::AA);
+    if (treeConfig.test_treap) types.push_back(TreeType::TREAP);
+    if (treeConfig.test_two_three) types.push_back(TreeType::TWO_THREE);
+    if (treeConfig.test_skip_list) types.push_back(TreeType::SKIP_LIST);
+    return types;
+}
+
+BenchmarkConfig BenchmarkConfig::getDefaultConfig() {
+    return BenchmarkConfig();
+}
\ No newline at end of file
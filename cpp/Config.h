@@ -1,52 +1,110 @@
-#pragma once
-// include/Config.h
-#ifndef CONFIG_H
-#define CONFIG_H
-
-#include <string>
-
-#include "DataGenerator.h"
-
-struct BenchmarkConfig {
-    //  
-    struct TestConfig {
-        int min_data_size = 100;
-        int max_data_size = 10000;
-        int step_size = 100;
-        int iterations_per_step = 10;
-        DataOrder data_order = DataOrder::RANDOM;
-        bool enable_progress_bar = true;
-        bool save_detailed_logs = false;
-    } testConfig;
-
-    //  
-    struct OutputConfig {
-        bool show_console_output = true;
-        bool save_to_file = true;
-        std::string output_directory = "results/";
-        std::string csv_separator = ";";
-        bool generate_plots = true;
-        bool export_raw_data = false;
-    } outputConfig;
-
-    //  
-    struct TreeConfig {
-        bool test_avl = true;
-        bool test_aa = true;
-        bool test_treap = true;
-        bool test_two_three = true;
-
-        //     
-        int treap_max_priority = 1000000;
-        int two_three_node_capacity = 3; //  2-3  = 3,  2-3-4 = 4
-    } treeConfig;
-
-    // / 
-    bool loadFromFile(const std::string& filename);
-    bool saveToFile(const std::string& filename);
-
-    //    
-    static BenchmarkConfig getDefaultConfig();
-};
-
+#pragma once
+// include/Config.h
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#include <string>
+#include <vector>
+
+#include "DataGenerator.h"
+
+struct BenchmarkConfig {
+    // Конфигурация тестов
+    struct TestConfig {
+        int min_data_size = 100;
+        int max_data_size = 10000;
+        int step_size = 100;
+        int iterations_per_step = 10;       // Максимум повторов на размер
+        std::vector<DataOrder> data_orders = { DataOrder::RANDOM };
+        bool enable_progress_bar = true;
+        bool save_detailed_logs = false;
+
+        // Правила повторов и замера (см. RepetitionPolicy)
+        int warmup_runs = 1;
+        int min_runs = 3;
+        double target_ci_percent = 2.0;
+        long long time_budget_ms = 120000;  // На каждый размер и порядок
+        int timing_batch_size = 1;
+        long long telemetry_interval = 0;   // Замер структуры каждые N операций (0 - нет)
+        bool cache_simulation = false;
+        std::vector<CacheMode> cache_modes = { CacheMode::WARM };  // Поиск и удаление
+
+        // Каждая ячейка (дерево x повтор) в отдельном процессе (см. IsolationPolicy)
+        bool isolate_cells = false;
+        long long cell_timeout_ms = 600000;
+
+        // Проход по уровням кэша (CacheSweep) вместо сетки min..max с шагом step
+        bool cache_sweep = false;
+        long long sweep_max_keys = 100000000;
+
+        // Длительная нагрузка удалениями и вставками (SoakTest) вместо сетки
+        bool soak = false;
+        int soak_keys = 1000000;
+        long long soak_duration_s = 3600;   // На каждое дерево
+        long long soak_interval_s = 10;
+
+        // Разомкнутая нагрузка по долям пропускной способности (LoadGenerator) вместо сетки
+        bool load_sweep = false;
+        int load_keys = 100000;
+        long long load_point_ms = 2000;
+        int load_write_percent = 20;
+        ArrivalProcess load_arrivals = ArrivalProcess::POISSON;
+        std::vector<double> load_fractions = { 0.1, 0.25, 0.5, 0.7, 0.8, 0.9, 0.95, 1.0, 1.1 };
+    } testConfig;
+
+    // Конфигурация вывода
+    struct OutputConfig {
+        bool show_console_output = true;
+        bool save_to_file = true;
+        std::string output_directory = "results/";
+        std::string csv_separator = ";";
+        bool generate_plots = true;
+        // Время каждой операции прогона сеткой - в двоичный колоночный файл
+        // (ColumnarFile), дописываемый после каждой ячейки
+        bool export_raw_data = false;
+        // Ход прогона сеткой или по уровням кэша для chrome://tracing и Perfetto
+        bool export_trace = false;
+        // Метрики Prometheus для сборщика textfile node_exporter (пустой
+        // каталог - не писать). Обновляются после ячеек прогона сеткой или по
+        // уровням кэша, не чаще раза в интервал
+        std::string metrics_directory;
+        long long metrics_interval_s = 15;
+    } outputConfig;
+
+    // Конфигурация деревьев
+    struct TreeConfig {
+        bool test_avl = true;
+        bool test_aa = true;
+        bool test_treap = true;
+        bool test_two_three = true;
+        bool test_skip_list = true;
+
+        // Специфичные настройки для каждого дерева
+        int treap_max_priority = 1000000;
+        int two_three_node_capacity = 3; // Для 2-3 дерева = 3, для 2-3-4 = 4
+    } treeConfig;
+
+    // Сравнение с базовым прогоном (пустой baseline_file - без сравнения)
+    struct RegressionConfig {
+        std::string baseline_file;
+        double threshold_percent = 5.0;     // Допустимый рост медианы
+        double alpha = 0.05;                // Уровень значимости t-теста
+    } regressionConfig;
+
+    // Загрузка/сохранение конфигурации. Формат - INI: секции [test],
+    // [output], [trees], [regression] и строки "ключ = значение" с именами полей.
+    // Отсутствующие ключи сохраняют текущие значения; неизвестный ключ
+    // или неверное значение - ошибка (сообщение в std::cerr)
+    bool loadFromFile(const std::string& filename);
+    bool saveToFile(const std::string& filename);
+
+    // Проверка согласованности значений (сообщение в std::cerr)
+    bool validate() const;
+
+    std::vector<TreeType> getTreeTypes() const;
+
+    // Получение конфигурации по умолчанию
+    static BenchmarkConfig getDefaultConfig();
+};
+
 #endif // CONFIG_H
\ No newline at end of file
@@ -1,54 +1,59 @@
-#pragma once
-// include/ConsoleUI.h
-#ifndef CONSOLEUI_H
-#define CONSOLEUI_H
-
-#include <memory>
-#include <vector>
-
-#include "Benchmark.h"
-#include "DataGenerator.h"
-#include "TreeBase.h"
-
-class ConsoleUI {
-private:
-    std::unique_ptr<TreeBase> currentTree;
-    TreeType currentTreeType;
-    DataGenerator dataGen;
-    Benchmark benchmark;
-    std::vector<int> currentDataSet;
-
-    //  
-    void mainMenu();
-    void selectTreeType();
-    void treeOperationsMenu();
-    void testingMenu();
-    void visualizationMenu();
-    void exportMenu();
-
-    //   
-    void insertElement();
-    void removeElement();
-    void searchElement();
-    void traverseTree();
-    void clearTree();
-    void printTreeInfo();
-    void printTreeStructure();
-    void generateAndInsertData();
-
-    // 
-    void runSingleTest();
-    void runComparativeTest();
-    void generateDataset();
-
-    //  
-    void printHeader(const std::string& title);
-    void waitForEnter(); 
-    int getIntegerInput(const std::string& prompt);
-
-public:
-    ConsoleUI();
-    void run();
-};
-
+#pragma once
+// include/ConsoleUI.h
+#ifndef CONSOLEUI_H
+#define CONSOLEUI_H
+
+#include <memory>
+#include <vector>
+
+#include "Benchmark.h"
+#include "DataGenerator.h"
+#include "TreeBase.h"
+
+class ConsoleUI {
+private:
+    std::unique_ptr<TreeBase> currentTree;
+    TreeType currentTreeType;
+    DataGenerator dataGen;
+    Benchmark benchmark;
+    std::vector<int> currentDataSet;
+
+    // Основные меню
+    void mainMenu();
+    void selectTreeType();
+    void treeOperationsMenu();
+    void testingMenu();
+    void visualizationMenu();
+    void exportMenu();
+
+    // Операции с деревьями
+    void insertElement();
+    void removeElement();
+    void searchElement();
+    void traverseTree();
+    void clearTree();
+    void printTreeInfo();
+    void printTreeStructure();
+    void generateAndInsertData();
+
+    // Тестирование
+    void runSingleTest();
+    void runComparativeTest();
+    void runScalingTest();
+    void runCacheSweep();
+    void runSoakTest();
+    void runLoadSweep();
+    void generateDataset();
+
+    // Вспомогательные методы
+    void printHeader(const std::string& title);
+    void waitForEnter(); 
+    int getIntegerInput(const std::string& prompt);
+    double getDoubleInput(const std::string& prompt);
+
+public:
+    ConsoleUI();
+    void run();
+};
+
 #endif // CONSOLEUI_H
\ No newline at end of file
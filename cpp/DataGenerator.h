@@ -1,28 +1,35 @@
-#pragma once
-// include/DataGenerator.h
-#ifndef DATAGENERATOR_H
-#define DATAGENERATOR_H
-
-#include <algorithm>
-#include <vector>
-#include <random>
-
-#include "CommonTypes.h"
-
-class DataGenerator {
-private:
-    std::mt19937 rng;
-
-public:
-    DataGenerator(unsigned int seed = std::random_device{}());
-
-    std::vector<int> generate(int count, DataOrder order,
-        int min_value = 1, int max_value = 1000000);
-
-    //   
-    std::vector<int> generateSequential(int start, int count);
-    std::vector<int> generateReverseSequential(int start, int count);
-    std::vector<int> generateWithDuplicates(int count, int unique_count);
-};
-
+#pragma once
+// include/DataGenerator.h
+#ifndef DATAGENERATOR_H
+#define DATAGENERATOR_H
+
+#include <algorithm>
+#include <vector>
+#include <random>
+
+#include "CommonTypes.h"
+
+class DataGenerator {
+private:
+    std::mt19937 rng;
+
+public:
+    DataGenerator(unsigned int seed = std::random_device{}());
+
+    std::vector<int> generate(int count, DataOrder order,
+        int min_value = 1, int max_value = 1000000);
+
+    // Генерация специфических паттернов
+    std::vector<int> generateSequential(int start, int count);
+    std::vector<int> generateReverseSequential(int start, int count);
+    std::vector<int> generateWithDuplicates(int count, int unique_count);
+
+    // count различных ключей в случайном порядке. generate() берет значения
+    // из [min_value, max_value] и при count > 10^6 дает в основном повторы
+    std::vector<int> generateUnique(int count);
+
+    // Имя порядка для файлов результатов и конфигурации ("Random", "AlmostSorted", ...)
+    static const char* getOrderName(DataOrder order);
+};
+
 #endif // DATAGENERATOR_H
\ No newline at end of file
@@ -1,50 +1,50 @@
-// include/FileExporter.h
-#ifndef FILEEXPORTER_H
-#define FILEEXPORTER_H
-
-#include <fstream>
-#include <string>
-#include <vector>
-#include <utility>
-
-#include "CommonTypes.h"
-#include "Statistics.h"
-
-class FileExporter {
-public:
-    //   
-    static bool exportTreeStructure(TreeBase* tree, const std::string& filename);
-
-    //   
-    static bool exportTraversalResults(TreeBase* tree, TraversalType type,
-        const std::string& filename);
-
-    //    CSV
-    static bool exportStatisticsToCSV(const StatisticsCollector& stats,
-        const std::string& filename);
-
-    //   
-    static bool exportComparativeTest(
-        const std::vector<TreeType>& treeTypes,
-        const std::vector<std::string>& treeNames,
-        const std::vector<std::vector<long long>>& results,
-        const std::string& filename);
-
-    //       (gnuplot, matplotlib)
-    static bool exportForPlotting(
-        const std::vector<std::pair<std::string, std::vector<long long>>>& data,
-        const std::string& filename,
-        const std::string& xlabel = " ",
-        const std::string& ylabel = " ()");
-
-    //     Markdown
-    static std::string generateMarkdownReport(
-        const std::vector<DetailedStatistics>& stats,
-        const std::string& title = "   ");
-
-private:
-    static std::string getCurrentDateTime();
-    static std::string escapeCSV(const std::string& str);
-};
-
+// include/FileExporter.h
+#ifndef FILEEXPORTER_H
+#define FILEEXPORTER_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include "CommonTypes.h"
+#include "Statistics.h"
+
+class FileExporter {
+public:
+    // ќкспорт структуры дерева
+    static bool exportTreeStructure(TreeBase* tree, const std::string& filename);
+
+    // ќкспорт результатов обхода
+    static bool exportTraversalResults(TreeBase* tree, TraversalType type,
+        const std::string& filename);
+
+    // ќкспорт статистики в CSV
+    static bool exportStatisticsToCSV(const StatisticsCollector& stats,
+        const std::string& filename);
+
+    // ќкспорт сравнительных тестов
+    static bool exportComparativeTest(
+        const std::vector<TreeType>& treeTypes,
+        const std::vector<std::string>& treeNames,
+        const std::vector<std::vector<long long>>& results,
+        const std::string& filename);
+
+    // ќкспорт в формат для построения графиков (gnuplot, matplotlib)
+    static bool exportForPlotting(
+        const std::vector<std::pair<std::string, std::vector<long long>>>& data,
+        const std::string& filename,
+        const std::string& xlabel = "Љоличество элементов",
+        const std::string& ylabel = "‚ремЯ (нс)");
+
+    // ѓенерация отчета в формате Markdown
+    static std::string generateMarkdownReport(
+        const std::vector<DetailedStatistics>& stats,
+        const std::string& title = "Отчет по исследованию деревьев");
+
+private:
+    static std::string getCurrentDateTime();
+    static std::string escapeCSV(const std::string& str);
+};
+
 #endif // FILEEXPORTER_H
\ No newline at end of file
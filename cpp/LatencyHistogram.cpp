@@ -0,0 +1,189 @@
+// src/LatencyHistogram.cpp
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <sstream>
+
+#include "LatencyHistogram.h"
+
+LatencyHistogram::LatencyHistogram(int precision)
+    : precisionBits(precision), totalCount(0), totalSum(0), minValue(LLONG_MAX), maxValue(0) {
+    if (precisionBits < MIN_PRECISION_BITS) precisionBits = MIN_PRECISION_BITS;
+    if (precisionBits > MAX_PRECISION_BITS) precisionBits = MAX_PRECISION_BITS;
+    subBucketCount = 1LL << precisionBits;
+}
+
+// =============== КОРЗИНЫ ===============
+
+size_t LatencyHistogram::bucketIndex(long long value) const {
+    // Малые значения хранятся точно, по одной корзине на значение
+    if (value < subBucketCount) return static_cast<size_t>(value);
+
+    // Сдвиг, после которого значение попадает в [2^(p-1), 2^p).
+    // Поиск старшего бита - в беззнаковом: 1LL << 63 не определен
+    std::uint64_t bits = static_cast<std::uint64_t>(value);
+    int highestBit = 63;
+    while (!(bits & (1ULL << highestBit))) highestBit--;
+    int shift = highestBit - precisionBits + 1;
+
+    long long halfCount = subBucketCount / 2;
+    return static_cast<size_t>(subBucketCount + (shift - 1) * halfCount + ((value >> shift) - halfCount));
+}
+
+long long LatencyHistogram::bucketLowerBound(size_t index) const {
+    long long position = static_cast<long long>(index);
+    if (position < subBucketCount) return position;
+
+    long long halfCount = subBucketCount / 2;
+    long long offset = position - subBucketCount;
+    int shift = static_cast<int>(offset / halfCount) + 1;
+    long long subBucket = offset % halfCount + halfCount;
+    return subBucket << shift;
+}
+
+long long LatencyHistogram::bucketUpperBound(size_t index) const {
+    long long position = static_cast<long long>(index);
+    if (position < subBucketCount) return position;
+
+    long long halfCount = subBucketCount / 2;
+    int shift = static_cast<int>((position - subBucketCount) / halfCount) + 1;
+    // Граница последней корзины - за пределами long long
+    std::uint64_t upper = static_cast<std::uint64_t>(bucketLowerBound(index)) + (1ULL << shift) - 1;
+    return static_cast<long long>(std::min<std::uint64_t>(upper, LLONG_MAX));
+}
+
+// =============== ЗАПИСЬ ===============
+
+void LatencyHistogram::record(long long value) {
+    record(value, 1);
+}
+
+void LatencyHistogram::record(long long value, long long count) {
+    if (count <= 0) return;
+    if (value < 0) value = 0;
+
+    size_t index = bucketIndex(value);
+    if (index >= counts.size()) {
+        counts.resize(index + 1, 0);
+    }
+    counts[index] += count;
+
+    totalCount += count;
+    totalSum += value * count;
+    minValue = std::min(minValue, value);
+    maxValue = std::max(maxValue, value);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.totalCount == 0) return;
+
+    if (other.precisionBits == precisionBits) {
+        if (other.counts.size() > counts.size()) {
+            counts.resize(other.counts.size(), 0);
+        }
+        for (size_t i = 0; i < other.counts.size(); i++) {
+            counts[i] += other.counts[i];
+        }
+    }
+    else {
+        // Середина корзины другой гистограммы переносится в свою корзину
+        for (size_t i = 0; i < other.counts.size(); i++) {
+            if (other.counts[i] == 0) continue;
+
+            long long middle = other.bucketLowerBound(i) +
+                (other.bucketUpperBound(i) - other.bucketLowerBound(i)) / 2;
+            size_t index = bucketIndex(middle);
+            if (index >= counts.size()) {
+                counts.resize(index + 1, 0);
+            }
+            counts[index] += other.counts[i];
+        }
+    }
+
+    totalCount += other.totalCount;
+    totalSum += other.totalSum;
+    minValue = std::min(minValue, other.minValue);
+    maxValue = std::max(maxValue, other.maxValue);
+}
+
+void LatencyHistogram::reset() {
+    counts.clear();
+    totalCount = 0;
+    totalSum = 0;
+    minValue = LLONG_MAX;
+    maxValue = 0;
+}
+
+std::vector<long long> LatencyHistogram::save() const {
+    std::vector<long long> state = { precisionBits, totalCount, totalSum, minValue, maxValue };
+    state.insert(state.end(), counts.begin(), counts.end());
+    return state;
+}
+
+bool LatencyHistogram::load(const std::vector<long long>& state) {
+    if (state.size() < 5) return false;
+    if (state[0] < MIN_PRECISION_BITS || state[0] > MAX_PRECISION_BITS) return false;
+
+    // Корзин не больше, чем нужно для LLONG_MAX при этой точности, и они
+    // в сумме дают totalCount: иначе процентили читали бы чужие данные
+    LatencyHistogram shape(static_cast<int>(state[0]));
+    size_t bucketCount = state.size() - 5;
+    if (bucketCount > shape.bucketIndex(LLONG_MAX) + 1) return false;
+
+    long long count = state[1];
+    if (count < 0) return false;
+    long long sum = 0;
+    for (size_t i = 5; i < state.size(); i++) {
+        if (state[i] < 0 || state[i] > count - sum) return false;
+        sum += state[i];
+    }
+    if (sum != count) return false;
+    if (count > 0 && (state[3] < 0 || state[3] > state[4])) return false;
+
+    precisionBits = static_cast<int>(state[0]);
+    subBucketCount = 1LL << precisionBits;
+    totalCount = state[1];
+    totalSum = state[2];
+    minValue = state[3];
+    maxValue = state[4];
+    counts.assign(state.begin() + 5, state.end());
+    return true;
+}
+
+// =============== ЗАПРОСЫ ===============
+
+double LatencyHistogram::getMean() const {
+    return totalCount > 0 ? static_cast<double>(totalSum) / totalCount : 0.0;
+}
+
+long long LatencyHistogram::getPercentile(double percentile) const {
+    if (totalCount == 0) return 0;
+
+    percentile = std::max(0.0, std::min(100.0, percentile));
+    long long target = static_cast<long long>(percentile / 100.0 * totalCount + 0.5);
+    if (target < 1) target = 1;
+
+    long long seen = 0;
+    for (size_t i = 0; i < counts.size(); i++) {
+        seen += counts[i];
+        if (seen >= target) {
+            // Верхняя граница корзины, но не больше реального максимума
+            return std::max(minValue, std::min(maxValue, bucketUpperBound(i)));
+        }
+    }
+    return maxValue;
+}
+
+size_t LatencyHistogram::getMemoryUsage() const {
+    return sizeof(*this) + counts.capacity() * sizeof(long long);
+}
+
+std::string LatencyHistogram::toString() const {
+    std::stringstream ss;
+    ss << "p50=" << getPercentile(50.0)
+        << " p90=" << getPercentile(90.0)
+        << " p99=" << getPercentile(99.0)
+        << " p99.9=" << getPercentile(99.9)
+        << " max=" << getMax();
+    return ss.str();
+}
\ No newline at end of file
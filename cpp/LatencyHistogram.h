@@ -0,0 +1,67 @@
+#pragma once
+// include/LatencyHistogram.h
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <string>
+#include <vector>
+
+// Лог-линейная гистограмма задержек (в духе HdrHistogram).
+// Значения разбиваются на степени двойки, каждая степень - на
+// 2^(precisionBits-1) равных корзин, поэтому относительная ошибка
+// не превышает 2^(1-precisionBits). Память зависит только от точности
+// и порядка максимального значения, а не от числа замеров
+class LatencyHistogram {
+public:
+    static const int DEFAULT_PRECISION_BITS = 7;   // Ошибка не более ~1.6%
+    static const int MIN_PRECISION_BITS = 1;
+    static const int MAX_PRECISION_BITS = 14;
+
+private:
+    int precisionBits;
+    long long subBucketCount;            // 2^precisionBits
+    std::vector<long long> counts;       // Растет до корзины максимального значения
+
+    long long totalCount;
+    long long totalSum;
+    long long minValue;
+    long long maxValue;
+
+    size_t bucketIndex(long long value) const;
+    long long bucketLowerBound(size_t index) const;
+    long long bucketUpperBound(size_t index) const;
+
+public:
+    explicit LatencyHistogram(int precision = DEFAULT_PRECISION_BITS);
+
+    // Запись значения (отрицательные приравниваются к нулю)
+    void record(long long value);
+    void record(long long value, long long count);
+
+    // Объединение с гистограммой другого потока или прогона.
+    // При разной точности корзины другой гистограммы перезаписываются
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    // Состояние в виде массива чисел (точность, счетчики, корзины) - для
+    // передачи между процессами. load возвращает false на поврежденных данных
+    std::vector<long long> save() const;
+    bool load(const std::vector<long long>& state);
+
+    long long getCount() const { return totalCount; }
+    long long getTotal() const { return totalSum; }
+    long long getMin() const { return totalCount > 0 ? minValue : 0; }
+    long long getMax() const { return totalCount > 0 ? maxValue : 0; }
+    double getMean() const;
+    int getPrecisionBits() const { return precisionBits; }
+
+    // Значение, не превышаемое заданной долей замеров (percentile в процентах)
+    long long getPercentile(double percentile) const;
+
+    size_t getMemoryUsage() const;
+
+    // Краткая сводка: p50/p90/p99/p99.9/max
+    std::string toString() const;
+};
+
+#endif // LATENCYHISTOGRAM_H
\ No newline at end of file
@@ -0,0 +1,236 @@
+// src/LoadGenerator.cpp
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include "DataGenerator.h"
+#include "LoadGenerator.h"
+#include "Timer.h"
+#include "TraceRecorder.h"
+
+LoadGenerator::LoadGenerator(Benchmark& loadBenchmark) : benchmark(loadBenchmark), rng(42) {
+}
+
+const char* LoadGenerator::getArrivalName(ArrivalProcess process) {
+    switch (process) {
+    case ArrivalProcess::CONSTANT: return "Constant";
+    case ArrivalProcess::POISSON: return "Poisson";
+    default: return "Unknown";
+    }
+}
+
+// =============== НАГРУЗКА ===============
+
+namespace {
+
+// Длинное ожидание отдается системе, последние SPIN_NS - активное,
+// иначе пробуждение опаздывает на квант планировщика
+const double SPIN_NS = 100000.0;
+
+Timer::Ticks waitUntil(Timer::Ticks target) {
+    Timer::Ticks now = Timer::now();
+    if (now < target && Timer::toNanoseconds(target - now) > 2 * SPIN_NS) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(
+            static_cast<long long>(Timer::toNanoseconds(target - now) - SPIN_NS)));
+        now = Timer::now();
+    }
+    while (now < target) {
+        now = Timer::now();
+    }
+    return now;
+}
+
+}
+
+void LoadGenerator::executeOperation(TreeBase* tree, std::vector<int>& present) {
+    size_t index = static_cast<size_t>(rng() % present.size());
+    if (static_cast<int>(rng() % 100) >= write_percent) {
+        tree->contains(present[index]);
+        return;
+    }
+
+    tree->remove(present[index]);
+    int key;
+    do {
+        key = static_cast<int>(rng() >> 33);
+    } while (tree->contains(key));
+    tree->insert(key);
+    present[index] = key;
+}
+
+// Замкнутый цикл с тем же учетом, что и в runPoint (отметки времени и
+// запись в гистограмму), - иначе накладные расходы генератора занижали
+// бы реальный предел и насыщение наступало раньше 100%
+double LoadGenerator::measureCapacity(TreeBase* tree, std::vector<int>& present) {
+    double limit_ns = std::max(100LL, point_ms / 4) * 1e6;
+    LatencyHistogram scratch;
+    long long operations = 0;
+
+    Timer::Ticks start = Timer::now();
+    Timer::Ticks finished = start;
+    while (Timer::toNanoseconds(finished - start) < limit_ns) {
+        Timer::Ticks begin = finished;
+        executeOperation(tree, present);
+        finished = Timer::now();
+        scratch.record(Timer::elapsedNs(begin, finished));
+        operations++;
+    }
+    return operations * 1e9 / Timer::toNanoseconds(finished - start);
+}
+
+LoadPoint LoadGenerator::runPoint(TreeBase* tree, std::vector<int>& present, double rate) {
+    TraceSpan span("LoadPoint", "run", std::string(), static_cast<long long>(rate));
+    LoadPoint point;
+    point.tree_type = tree->getType();
+    point.arrivals = arrivals;
+    point.offered_rate = rate;
+
+    // Расписание ведется в тиках таймера: steady_clock на части машин стоит
+    // сотни наносекунд и сам ограничивал бы достижимую нагрузку
+    double ticks_per_ns = 1.0 / Timer::toNanoseconds(1);
+    std::exponential_distribution<double> poisson_gap(rate / 1e9);
+    double constant_gap = 1e9 / rate;
+    auto nextGap = [&]() {
+        return (arrivals == ArrivalProcess::POISSON ? poisson_gap(rng) : constant_gap) * ticks_per_ns;
+    };
+
+    double limit = point_ms * 1e6 * ticks_per_ns;
+    double overrun = limit * MAX_OVERRUN;
+
+    Timer::Ticks start = Timer::now();
+    Timer::Ticks finished = start;
+    double intended = nextGap();
+    while (intended < limit) {
+        Timer::Ticks scheduled = start + static_cast<Timer::Ticks>(intended);
+
+        // Отставая от расписания, генератор не ждет: запрос уже в очереди
+        Timer::Ticks begin = scheduled > finished ? waitUntil(scheduled) : finished;
+        if (begin - start >= overrun) {
+            // Оставшиеся по расписанию запросы не выполняются, но учитываются
+            while (intended < limit) {
+                point.dropped++;
+                intended += nextGap();
+            }
+            break;
+        }
+
+        executeOperation(tree, present);
+        finished = Timer::now();
+
+        // Задержка отсчитывается от запланированного момента: если дерево
+        // не успевало, время в очереди входит в результат
+        point.latency.record(Timer::elapsedNs(scheduled, finished));
+        point.service.record(Timer::elapsedNs(begin, finished));
+        point.operations++;
+
+        intended += nextGap();
+    }
+
+    double elapsed_ns = Timer::toNanoseconds(finished - start);
+    point.achieved_rate = elapsed_ns > 0 ? point.operations * 1e9 / elapsed_ns : 0.0;
+    return point;
+}
+
+std::vector<LoadPoint> LoadGenerator::run(const std::vector<TreeType>& tree_types) {
+    std::vector<LoadPoint> points;
+    for (TreeType type : tree_types) {
+        std::vector<LoadPoint> part = runTree(type);
+        points.insert(points.end(), part.begin(), part.end());
+    }
+    return points;
+}
+
+std::vector<LoadPoint> LoadGenerator::runTree(TreeType type) {
+    std::vector<LoadPoint> points;
+    if (!Benchmark::keepsKeySet(type)) {
+        std::cerr << benchmark.getTreeName(type) << ": пропущено, дерево не сохраняет набор ключей" << std::endl;
+        return points;
+    }
+
+    TraceSpan span("LoadSweep", "run", benchmark.getTreeName(type), keys);
+    DataGenerator generator(42);
+    std::vector<int> present = generator.generateUnique(keys);
+
+    auto tree = benchmark.createTree(type);
+    if (!tree) return points;
+
+    tree->setOperationTiming(false);
+    for (int key : present) {
+        tree->insert(key);
+    }
+
+    double capacity = measureCapacity(tree.get(), present);
+    std::cout << benchmark.getTreeName(type) << ": " << keys << " ключей, пропускная способность "
+        << std::fixed << std::setprecision(0) << capacity << " оп/с (" << write_percent << "% замен)"
+        << std::defaultfloat << std::endl;
+
+    for (double fraction : load_fractions) {
+        LoadPoint point = runPoint(tree.get(), present, capacity * fraction);
+        point.load_fraction = fraction;
+
+        std::cout << "  " << std::setw(5) << std::fixed << std::setprecision(0) << fraction * 100.0 << "%  "
+            << std::setw(10) << point.offered_rate << " -> " << std::setw(10) << point.achieved_rate
+            << " оп/с  " << point.latency.toString();
+        if (point.dropped > 0) std::cout << "  не выполнено " << point.dropped;
+        std::cout << std::defaultfloat << std::endl;
+
+        if (point_observer) {
+            point_observer(point);
+        }
+        points.push_back(point);
+    }
+
+    return points;
+}
+
+// =============== ВЫВОД ===============
+
+void LoadGenerator::printTable(const std::vector<LoadPoint>& points) const {
+    std::cout << "\n=== ЗАДЕРЖКА ПРИ ЗАДАННОЙ НАГРУЗКЕ (мкс от запланированного момента) ===\n";
+    std::cout << std::left << std::setw(12) << "Tree" << std::setw(10) << "Arrivals" << std::right
+        << std::setw(7) << "Load%" << std::setw(12) << "Offered/s" << std::setw(12) << "Achieved/s"
+        << std::setw(10) << "p50" << std::setw(10) << "p99" << std::setw(10) << "p99.9"
+        << std::setw(12) << "max" << std::setw(12) << "svc p99" << std::setw(10) << "Dropped" << "\n";
+
+    auto us = [](long long ns) { return ns / 1000.0; };
+    for (const auto& point : points) {
+        std::cout << std::left << std::setw(12) << benchmark.getTreeName(point.tree_type)
+            << std::setw(10) << getArrivalName(point.arrivals) << std::right << std::fixed
+            << std::setprecision(0) << std::setw(7) << point.load_fraction * 100.0
+            << std::setw(12) << point.offered_rate << std::setw(12) << point.achieved_rate
+            << std::setprecision(1)
+            << std::setw(10) << us(point.latency.getPercentile(50))
+            << std::setw(10) << us(point.latency.getPercentile(99))
+            << std::setw(10) << us(point.latency.getPercentile(99.9))
+            << std::setw(12) << us(point.latency.getMax())
+            << std::setw(12) << us(point.service.getPercentile(99))
+            << std::setw(10) << point.dropped << std::defaultfloat << "\n";
+    }
+}
+
+bool LoadGenerator::saveToCSV(const std::vector<LoadPoint>& points, const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Не удалось открыть файл: " << filename << std::endl;
+        return false;
+    }
+
+    file << "TreeType;Arrivals;LoadFraction;OfferedRate;AchievedRate;Operations;Dropped;"
+        << "P50Ns;P90Ns;P99Ns;P999Ns;MaxNs;MeanNs;ServiceP50Ns;ServiceP99Ns\n";
+
+    for (const auto& point : points) {
+        file << benchmark.getTreeName(point.tree_type) << ";" << getArrivalName(point.arrivals) << ";"
+            << point.load_fraction << ";" << point.offered_rate << ";" << point.achieved_rate << ";"
+            << point.operations << ";" << point.dropped << ";"
+            << point.latency.getPercentile(50) << ";" << point.latency.getPercentile(90) << ";"
+            << point.latency.getPercentile(99) << ";" << point.latency.getPercentile(99.9) << ";"
+            << point.latency.getMax() << ";" << point.latency.getMean() << ";"
+            << point.service.getPercentile(50) << ";" << point.service.getPercentile(99) << "\n";
+    }
+
+    file.close();
+    return !file.fail();
+}
\ No newline at end of file
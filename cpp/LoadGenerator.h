@@ -0,0 +1,81 @@
+#pragma once
+// include/LoadGenerator.h
+#ifndef LOADGENERATOR_H
+#define LOADGENERATOR_H
+
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "LatencyHistogram.h"
+
+// Одна точка кривой задержка/пропускная способность
+struct LoadPoint {
+    TreeType tree_type = TreeType::UNKNOWN;
+    ArrivalProcess arrivals = ArrivalProcess::POISSON;
+    double load_fraction = 0.0;         // Доля измеренной пропускной способности
+    double offered_rate = 0.0;          // Запросов в секунду по расписанию
+    double achieved_rate = 0.0;         // Выполнено в секунду
+    long long operations = 0;
+    long long dropped = 0;              // Не выполнены до предела времени точки
+
+    // От запланированного момента до завершения: с ожиданием в очереди,
+    // без координированного пропуска (coordinated omission)
+    LatencyHistogram latency;
+    // Только выполнение операции - то, что видит замкнутый цикл
+    LatencyHistogram service;
+};
+
+// Разомкнутый генератор нагрузки: запросы поступают по расписанию
+// независимо от того, успевает ли дерево их обработать. Если операция
+// задержалась, следующие ждут в очереди, и ожидание входит в задержку.
+// Сначала замкнутым циклом измеряется пропускная способность дерева,
+// затем нагрузка проходит по долям от нее
+class LoadGenerator {
+private:
+    Benchmark& benchmark;
+
+    int keys = 100000;
+    long long point_ms = 2000;          // Длительность расписания одной точки
+    int write_percent = 20;             // Доля замен (удаление + вставка нового ключа)
+    ArrivalProcess arrivals = ArrivalProcess::POISSON;
+    std::vector<double> load_fractions = { 0.1, 0.25, 0.5, 0.7, 0.8, 0.9, 0.95, 1.0, 1.1 };
+
+    // Отставшая от расписания точка обрывается через MAX_OVERRUN длительностей
+    static constexpr double MAX_OVERRUN = 2.0;
+
+    std::mt19937_64 rng;
+
+    std::function<void(const LoadPoint&)> point_observer;
+
+    // Поиск существующего ключа или замена ключа новым - дерево остается размера keys
+    void executeOperation(TreeBase* tree, std::vector<int>& present);
+    double measureCapacity(TreeBase* tree, std::vector<int>& present);
+    LoadPoint runPoint(TreeBase* tree, std::vector<int>& present, double rate);
+
+public:
+    explicit LoadGenerator(Benchmark& benchmark);
+
+    void setKeys(int count) { keys = count < 1 ? 1 : count; }
+    void setPointMs(long long ms) { point_ms = ms < 1 ? 1 : ms; }
+    void setWritePercent(int percent) { write_percent = percent < 0 ? 0 : (percent > 100 ? 100 : percent); }
+    void setArrivalProcess(ArrivalProcess process) { arrivals = process; }
+    void setLoadFractions(const std::vector<double>& fractions) { load_fractions = fractions; }
+
+    // Вызывается после каждой точки кривой, между расписаниями
+    void setPointObserver(const std::function<void(const LoadPoint&)>& observer) {
+        point_observer = observer;
+    }
+
+    static const char* getArrivalName(ArrivalProcess process);
+
+    std::vector<LoadPoint> run(const std::vector<TreeType>& tree_types);
+    std::vector<LoadPoint> runTree(TreeType type);
+
+    void printTable(const std::vector<LoadPoint>& points) const;
+    bool saveToCSV(const std::vector<LoadPoint>& points, const std::string& filename) const;
+};
+
+#endif // LOADGENERATOR_H
\ No newline at end of file
@@ -0,0 +1,320 @@
+// src/MemoryTracker.cpp
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#if defined(__GLIBC__) || defined(_WIN32)
+#include <malloc.h>
+#define MEMORY_TRACKER_ENABLED 1
+#endif
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+#include "MemoryTracker.h"
+
+// Счетчики разнесены по слотам потоков: общие атомики на каждой аллокации
+// делили бы одну строку кэша между всеми рабочими потоками. Снимок
+// суммирует слоты. Слоты обнуляются статически и доступны до запуска
+// статических конструкторов (operator new может вызываться раньше main)
+namespace {
+
+constexpr int COUNTER_SLOTS = 64;
+
+struct alignas(64) CounterSlot {
+    std::atomic<long long> liveBytes;       // Может быть отрицательным: блок освобожден не тем потоком
+    std::atomic<long long> peakBytes;       // Максимум liveBytes слота с последнего resetPeak()
+    std::atomic<long long> allocations;
+    std::atomic<long long> deallocations;
+};
+
+CounterSlot counterSlots[COUNTER_SLOTS];
+std::atomic<int> nextSlot(0);
+thread_local int threadSlot = -1;
+
+// Потоков больше, чем слотов, - слоты делятся, счетчики остаются точными
+CounterSlot& currentSlot() {
+    if (threadSlot < 0) {
+        threadSlot = nextSlot.fetch_add(1, std::memory_order_relaxed) % COUNTER_SLOTS;
+    }
+    return counterSlots[threadSlot];
+}
+
+}
+
+// =============== MemoryTracker ===============
+
+bool MemoryTracker::isAvailable() {
+#ifdef MEMORY_TRACKER_ENABLED
+    return true;
+#else
+    return false;
+#endif
+}
+
+MemorySnapshot MemoryTracker::snapshot() {
+    MemorySnapshot snapshot;
+    for (const CounterSlot& slot : counterSlots) {
+        snapshot.liveBytes += slot.liveBytes.load(std::memory_order_relaxed);
+        snapshot.peakBytes += slot.peakBytes.load(std::memory_order_relaxed);
+        snapshot.allocations += slot.allocations.load(std::memory_order_relaxed);
+        snapshot.deallocations += slot.deallocations.load(std::memory_order_relaxed);
+    }
+    snapshot.rssBytes = readRSS();
+    return snapshot;
+}
+
+MemorySnapshot MemoryTracker::beginPhase() {
+    resetPeak();
+    return snapshot();
+}
+
+void MemoryTracker::resetPeak() {
+    for (CounterSlot& slot : counterSlots) {
+        slot.peakBytes.store(slot.liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+long long MemoryTracker::readRSS() {
+#ifdef __linux__
+    // Второе поле statm - число резидентных страниц
+    FILE* file = std::fopen("/proc/self/statm", "r");
+    if (!file) return 0;
+
+    long long totalPages = 0;
+    long long residentPages = 0;
+    int fields = std::fscanf(file, "%lld %lld", &totalPages, &residentPages);
+    std::fclose(file);
+
+    if (fields != 2) return 0;
+    return residentPages * sysconf(_SC_PAGESIZE);
+#else
+    return 0;
+#endif
+}
+
+long long MemoryTracker::readAllocatorHeld() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    return static_cast<long long>(info.arena + info.hblkhd);
+#elif defined(__GLIBC__)
+    struct mallinfo info = mallinfo();
+    return static_cast<long long>(static_cast<unsigned int>(info.arena)) +
+        static_cast<unsigned int>(info.hblkhd);
+#else
+    return 0;
+#endif
+}
+
+#ifdef MEMORY_TRACKER_ENABLED
+
+// =============== ЗАМЕНА operator new/delete ===============
+
+namespace {
+
+size_t blockSize(void* ptr) {
+#ifdef _WIN32
+    return _msize(ptr);
+#else
+    return malloc_usable_size(ptr);
+#endif
+}
+
+size_t alignedBlockSize(void* ptr, size_t alignment) {
+#ifdef _WIN32
+    return _aligned_msize(ptr, alignment, 0);
+#else
+    (void)alignment;
+    return malloc_usable_size(ptr);
+#endif
+}
+
+void onAllocate(size_t bytes) {
+    CounterSlot& slot = currentSlot();
+    slot.allocations.fetch_add(1, std::memory_order_relaxed);
+    long long live = slot.liveBytes.fetch_add(static_cast<long long>(bytes), std::memory_order_relaxed) +
+        static_cast<long long>(bytes);
+
+    long long peak = slot.peakBytes.load(std::memory_order_relaxed);
+    while (live > peak && !slot.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+}
+
+void onDeallocate(size_t bytes) {
+    CounterSlot& slot = currentSlot();
+    slot.deallocations.fetch_add(1, std::memory_order_relaxed);
+    slot.liveBytes.fetch_sub(static_cast<long long>(bytes), std::memory_order_relaxed);
+}
+
+void* rawAlignedAllocate(size_t size, size_t alignment) {
+#ifdef _WIN32
+    return _aligned_malloc(size, alignment);
+#else
+    void* ptr = nullptr;
+    return posix_memalign(&ptr, alignment, size) == 0 ? ptr : nullptr;
+#endif
+}
+
+// Стандартная семантика: при нехватке памяти вызывается new_handler,
+// без него возвращается nullptr (throwing-версии бросают bad_alloc)
+void* allocate(size_t size) {
+    if (size == 0) size = 1;
+    for (;;) {
+        void* ptr = std::malloc(size);
+        if (ptr) {
+            onAllocate(blockSize(ptr));
+            return ptr;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) return nullptr;
+        handler();
+    }
+}
+
+void* allocateAligned(size_t size, size_t alignment) {
+    if (size == 0) size = 1;
+    for (;;) {
+        void* ptr = rawAlignedAllocate(size, alignment);
+        if (ptr) {
+            onAllocate(alignedBlockSize(ptr, alignment));
+            return ptr;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) return nullptr;
+        handler();
+    }
+}
+
+void deallocate(void* ptr) {
+    if (!ptr) return;
+    onDeallocate(blockSize(ptr));
+    std::free(ptr);
+}
+
+void deallocateAligned(void* ptr, size_t alignment) {
+    if (!ptr) return;
+    onDeallocate(alignedBlockSize(ptr, alignment));
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+void* allocateOrThrow(size_t size) {
+    void* ptr = allocate(size);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* allocateAlignedOrThrow(size_t size, size_t alignment) {
+    void* ptr = allocateAligned(size, alignment);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* allocateNoThrow(size_t size) noexcept {
+    try {
+        return allocate(size);
+    }
+    catch (...) {
+        return nullptr;
+    }
+}
+
+void* allocateAlignedNoThrow(size_t size, size_t alignment) noexcept {
+    try {
+        return allocateAligned(size, alignment);
+    }
+    catch (...) {
+        return nullptr;
+    }
+}
+
+}
+
+void* operator new(size_t size) {
+    return allocateOrThrow(size);
+}
+
+void* operator new[](size_t size) {
+    return allocateOrThrow(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return allocateNoThrow(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return allocateNoThrow(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    deallocate(ptr);
+}
+
+// Выровненные версии (узлы с alignas больше стандартного выравнивания)
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    return allocateAlignedOrThrow(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    return allocateAlignedOrThrow(size, static_cast<size_t>(alignment));
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAlignedNoThrow(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAlignedNoThrow(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* ptr, std::align_val_t alignment) noexcept {
+    deallocateAligned(ptr, static_cast<size_t>(alignment));
+}
+
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept {
+    deallocateAligned(ptr, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t alignment) noexcept {
+    deallocateAligned(ptr, static_cast<size_t>(alignment));
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t alignment) noexcept {
+    deallocateAligned(ptr, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    deallocateAligned(ptr, static_cast<size_t>(alignment));
+}
+
+void operator delete[](void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    deallocateAligned(ptr, static_cast<size_t>(alignment));
+}
+
+#endif
\ No newline at end of file
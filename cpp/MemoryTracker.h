@@ -0,0 +1,39 @@
+#pragma once
+// include/MemoryTracker.h
+#ifndef MEMORYTRACKER_H
+#define MEMORYTRACKER_H
+
+// Состояние кучи процесса в момент снимка.
+// Байты считаются по фактическому размеру блока аллокатора (malloc_usable_size / _msize)
+struct MemorySnapshot {
+    long long liveBytes = 0;        // Занято сейчас
+    long long peakBytes = 0;        // Максимум с последнего resetPeak(): точный, если аллоцировал
+                                    // один поток, иначе сумма пиков потоков (оценка сверху)
+    long long allocations = 0;      // Вызовов operator new с запуска
+    long long deallocations = 0;
+    long long rssBytes = 0;         // Резидентная память процесса (0, если недоступна)
+};
+
+// Учет памяти через замену глобальных operator new/delete (MemoryTracker.cpp).
+// Поддерживается glibc и Windows CRT; на других платформах операторы
+// не заменяются и isAvailable() возвращает false
+class MemoryTracker {
+public:
+    static bool isAvailable();
+
+    static MemorySnapshot snapshot();
+
+    // Начало фазы: пик сбрасывается до текущего объема, возвращается снимок
+    static MemorySnapshot beginPhase();
+    static void resetPeak();
+
+    // Резидентная память из /proc/self/statm (только Linux)
+    static long long readRSS();
+
+    // Память, которую аллокатор держит у системы: занятые и свободные блоки
+    // арен и отдельные mmap-блоки (glibc mallinfo2). 0 - недоступно.
+    // Отношение liveBytes к этому объему показывает фрагментацию кучи
+    static long long readAllocatorHeld();
+};
+
+#endif // MEMORYTRACKER_H
\ No newline at end of file
@@ -0,0 +1,330 @@
+// src/MetricsExporter.cpp
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <system_error>
+#include <tuple>
+
+#include "MetricsExporter.h"
+
+MetricsExporter::MetricsExporter(const std::string& directory, long long intervalMs, const std::string& fileName)
+    : path((std::filesystem::path(directory) / fileName).string()),
+    interval(intervalMs > 0 ? intervalMs : 0), started(std::time(nullptr)) {
+}
+
+void MetricsExporter::setProgress(int done, int total) {
+    steps_done = done;
+    steps_total = total;
+}
+
+void MetricsExporter::update(const std::vector<BenchmarkResult>& cellResults, const Benchmark& benchmark) {
+    for (const BenchmarkResult& result : cellResults) {
+        CellMetrics cell;
+        cell.tree = benchmark.getTreeName(result.tree_type);
+        cell.operation = result.operation;
+        cell.cache_mode = Benchmark::getCacheModeName(result.cache_mode);
+        cell.data_size = result.data_size;
+        cell.run = result.run;
+        cell.ns_per_operation = result.nsPerOperation();
+        cell.total_time_ns = result.total_time_ns;
+        cell.count = result.data_size;
+        cell.p50 = result.latency.getPercentile(50.0);
+        cell.p90 = result.latency.getPercentile(90.0);
+        cell.p99 = result.latency.getPercentile(99.0);
+        cell.p999 = result.latency.getPercentile(99.9);
+        cell.max = result.latency.getMax();
+        cell.height = result.final_height;
+        cell.nodes = result.final_nodes;
+        cell.memory_bytes = result.memory_bytes;
+        cell.heap_bytes = result.heap_bytes;
+
+        cells[cellLabels(cell)] = cell;
+    }
+    cells_completed++;
+}
+
+void MetricsExporter::update(const SoakSample& sample, const Benchmark& benchmark) {
+    soak["tree=\"" + escapeLabel(benchmark.getTreeName(sample.tree_type)) + "\""] = sample;
+}
+
+void MetricsExporter::update(const LoadPoint& point, const Benchmark& benchmark) {
+    std::ostringstream labels;
+    labels << "tree=\"" << escapeLabel(benchmark.getTreeName(point.tree_type)) << "\",arrivals=\""
+        << LoadGenerator::getArrivalName(point.arrivals) << "\",load_fraction=\"" << point.load_fraction << "\"";
+    load[labels.str()] = point;
+}
+
+bool MetricsExporter::isDue() const {
+    return !published || std::chrono::steady_clock::now() - last_publish >= interval;
+}
+
+bool MetricsExporter::publishIfDue(const StatisticsCollector* statistics) {
+    return isDue() ? publish(statistics) : true;
+}
+
+bool MetricsExporter::publish(const StatisticsCollector* statistics, bool running) {
+    last_publish = std::chrono::steady_clock::now();
+    published = true;
+
+    // Временный файл - в том же каталоге, иначе переименование не атомарно
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Не удалось открыть файл: " << temporary << std::endl;
+            return false;
+        }
+        writeMetrics(file, statistics, running);
+        file.close();
+        if (file.fail()) {
+            std::cerr << "Не удалось записать файл: " << temporary << std::endl;
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::cerr << "Не удалось заменить " << path << ": " << error.message() << std::endl;
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+    return true;
+}
+
+// =============== ФОРМАТ ===============
+
+std::string MetricsExporter::escapeLabel(const std::string& value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            escaped += '\\';
+            escaped += c;
+        }
+        else if (c == '\n') {
+            escaped += "\\n";
+        }
+        else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+std::string MetricsExporter::cellLabels(const CellMetrics& cell) {
+    return "tree=\"" + escapeLabel(cell.tree) + "\",operation=\"" + escapeLabel(cell.operation) +
+        "\",cache_mode=\"" + escapeLabel(cell.cache_mode) + "\"";
+}
+
+namespace {
+
+void family(std::ostream& out, const char* name, const char* type, const char* help) {
+    out << "# HELP " << name << " " << help << "\n";
+    out << "# TYPE " << name << " " << type << "\n";
+}
+
+double seconds(long long ns) {
+    return ns / 1e9;
+}
+
+}
+
+void MetricsExporter::writeMetrics(std::ostream& out, const StatisticsCollector* statistics, bool running) const {
+    out.precision(10);
+
+    family(out, "trees_benchmark_running", "gauge", "1 while the benchmark run is in progress");
+    out << "trees_benchmark_running " << (running ? 1 : 0) << "\n";
+    family(out, "trees_benchmark_start_time_seconds", "gauge", "Unix time the run started");
+    out << "trees_benchmark_start_time_seconds " << static_cast<long long>(started) << "\n";
+    family(out, "trees_benchmark_cells_completed_total", "counter", "Completed cells (tree x repetition)");
+    out << "trees_benchmark_cells_completed_total " << cells_completed << "\n";
+    if (steps_total > 0) {
+        family(out, "trees_benchmark_steps_completed", "gauge", "Completed steps of the size grid");
+        out << "trees_benchmark_steps_completed " << steps_done << "\n";
+        family(out, "trees_benchmark_steps_total", "gauge", "Steps in the size grid");
+        out << "trees_benchmark_steps_total " << steps_total << "\n";
+    }
+
+    // Последние значения ячеек
+    if (!cells.empty()) {
+        family(out, "trees_cell_data_size", "gauge", "Keys in the last measured cell");
+        for (const auto& pair : cells) {
+            out << "trees_cell_data_size{" << pair.first << "} " << pair.second.data_size << "\n";
+        }
+        family(out, "trees_cell_run", "gauge", "Repetition index of the last measured cell");
+        for (const auto& pair : cells) {
+            out << "trees_cell_run{" << pair.first << "} " << pair.second.run << "\n";
+        }
+        family(out, "trees_cell_operations_per_second", "gauge", "Throughput of the last measured cell");
+        for (const auto& pair : cells) {
+            double ns = pair.second.ns_per_operation;
+            out << "trees_cell_operations_per_second{" << pair.first << "} " << (ns > 0 ? 1e9 / ns : 0.0) << "\n";
+        }
+        family(out, "trees_cell_latency_seconds", "summary", "Operation latency of the last measured cell");
+        for (const auto& pair : cells) {
+            const CellMetrics& cell = pair.second;
+            const std::pair<const char*, long long> quantiles[] = {
+                { "0.5", cell.p50 }, { "0.9", cell.p90 }, { "0.99", cell.p99 }, { "0.999", cell.p999 }, { "1", cell.max }
+            };
+            for (const auto& quantile : quantiles) {
+                out << "trees_cell_latency_seconds{" << pair.first << ",quantile=\"" << quantile.first << "\"} "
+                    << seconds(quantile.second) << "\n";
+            }
+            out << "trees_cell_latency_seconds_sum{" << pair.first << "} " << seconds(cell.total_time_ns) << "\n";
+            out << "trees_cell_latency_seconds_count{" << pair.first << "} " << cell.count << "\n";
+        }
+        family(out, "trees_cell_height", "gauge", "Tree height after the last measured phase");
+        for (const auto& pair : cells) {
+            out << "trees_cell_height{" << pair.first << "} " << pair.second.height << "\n";
+        }
+        family(out, "trees_cell_nodes", "gauge", "Tree nodes after the last measured phase");
+        for (const auto& pair : cells) {
+            out << "trees_cell_nodes{" << pair.first << "} " << pair.second.nodes << "\n";
+        }
+        family(out, "trees_cell_memory_bytes", "gauge", "Estimated tree size (getMemoryUsage) after the phase");
+        for (const auto& pair : cells) {
+            out << "trees_cell_memory_bytes{" << pair.first << "} " << pair.second.memory_bytes << "\n";
+        }
+        family(out, "trees_cell_heap_bytes", "gauge", "Heap freed when the tree was destroyed after the phase");
+        for (const auto& pair : cells) {
+            out << "trees_cell_heap_bytes{" << pair.first << "} " << pair.second.heap_bytes << "\n";
+        }
+    }
+
+    // Длительная нагрузка: последний замер каждого дерева
+    if (!soak.empty()) {
+        family(out, "trees_soak_elapsed_seconds", "gauge", "Soak load time of the tree, without sampling");
+        for (const auto& pair : soak) {
+            out << "trees_soak_elapsed_seconds{" << pair.first << "} " << pair.second.elapsed_ms / 1000.0 << "\n";
+        }
+        family(out, "trees_soak_operations_total", "counter", "Inserts and removes since the soak started");
+        for (const auto& pair : soak) {
+            out << "trees_soak_operations_total{" << pair.first << "} " << pair.second.operations << "\n";
+        }
+        family(out, "trees_soak_operations_per_second", "gauge", "Soak throughput over the last interval");
+        for (const auto& pair : soak) {
+            out << "trees_soak_operations_per_second{" << pair.first << "} " << pair.second.ops_per_second << "\n";
+        }
+        family(out, "trees_soak_height", "gauge", "Tree height at the last soak sample");
+        for (const auto& pair : soak) {
+            out << "trees_soak_height{" << pair.first << "} " << pair.second.height << "\n";
+        }
+        family(out, "trees_soak_heap_bytes", "gauge", "Live heap above the level before the tree was built");
+        for (const auto& pair : soak) {
+            out << "trees_soak_heap_bytes{" << pair.first << "} " << pair.second.heap_bytes << "\n";
+        }
+        family(out, "trees_soak_rss_bytes", "gauge", "Process resident memory at the last soak sample");
+        for (const auto& pair : soak) {
+            out << "trees_soak_rss_bytes{" << pair.first << "} " << pair.second.rss_bytes << "\n";
+        }
+        family(out, "trees_soak_fragmentation_ratio", "gauge", "Share of allocator-held memory not in live blocks");
+        for (const auto& pair : soak) {
+            out << "trees_soak_fragmentation_ratio{" << pair.first << "} " << pair.second.getFragmentation() << "\n";
+        }
+    }
+
+    // Разомкнутая нагрузка: точки кривой задержки
+    if (!load.empty()) {
+        family(out, "trees_load_offered_rate", "gauge", "Scheduled requests per second");
+        for (const auto& pair : load) {
+            out << "trees_load_offered_rate{" << pair.first << "} " << pair.second.offered_rate << "\n";
+        }
+        family(out, "trees_load_achieved_rate", "gauge", "Completed requests per second");
+        for (const auto& pair : load) {
+            out << "trees_load_achieved_rate{" << pair.first << "} " << pair.second.achieved_rate << "\n";
+        }
+        family(out, "trees_load_dropped_total", "counter", "Requests not executed before the point time limit");
+        for (const auto& pair : load) {
+            out << "trees_load_dropped_total{" << pair.first << "} " << pair.second.dropped << "\n";
+        }
+        family(out, "trees_load_latency_seconds", "summary", "Latency from the scheduled time, queueing included");
+        for (const auto& pair : load) {
+            const LatencyHistogram& latency = pair.second.latency;
+            const std::pair<const char*, double> quantiles[] = {
+                { "0.5", 50.0 }, { "0.9", 90.0 }, { "0.99", 99.0 }, { "0.999", 99.9 }
+            };
+            for (const auto& quantile : quantiles) {
+                out << "trees_load_latency_seconds{" << pair.first << ",quantile=\"" << quantile.first << "\"} "
+                    << seconds(latency.getPercentile(quantile.second)) << "\n";
+            }
+            out << "trees_load_latency_seconds_sum{" << pair.first << "} "
+                << latency.getMean() * latency.getCount() / 1e9 << "\n";
+            out << "trees_load_latency_seconds_count{" << pair.first << "} " << latency.getCount() << "\n";
+        }
+    }
+
+    if (!statistics) return;
+
+    // Накопленная статистика StatisticsCollector по деревьям
+    std::vector<DetailedStatistics> all = statistics->getAllStatistics();
+    std::vector<const DetailedStatistics*> active;
+    for (const DetailedStatistics& stats : all) {
+        if (stats.timeMetrics.operationCount > 0 || stats.structureMetrics.samples > 0) {
+            active.push_back(&stats);
+        }
+    }
+    if (active.empty()) return;
+
+    auto tree = [](const DetailedStatistics& stats) {
+        return "tree=\"" + escapeLabel(stats.treeName) + "\"";
+    };
+
+    family(out, "trees_statistics_operations_total", "counter", "Operations registered by StatisticsCollector");
+    for (const DetailedStatistics* stats : active) {
+        out << "trees_statistics_operations_total{" << tree(*stats) << "} " << stats->timeMetrics.operationCount << "\n";
+    }
+    family(out, "trees_statistics_comparisons_total", "counter", "Key comparisons in measured phases");
+    for (const DetailedStatistics* stats : active) {
+        out << "trees_statistics_comparisons_total{" << tree(*stats) << "} " << stats->comparisons << "\n";
+    }
+    bool has_latency = false;
+    for (const DetailedStatistics* stats : active) {
+        has_latency = has_latency || stats->insertLatency.getCount() > 0 ||
+            stats->searchLatency.getCount() > 0 || stats->deleteLatency.getCount() > 0;
+    }
+    if (has_latency) {
+        family(out, "trees_statistics_latency_seconds", "summary", "Operation latency registered by StatisticsCollector");
+    }
+    for (const DetailedStatistics* stats : active) {
+        const std::tuple<const char*, const LatencyHistogram*, long long> operations[] = {
+            std::make_tuple("insert", &stats->insertLatency, stats->timeMetrics.insertTime),
+            std::make_tuple("search", &stats->searchLatency, stats->timeMetrics.searchTime),
+            std::make_tuple("delete", &stats->deleteLatency, stats->timeMetrics.deleteTime)
+        };
+        for (const auto& operation : operations) {
+            const LatencyHistogram& latency = *std::get<1>(operation);
+            if (latency.getCount() == 0) continue;
+
+            std::string labels = tree(*stats) + ",operation=\"" + std::get<0>(operation) + "\"";
+            const std::pair<const char*, double> quantiles[] = {
+                { "0.5", 50.0 }, { "0.9", 90.0 }, { "0.99", 99.0 }, { "0.999", 99.9 }
+            };
+            for (const auto& quantile : quantiles) {
+                out << "trees_statistics_latency_seconds{" << labels << ",quantile=\"" << quantile.first << "\"} "
+                    << seconds(latency.getPercentile(quantile.second)) << "\n";
+            }
+            out << "trees_statistics_latency_seconds_sum{" << labels << "} " << seconds(std::get<2>(operation)) << "\n";
+            out << "trees_statistics_latency_seconds_count{" << labels << "} " << latency.getCount() << "\n";
+        }
+    }
+
+    family(out, "trees_structure_height", "gauge", "Maximum height over structure analyses");
+    for (const DetailedStatistics* stats : active) {
+        out << "trees_structure_height{" << tree(*stats) << "} " << stats->structureMetrics.maxHeight << "\n";
+    }
+    family(out, "trees_structure_average_depth", "gauge", "Average node depth at the last structure analysis");
+    for (const DetailedStatistics* stats : active) {
+        out << "trees_structure_average_depth{" << tree(*stats) << "} " << stats->structureMetrics.avgDepth << "\n";
+    }
+    family(out, "trees_structure_balance_factor", "gauge", "Height relative to the minimum possible height");
+    for (const DetailedStatistics* stats : active) {
+        out << "trees_structure_balance_factor{" << tree(*stats) << "} " << stats->structureMetrics.balanceFactor << "\n";
+    }
+    family(out, "trees_structure_search_comparisons", "gauge", "Expected comparisons per successful search");
+    for (const DetailedStatistics* stats : active) {
+        out << "trees_structure_search_comparisons{" << tree(*stats) << "} "
+            << stats->structureMetrics.successfulComparisons << "\n";
+    }
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+// include/MetricsExporter.h
+#ifndef METRICSEXPORTER_H
+#define METRICSEXPORTER_H
+
+#include <chrono>
+#include <ctime>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "LoadGenerator.h"
+#include "SoakTest.h"
+#include "Statistics.h"
+
+// Метрики длительного прогона в текстовом формате Prometheus для сборщика
+// textfile у node_exporter. Хранит последние значения каждой ячейки
+// (дерево x операция x режим кэша) и по требованию переписывает файл
+// целиком: запись во временный файл рядом и переименование поверх старого,
+// так что сборщик не видит недописанный файл. Запись делается на границах
+// ячеек не чаще раза в interval - между ячейками рабочие потоки не пишут
+// в StatisticsCollector и его можно свести. Длительная и разомкнутая
+// нагрузка вместо ячеек передают замеры интервалов и точки кривой
+class MetricsExporter {
+private:
+    // Последние значения ячейки
+    struct CellMetrics {
+        std::string tree;
+        std::string operation;
+        std::string cache_mode;
+        int data_size = 0;
+        int run = 0;
+        double ns_per_operation = 0.0;
+        long long total_time_ns = 0;
+        long long count = 0;            // Операций фазы (total_time_ns - их общее время)
+        long long p50 = 0;
+        long long p90 = 0;
+        long long p99 = 0;
+        long long p999 = 0;
+        long long max = 0;
+        int height = 0;
+        int nodes = 0;
+        long long memory_bytes = 0;
+        long long heap_bytes = 0;
+    };
+
+    std::string path;
+    std::chrono::milliseconds interval;
+    std::chrono::steady_clock::time_point last_publish;
+    bool published = false;
+    std::time_t started;
+
+    std::map<std::string, CellMetrics> cells;   // Ключ - метки ячейки
+    std::map<std::string, SoakSample> soak;     // Последний замер дерева, ключ - метки
+    std::map<std::string, LoadPoint> load;      // Ключ - метки дерева и доли нагрузки
+    long long cells_completed = 0;
+    int steps_done = 0;
+    int steps_total = 0;
+
+    static std::string escapeLabel(const std::string& value);
+    static std::string cellLabels(const CellMetrics& cell);
+    void writeMetrics(std::ostream& out, const StatisticsCollector* statistics, bool running) const;
+
+public:
+    static constexpr const char* DEFAULT_FILE_NAME = "trees.prom";
+
+    // Файл directory/fileName; сборщик читает только файлы *.prom
+    MetricsExporter(const std::string& directory, long long intervalMs,
+        const std::string& fileName = DEFAULT_FILE_NAME);
+
+    const std::string& getPath() const { return path; }
+
+    // Шаги сетки размеров прогона
+    void setProgress(int done, int total);
+
+    // Результаты завершенной ячейки
+    void update(const std::vector<BenchmarkResult>& cellResults, const Benchmark& benchmark);
+
+    // Замер интервала длительной нагрузки и точка кривой разомкнутой
+    void update(const SoakSample& sample, const Benchmark& benchmark);
+    void update(const LoadPoint& point, const Benchmark& benchmark);
+
+    // Прошло ли interval с последней записи
+    bool isDue() const;
+
+    // Перезаписывает файл. running == false - прогон завершен.
+    // statistics == nullptr - без метрик StatisticsCollector
+    bool publish(const StatisticsCollector* statistics, bool running = true);
+    bool publishIfDue(const StatisticsCollector* statistics);
+};
+
+#endif // METRICSEXPORTER_H
\ No newline at end of file
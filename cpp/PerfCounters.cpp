@@ -0,0 +1,210 @@
+// src/PerfCounters.cpp
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "PerfCounters.h"
+
+// =============== PerfSample ===============
+
+bool PerfSample::hasAny() const {
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        if (valid[i]) return true;
+    }
+    return false;
+}
+
+double PerfSample::perOperation(Counter counter, long long operations) const {
+    if (!valid[counter] || operations <= 0) return -1.0;
+    return static_cast<double>(values[counter]) / operations;
+}
+
+double PerfSample::getIPC() const {
+    if (!valid[CYCLES] || !valid[INSTRUCTIONS] || values[CYCLES] == 0) return -1.0;
+    return static_cast<double>(values[INSTRUCTIONS]) / values[CYCLES];
+}
+
+const char* PerfSample::getCounterName(Counter counter) {
+    switch (counter) {
+    case CYCLES: return "Cycles";
+    case INSTRUCTIONS: return "Instructions";
+    case L1D_MISSES: return "L1dMisses";
+    case LLC_MISSES: return "LLCMisses";
+    case DTLB_MISSES: return "DTLBMisses";
+    case BRANCH_MISSES: return "BranchMisses";
+    default: return "Unknown";
+    }
+}
+
+// =============== PerfCounters ===============
+
+PerfCounters::PerfCounters() : running(false) {
+    for (int i = 0; i < PerfSample::COUNTER_COUNT; i++) {
+        descriptors[i] = -1;
+    }
+    open();
+}
+
+PerfCounters::~PerfCounters() {
+    close();
+}
+
+void PerfCounters::reopen() {
+    close();
+    open();
+    running = false;
+}
+
+#ifdef __linux__
+
+namespace {
+
+// Кэш-события кодируются как id | (операция << 8) | (результат << 16)
+unsigned long long cacheEvent(unsigned long long cache) {
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+int openEvent(unsigned int type, unsigned long long config) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // Время работы нужно для поправки на мультиплексирование счетчиков
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    // Текущий поток, любой процессор
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+}
+
+void PerfCounters::open() {
+    descriptors[PerfSample::CYCLES] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    descriptors[PerfSample::INSTRUCTIONS] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    descriptors[PerfSample::L1D_MISSES] = openEvent(PERF_TYPE_HW_CACHE, cacheEvent(PERF_COUNT_HW_CACHE_L1D));
+    descriptors[PerfSample::LLC_MISSES] = openEvent(PERF_TYPE_HW_CACHE, cacheEvent(PERF_COUNT_HW_CACHE_LL));
+    descriptors[PerfSample::DTLB_MISSES] = openEvent(PERF_TYPE_HW_CACHE, cacheEvent(PERF_COUNT_HW_CACHE_DTLB));
+    descriptors[PerfSample::BRANCH_MISSES] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+}
+
+void PerfCounters::close() {
+    for (int i = 0; i < PerfSample::COUNTER_COUNT; i++) {
+        if (descriptors[i] >= 0) {
+            ::close(descriptors[i]);
+            descriptors[i] = -1;
+        }
+    }
+}
+
+void PerfCounters::start() {
+    for (int i = 0; i < PerfSample::COUNTER_COUNT; i++) {
+        if (descriptors[i] < 0) continue;
+        ioctl(descriptors[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(descriptors[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+    running = true;
+}
+
+PerfSample PerfCounters::stop() {
+    PerfSample sample;
+    if (!running) return sample;
+
+    for (int i = 0; i < PerfSample::COUNTER_COUNT; i++) {
+        if (descriptors[i] >= 0) {
+            ioctl(descriptors[i], PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+    running = false;
+
+    for (int i = 0; i < PerfSample::COUNTER_COUNT; i++) {
+        if (descriptors[i] < 0) continue;
+
+        // value, time_enabled, time_running
+        unsigned long long data[3] = {};
+        if (read(descriptors[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) continue;
+        if (data[2] == 0) continue;   // Счетчик так и не попал на PMU
+
+        double scale = data[2] < data[1] ? static_cast<double>(data[1]) / data[2] : 1.0;
+        sample.values[i] = static_cast<long long>(data[0] * scale);
+        sample.valid[i] = true;
+    }
+
+    return sample;
+}
+
+void PerfCounters::pause() {
+    if (!running) return;
+    for (int i = 0; i < PerfSample::COUNTER_COUNT; i++) {
+        if (descriptors[i] >= 0) {
+            ioctl(descriptors[i], PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+}
+
+void PerfCounters::resume() {
+    if (!running) return;
+    for (int i = 0; i < PerfSample::COUNTER_COUNT; i++) {
+        if (descriptors[i] >= 0) {
+            ioctl(descriptors[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+#else
+
+void PerfCounters::open() {
+}
+
+void PerfCounters::close() {
+}
+
+void PerfCounters::start() {
+    running = true;
+}
+
+PerfSample PerfCounters::stop() {
+    running = false;
+    return PerfSample();
+}
+
+void PerfCounters::pause() {
+}
+
+void PerfCounters::resume() {
+}
+
+#endif
+
+bool PerfCounters::isAvailable() const {
+    for (int i = 0; i < PerfSample::COUNTER_COUNT; i++) {
+        if (descriptors[i] >= 0) return true;
+    }
+    return false;
+}
+
+std::string PerfCounters::getStatus() const {
+#ifdef __linux__
+    if (isAvailable()) {
+        std::string status = "Доступные счетчики:";
+        for (int i = 0; i < PerfSample::COUNTER_COUNT; i++) {
+            if (descriptors[i] >= 0) {
+                status += std::string(" ") + PerfSample::getCounterName(static_cast<PerfSample::Counter>(i));
+            }
+        }
+        return status;
+    }
+    return "Аппаратные счетчики недоступны (perf_event_open запрещен, "
+        "проверьте /proc/sys/kernel/perf_event_paranoid)";
+#else
+    return "Аппаратные счетчики поддерживаются только в Linux";
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+// include/PerfCounters.h
+#ifndef PERFCOUNTERS_H
+#define PERFCOUNTERS_H
+
+#include <string>
+
+// Показания аппаратных счетчиков за один замер
+struct PerfSample {
+    enum Counter {
+        CYCLES = 0,
+        INSTRUCTIONS,
+        L1D_MISSES,
+        LLC_MISSES,
+        DTLB_MISSES,
+        BRANCH_MISSES,
+        COUNTER_COUNT
+    };
+
+    long long values[COUNTER_COUNT] = {};
+    bool valid[COUNTER_COUNT] = {};     // Счетчик удалось открыть и прочитать
+
+    bool isValid(Counter counter) const { return valid[counter]; }
+    bool hasAny() const;
+
+    // Значение в пересчете на одну операцию (-1, если счетчик недоступен)
+    double perOperation(Counter counter, long long operations) const;
+    double getIPC() const;
+
+    static const char* getCounterName(Counter counter);
+};
+
+// Аппаратные счетчики текущего потока через perf_event_open (только Linux).
+// В контейнерах и на других ОС счетчики обычно недоступны - тогда
+// isAvailable() возвращает false, а stop() возвращает пустой замер
+class PerfCounters {
+private:
+    int descriptors[PerfSample::COUNTER_COUNT];
+    bool running;
+
+    void open();
+    void close();
+
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool isAvailable() const;
+
+    // Причина недоступности (для вывода пользователю)
+    std::string getStatus() const;
+
+    void start();
+    PerfSample stop();
+
+    // Приостановка без сброса: работа между pause и resume не считается
+    void pause();
+    void resume();
+
+    // Открыть счетчики заново для текущего потока. Нужно после fork:
+    // унаследованные дескрипторы считают поток родительского процесса
+    void reopen();
+};
+
+#endif // PERFCOUNTERS_H
\ No newline at end of file
@@ -0,0 +1,106 @@
+// src/PhaseProfiler.cpp
+#include "PhaseProfiler.h"
+
+long long PhaseSample::getTotalNs() const {
+    long long total = 0;
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        total += ns[i];
+    }
+    return total;
+}
+
+double PhaseSample::perOperation(Phase phase) const {
+    if (!valid || getOperations() <= 0) return -1.0;
+    return static_cast<double>(ns[phase]) / getOperations();
+}
+
+double PhaseSample::getShare(Phase phase) const {
+    long long total = getTotalNs();
+    return total > 0 ? 100.0 * ns[phase] / total : 0.0;
+}
+
+void PhaseSample::add(const PhaseSample& other) {
+    if (!other.valid) return;
+    valid = true;
+    for (int i = 0; i < PHASE_COUNT; i++) {
+        ns[i] += other.ns[i];
+        entries[i] += other.entries[i];
+    }
+}
+
+const char* PhaseSample::getPhaseName(Phase phase) {
+    switch (phase) {
+    case DESCENT: return "Descent";
+    case REBALANCE: return "Rebalance";
+    case ALLOCATION: return "Allocation";
+    default: return "Unknown";
+    }
+}
+
+// =============== СТЕК ФАЗ ПОТОКА ===============
+
+namespace {
+
+struct PhaseState {
+    // Глубже фазы не вкладываются (спуск -> балансировка -> выделение);
+    // лишние уровни только считаются, чтобы leave оставался парным
+    static constexpr int MAX_DEPTH = 32;
+
+    PhaseSample::Phase stack[MAX_DEPTH];
+    int depth = 0;
+    int overflow = 0;
+    Timer::Ticks mark = 0;
+
+    Timer::Ticks ticks[PhaseSample::PHASE_COUNT] = {};
+    long long entries[PhaseSample::PHASE_COUNT] = {};
+};
+
+thread_local PhaseState state;
+
+}
+
+void PhaseProfiler::enter(PhaseSample::Phase phase) {
+    if (state.depth == PhaseState::MAX_DEPTH) {
+        state.overflow++;
+        return;
+    }
+
+    Timer::Ticks now = Timer::now();
+    if (state.depth > 0) {
+        state.ticks[state.stack[state.depth - 1]] += now - state.mark;
+    }
+    state.stack[state.depth++] = phase;
+    state.entries[phase]++;
+    state.mark = now;
+}
+
+void PhaseProfiler::leave() {
+    if (state.overflow > 0) {
+        state.overflow--;
+        return;
+    }
+    if (state.depth == 0) return;
+
+    Timer::Ticks now = Timer::now();
+    state.ticks[state.stack[--state.depth]] += now - state.mark;
+    state.mark = now;
+}
+
+void PhaseProfiler::start() {
+    for (int i = 0; i < PhaseSample::PHASE_COUNT; i++) {
+        state.ticks[i] = 0;
+        state.entries[i] = 0;
+    }
+}
+
+PhaseSample PhaseProfiler::stop() {
+    PhaseSample sample;
+    if (!ENABLED) return sample;
+
+    sample.valid = true;
+    for (int i = 0; i < PhaseSample::PHASE_COUNT; i++) {
+        sample.ns[i] = static_cast<long long>(Timer::toNanoseconds(state.ticks[i]) + 0.5);
+        sample.entries[i] = state.entries[i];
+    }
+    return sample;
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+#pragma once
+// include/PhaseProfiler.h
+#ifndef PHASEPROFILER_H
+#define PHASEPROFILER_H
+
+#include "Timer.h"
+
+// Замер фаз включается при сборке (cmake -DENABLE_PHASE_PROFILING=ON).
+// Без него TREE_PHASE раскрывается в пустой оператор и ничего не стоит
+#ifndef TREES_PHASE_PROFILING
+#define TREES_PHASE_PROFILING 0
+#endif
+
+// Время операций дерева по фазам за один замер
+struct PhaseSample {
+    enum Phase {
+        DESCENT = 0,    // Спуск и подъем по пути: сравнения, переходы, обновление полей
+        REBALANCE,      // Повороты, skew/split, слияния и заимствования
+        ALLOCATION,     // new и delete узлов
+        PHASE_COUNT
+    };
+
+    bool valid = false;                     // Профилировщик собран и замер выполнялся
+    long long ns[PHASE_COUNT] = {};         // Собственное время фазы, без вложенных
+    long long entries[PHASE_COUNT] = {};    // Входов в фазу
+
+    // Каждая операция дерева - ровно один вход в DESCENT
+    long long getOperations() const { return entries[DESCENT]; }
+    long long getTotalNs() const;
+    double perOperation(Phase phase) const; // нс на операцию (-1 - нет замера)
+    double getShare(Phase phase) const;     // Доля фазы во времени всех фаз, %
+
+    void add(const PhaseSample& other);
+
+    static const char* getPhaseName(Phase phase);
+};
+
+// Профилировщик фаз текущего потока. Активные фазы образуют стек, и время
+// всегда идет самой внутренней из них: поворот внутри спуска вычитается из
+// спуска. Время вне всех фаз (вызов через TreeBase, замер операции) не
+// учитывается. Снимается вокруг однопоточных фаз теста, как PerfCounters
+class PhaseProfiler {
+public:
+    static constexpr bool ENABLED = TREES_PHASE_PROFILING != 0;
+
+    static void enter(PhaseSample::Phase phase);
+    static void leave();
+
+    // Обнуляет накопленное потоком время; stop возвращает его с начала start
+    static void start();
+    static PhaseSample stop();
+};
+
+class PhaseScope {
+public:
+    explicit PhaseScope(PhaseSample::Phase phase) { PhaseProfiler::enter(phase); }
+    ~PhaseScope() { PhaseProfiler::leave(); }
+
+    PhaseScope(const PhaseScope&) = delete;
+    PhaseScope& operator=(const PhaseScope&) = delete;
+};
+
+#define TREE_PHASE_CONCAT_INNER(a, b) a##b
+#define TREE_PHASE_CONCAT(a, b) TREE_PHASE_CONCAT_INNER(a, b)
+
+// Фаза до конца текущего блока: TREE_PHASE(REBALANCE);
+#if TREES_PHASE_PROFILING
+#define TREE_PHASE(phase) PhaseScope TREE_PHASE_CONCAT(phaseScope, __LINE__)(PhaseSample::phase)
+#else
+#define TREE_PHASE(phase) ((void)0)
+#endif
+
+#endif // PHASEPROFILER_H
\ No newline at end of file
@@ -0,0 +1,280 @@
+// src/RegressionChecker.cpp
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <tuple>
+
+#include "RegressionChecker.h"
+
+// =============== CellKey ===============
+
+bool CellKey::operator<(const CellKey& other) const {
+    return std::tie(tree, operation, dataSize, order, threads, cacheMode) <
+        std::tie(other.tree, other.operation, other.dataSize, other.order, other.threads, other.cacheMode);
+}
+
+const char* CellComparison::getVerdictName(Verdict verdict) {
+    switch (verdict) {
+    case UNCHANGED: return "OK";
+    case REGRESSION: return "REGRESSION";
+    case IMPROVEMENT: return "IMPROVEMENT";
+    case MISSING_BASELINE: return "NEW";
+    case MISSING_CURRENT: return "MISSING";
+    case INCONCLUSIVE: return "INCONCLUSIVE";
+    default: return "Unknown";
+    }
+}
+
+// =============== ЗАГРУЗКА ===============
+
+RegressionChecker::RegressionChecker(double threshold, double significance)
+    : thresholdPercent(threshold), alpha(significance) {
+}
+
+namespace {
+
+std::vector<std::string> splitLine(const std::string& line, char separator) {
+    std::vector<std::string> fields;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, separator)) {
+        if (!field.empty() && field.back() == '\r') field.pop_back();
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+}
+
+bool RegressionChecker::loadCSV(const std::string& filename, std::map<CellKey, std::vector<double>>& cells) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Не удалось открыть файл результатов: " << filename << std::endl;
+        return false;
+    }
+
+    std::string line;
+    if (!std::getline(file, line)) {
+        std::cerr << "Пустой файл результатов: " << filename << std::endl;
+        return false;
+    }
+
+    // Колонки ищутся по имени: в старых файлах части колонок нет
+    std::map<std::string, size_t> columns;
+    std::vector<std::string> header = splitLine(line, ';');
+    for (size_t i = 0; i < header.size(); i++) {
+        columns[header[i]] = i;
+    }
+
+    const char* required[] = { "TreeType", "Operation", "DataSize", "TotalTimeNs" };
+    for (const char* column : required) {
+        if (columns.find(column) == columns.end()) {
+            std::cerr << filename << ": нет колонки " << column << std::endl;
+            return false;
+        }
+    }
+
+    auto field = [&](const std::vector<std::string>& fields, const char* name) -> std::string {
+        auto it = columns.find(name);
+        return it != columns.end() && it->second < fields.size() ? fields[it->second] : "";
+    };
+
+    size_t rows = 0;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '\r') continue;
+        std::vector<std::string> fields = splitLine(line, ';');
+
+        CellKey key;
+        key.tree = field(fields, "TreeType");
+        key.operation = field(fields, "Operation");
+        key.dataSize = std::atoi(field(fields, "DataSize").c_str());
+        // До появления колонки DataOrder меню запускало тесты на случайных данных
+        key.order = field(fields, "DataOrder");
+        if (key.order.empty()) key.order = "Random";
+        std::string threads = field(fields, "Threads");
+        key.threads = threads.empty() ? 1 : std::atoi(threads.c_str());
+        std::string cacheMode = field(fields, "CacheMode");
+        if (!cacheMode.empty()) key.cacheMode = cacheMode;
+
+        double nsPerOperation;
+        std::string perOperation = field(fields, "NsPerOp");
+        if (!perOperation.empty()) {
+            nsPerOperation = std::atof(perOperation.c_str());
+        }
+        else {
+            if (key.dataSize <= 0) continue;
+            nsPerOperation = std::atof(field(fields, "TotalTimeNs").c_str()) / key.dataSize;
+        }
+
+        if (nsPerOperation > 0) {
+            cells[key].push_back(nsPerOperation);
+            rows++;
+        }
+    }
+
+    if (rows == 0) {
+        std::cerr << filename << ": нет строк с результатами" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool RegressionChecker::loadBaseline(const std::string& filename) {
+    return loadCSV(filename, baseline);
+}
+
+bool RegressionChecker::loadCurrent(const std::string& filename) {
+    return loadCSV(filename, current);
+}
+
+void RegressionChecker::addCurrent(const CellKey& key, double nsPerOperation) {
+    if (nsPerOperation > 0) {
+        current[key].push_back(nsPerOperation);
+    }
+}
+
+// =============== СРАВНЕНИЕ ===============
+
+std::vector<CellComparison> RegressionChecker::compare() const {
+    std::vector<CellComparison> comparisons;
+
+    for (const auto& cell : current) {
+        CellComparison comparison;
+        comparison.key = cell.first;
+        comparison.current = SampleStatistics::summarize(cell.second);
+
+        auto base = baseline.find(cell.first);
+        if (base == baseline.end()) {
+            comparison.verdict = CellComparison::MISSING_BASELINE;
+            comparisons.push_back(comparison);
+            continue;
+        }
+        comparison.baseline = SampleStatistics::summarize(base->second);
+
+        if (comparison.baseline.median > 0) {
+            comparison.changePercent = (comparison.current.median / comparison.baseline.median - 1.0) * 100.0;
+        }
+
+        // Время положительно и скошено вправо: тест по логарифмам сравнивает
+        // геометрические средние, то есть относительное изменение
+        std::vector<double> logBase, logCurrent;
+        for (double value : base->second) logBase.push_back(std::log(value));
+        for (double value : cell.second) logCurrent.push_back(std::log(value));
+        comparison.pValue = SampleStatistics::welchTTest(logBase, logCurrent);
+
+        bool exceeds = std::abs(comparison.changePercent) > thresholdPercent;
+        if (exceeds && comparison.pValue < 0) {
+            comparison.verdict = CellComparison::INCONCLUSIVE;
+        }
+        else if (exceeds && comparison.pValue < alpha) {
+            comparison.verdict = comparison.changePercent > 0 ?
+                CellComparison::REGRESSION : CellComparison::IMPROVEMENT;
+        }
+        comparisons.push_back(comparison);
+    }
+
+    for (const auto& cell : baseline) {
+        if (current.find(cell.first) != current.end()) continue;
+
+        CellComparison comparison;
+        comparison.key = cell.first;
+        comparison.baseline = SampleStatistics::summarize(cell.second);
+        comparison.verdict = CellComparison::MISSING_CURRENT;
+        comparisons.push_back(comparison);
+    }
+
+    return comparisons;
+}
+
+bool RegressionChecker::hasRegression(const std::vector<CellComparison>& comparisons) {
+    for (const auto& comparison : comparisons) {
+        if (comparison.verdict == CellComparison::REGRESSION) return true;
+    }
+    return false;
+}
+
+// =============== ВЫВОД ===============
+
+void RegressionChecker::printTable(const std::vector<CellComparison>& comparisons) const {
+    std::cout << "\n=== СРАВНЕНИЕ С БАЗОВЫМ ПРОГОНОМ ===\n";
+    std::cout << "Порог: " << thresholdPercent << "%, уровень значимости: " << alpha << "\n\n";
+
+    std::cout << std::left
+        << std::setw(11) << "Tree" << std::setw(20) << "Operation" << std::setw(9) << "Size"
+        << std::setw(22) << "Order" << std::setw(8) << "Threads"
+        << std::right
+        << std::setw(12) << "Base ns/op" << std::setw(12) << "Now ns/op"
+        << std::setw(10) << "Change" << std::setw(9) << "p" << "  Verdict\n";
+
+    int regressions = 0;
+    int improvements = 0;
+    int inconclusive = 0;
+    for (const auto& comparison : comparisons) {
+        const CellKey& key = comparison.key;
+        std::string operation = key.operation;
+        if (key.cacheMode != "Warm") operation += "/" + key.cacheMode;
+        std::cout << std::left
+            << std::setw(11) << key.tree << std::setw(20) << operation << std::setw(9) << key.dataSize
+            << std::setw(22) << key.order << std::setw(8) << key.threads
+            << std::right << std::fixed << std::setprecision(1);
+
+        if (comparison.baseline.count > 0) std::cout << std::setw(12) << comparison.baseline.median;
+        else std::cout << std::setw(12) << "-";
+        if (comparison.current.count > 0) std::cout << std::setw(12) << comparison.current.median;
+        else std::cout << std::setw(12) << "-";
+
+        if (comparison.baseline.count > 0 && comparison.current.count > 0) {
+            std::ostringstream change;
+            change << std::showpos << std::fixed << std::setprecision(1) << comparison.changePercent << "%";
+            std::cout << std::setw(10) << change.str();
+        }
+        else {
+            std::cout << std::setw(10) << "-";
+        }
+
+        if (comparison.pValue >= 0) std::cout << std::setw(9) << std::setprecision(4) << comparison.pValue;
+        else std::cout << std::setw(9) << "-";
+
+        std::cout << "  " << CellComparison::getVerdictName(comparison.verdict) << "\n";
+
+        if (comparison.verdict == CellComparison::REGRESSION) regressions++;
+        if (comparison.verdict == CellComparison::IMPROVEMENT) improvements++;
+        if (comparison.verdict == CellComparison::INCONCLUSIVE) inconclusive++;
+    }
+
+    std::cout << "\nЯчеек: " << comparisons.size() << ", регрессий: " << regressions
+        << ", улучшений: " << improvements << "\n";
+    if (inconclusive > 0) {
+        std::cout << "Без проверки значимости (повторов меньше двух): " << inconclusive
+            << " - нужно больше повторов (min_runs)\n";
+    }
+}
+
+bool RegressionChecker::saveToCSV(const std::vector<CellComparison>& comparisons, const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Не удалось открыть файл: " << filename << std::endl;
+        return false;
+    }
+
+    file << "TreeType;Operation;DataSize;DataOrder;Threads;CacheMode;"
+        << "BaseRuns;BaseMedianNs;BaseMadNs;CurrentRuns;CurrentMedianNs;CurrentMadNs;"
+        << "ChangePercent;PValue;Verdict\n";
+
+    for (const auto& comparison : comparisons) {
+        const CellKey& key = comparison.key;
+        file << key.tree << ";" << key.operation << ";" << key.dataSize << ";"
+            << key.order << ";" << key.threads << ";" << key.cacheMode << ";"
+            << comparison.baseline.count << ";" << comparison.baseline.median << ";" << comparison.baseline.mad << ";"
+            << comparison.current.count << ";" << comparison.current.median << ";" << comparison.current.mad << ";"
+            << comparison.changePercent << ";";
+        if (comparison.pValue >= 0) file << comparison.pValue;
+        file << ";" << CellComparison::getVerdictName(comparison.verdict) << "\n";
+    }
+
+    file.close();
+    return !file.fail();
+}
\ No newline at end of file
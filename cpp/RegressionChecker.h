@@ -0,0 +1,72 @@
+#pragma once
+// include/RegressionChecker.h
+#ifndef REGRESSIONCHECKER_H
+#define REGRESSIONCHECKER_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "SampleStatistics.h"
+
+// Ячейка сравнения: дерево x операция x размер x порядок данных x потоки x режим кэша
+struct CellKey {
+    std::string tree;
+    std::string operation;
+    int dataSize = 0;
+    std::string order;
+    int threads = 1;
+    std::string cacheMode = "Warm";
+
+    bool operator<(const CellKey& other) const;
+};
+
+struct CellComparison {
+    enum Verdict {
+        UNCHANGED,
+        REGRESSION,
+        IMPROVEMENT,
+        MISSING_BASELINE,   // Ячейки нет в базовом файле
+        MISSING_CURRENT,    // Ячейка есть только в базовом файле
+        INCONCLUSIVE        // Изменение больше порога, но значимость не проверить (повторов меньше двух)
+    };
+
+    CellKey key;
+    SampleSummary baseline;     // нс на операцию по повторам
+    SampleSummary current;
+    double changePercent = 0.0; // По медианам, > 0 - медленнее
+    double pValue = -1.0;       // t-тест Уэлча по логарифмам; -1 - повторов меньше двух
+    Verdict verdict = UNCHANGED;
+
+    static const char* getVerdictName(Verdict verdict);
+};
+
+// Сравнение текущего прогона с сохраненным (формат Benchmark::saveResultsToCSV).
+// Регрессия - медиана выросла больше чем на порог и различие значимо
+// (p < alpha). Если в ячейке один повтор, значимость не проверить: изменение
+// больше порога отмечается как INCONCLUSIVE и регрессией не считается
+class RegressionChecker {
+private:
+    double thresholdPercent;
+    double alpha;
+
+    std::map<CellKey, std::vector<double>> baseline;
+    std::map<CellKey, std::vector<double>> current;
+
+    static bool loadCSV(const std::string& filename, std::map<CellKey, std::vector<double>>& cells);
+
+public:
+    explicit RegressionChecker(double threshold = 5.0, double significance = 0.05);
+
+    bool loadBaseline(const std::string& filename);
+    bool loadCurrent(const std::string& filename);
+    void addCurrent(const CellKey& key, double nsPerOperation);
+
+    std::vector<CellComparison> compare() const;
+
+    static bool hasRegression(const std::vector<CellComparison>& comparisons);
+    void printTable(const std::vector<CellComparison>& comparisons) const;
+    static bool saveToCSV(const std::vector<CellComparison>& comparisons, const std::string& filename);
+};
+
+#endif // REGRESSIONCHECKER_H
\ No newline at end of file
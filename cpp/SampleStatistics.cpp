@@ -0,0 +1,196 @@
+// src/SampleStatistics.cpp
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+#include "SampleStatistics.h"
+
+// =============== SampleSummary ===============
+
+double SampleSummary::getRelativeCIHalfWidth() const {
+    if (count < 2 || mean <= 0.0) return -1.0;
+    return (ciHigh - ciLow) / 2.0 / mean * 100.0;
+}
+
+std::string SampleSummary::toString() const {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(1)
+        << "медиана=" << median
+        << " MAD=" << mad
+        << " мин=" << min
+        << " p95=" << p95;
+    if (count >= 2) {
+        ss << " ДИ=[" << ciLow << "; " << ciHigh << "]";
+    }
+    return ss.str();
+}
+
+// =============== SampleStatistics ===============
+
+double SampleStatistics::percentile(const std::vector<double>& sorted, double percentile) {
+    if (sorted.empty()) return 0.0;
+
+    percentile = std::max(0.0, std::min(100.0, percentile));
+    double position = percentile / 100.0 * (sorted.size() - 1);
+    size_t lower = static_cast<size_t>(position);
+    size_t upper = std::min(lower + 1, sorted.size() - 1);
+    double fraction = position - lower;
+    return sorted[lower] + (sorted[upper] - sorted[lower]) * fraction;
+}
+
+double SampleStatistics::studentT95(size_t degreesOfFreedom) {
+    static const double table[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    const size_t tableSize = sizeof(table) / sizeof(table[0]);
+
+    if (degreesOfFreedom == 0) return 0.0;
+    if (degreesOfFreedom <= tableSize) return table[degreesOfFreedom - 1];
+    if (degreesOfFreedom <= 60) return 2.000;
+    if (degreesOfFreedom <= 120) return 1.980;
+    return 1.960;
+}
+
+namespace {
+
+// Цепная дробь для неполной бета-функции (метод Лентца)
+double betaContinuedFraction(double x, double a, double b) {
+    const int MAX_ITERATIONS = 200;
+    const double EPSILON = 1e-12;
+    const double TINY = 1e-300;
+
+    double qab = a + b;
+    double qap = a + 1.0;
+    double qam = a - 1.0;
+    double c = 1.0;
+    double d = 1.0 - qab * x / qap;
+    if (std::fabs(d) < TINY) d = TINY;
+    d = 1.0 / d;
+    double h = d;
+
+    for (int m = 1; m <= MAX_ITERATIONS; m++) {
+        int m2 = 2 * m;
+        double aa = m * (b - m) * x / ((qam + m2) * (a + m2));
+        d = 1.0 + aa * d;
+        if (std::fabs(d) < TINY) d = TINY;
+        c = 1.0 + aa / c;
+        if (std::fabs(c) < TINY) c = TINY;
+        d = 1.0 / d;
+        h *= d * c;
+
+        aa = -(a + m) * (qab + m) * x / ((a + m2) * (qap + m2));
+        d = 1.0 + aa * d;
+        if (std::fabs(d) < TINY) d = TINY;
+        c = 1.0 + aa / c;
+        if (std::fabs(c) < TINY) c = TINY;
+        d = 1.0 / d;
+        double delta = d * c;
+        h *= delta;
+        if (std::fabs(delta - 1.0) < EPSILON) break;
+    }
+    return h;
+}
+
+void meanAndVariance(const std::vector<double>& values, double& mean, double& variance) {
+    mean = 0.0;
+    for (double value : values) {
+        mean += value;
+    }
+    mean /= values.size();
+
+    variance = 0.0;
+    for (double value : values) {
+        variance += (value - mean) * (value - mean);
+    }
+    variance /= values.size() - 1;
+}
+
+}
+
+double SampleStatistics::incompleteBeta(double x, double a, double b) {
+    if (x <= 0.0) return 0.0;
+    if (x >= 1.0) return 1.0;
+
+    double front = std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) +
+        a * std::log(x) + b * std::log(1.0 - x));
+
+    // Дробь сходится быстро при x < (a + 1) / (a + b + 2), иначе симметрия
+    if (x < (a + 1.0) / (a + b + 2.0)) {
+        return front * betaContinuedFraction(x, a, b) / a;
+    }
+    return 1.0 - front * betaContinuedFraction(1.0 - x, b, a) / b;
+}
+
+double SampleStatistics::welchTTest(const std::vector<double>& a, const std::vector<double>& b) {
+    if (a.size() < 2 || b.size() < 2) return -1.0;
+
+    double meanA, varianceA, meanB, varianceB;
+    meanAndVariance(a, meanA, varianceA);
+    meanAndVariance(b, meanB, varianceB);
+
+    double errorA = varianceA / a.size();
+    double errorB = varianceB / b.size();
+    double error = errorA + errorB;
+    if (error <= 0.0) {
+        return meanA == meanB ? 1.0 : 0.0;
+    }
+
+    double t = (meanA - meanB) / std::sqrt(error);
+
+    // Степени свободы по Уэлчу - Саттертуэйту
+    double df = error * error /
+        (errorA * errorA / (a.size() - 1) + errorB * errorB / (b.size() - 1));
+
+    return incompleteBeta(df / (df + t * t), df / 2.0, 0.5);
+}
+
+SampleSummary SampleStatistics::summarize(std::vector<double> values) {
+    SampleSummary summary;
+    summary.count = values.size();
+    if (values.empty()) return summary;
+
+    std::sort(values.begin(), values.end());
+    summary.min = values.front();
+    summary.max = values.back();
+    summary.median = percentile(values, 50.0);
+    summary.p95 = percentile(values, 95.0);
+
+    double sum = 0.0;
+    for (double value : values) {
+        sum += value;
+    }
+    summary.mean = sum / values.size();
+
+    std::vector<double> deviations;
+    deviations.reserve(values.size());
+    double squares = 0.0;
+    for (double value : values) {
+        deviations.push_back(std::fabs(value - summary.median));
+        squares += (value - summary.mean) * (value - summary.mean);
+    }
+    std::sort(deviations.begin(), deviations.end());
+    summary.mad = percentile(deviations, 50.0);
+
+    // 1.4826 * MAD - оценка стандартного отклонения, устойчивая к выбросам
+    double limit = 3.0 * 1.4826 * summary.mad;
+    if (limit > 0.0) {
+        for (double deviation : deviations) {
+            if (deviation > limit) summary.outliers++;
+        }
+    }
+
+    if (values.size() >= 2) {
+        summary.stddev = std::sqrt(squares / (values.size() - 1));
+        double halfWidth = studentT95(values.size() - 1) * summary.stddev / std::sqrt(static_cast<double>(values.size()));
+        summary.ciLow = summary.mean - halfWidth;
+        summary.ciHigh = summary.mean + halfWidth;
+    }
+    else {
+        summary.ciLow = summary.ciHigh = summary.mean;
+    }
+
+    return summary;
+}
\ No newline at end of file
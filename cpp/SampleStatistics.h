@@ -0,0 +1,48 @@
+#pragma once
+// include/SampleStatistics.h
+#ifndef SAMPLESTATISTICS_H
+#define SAMPLESTATISTICS_H
+
+#include <string>
+#include <vector>
+
+// Сводка по выборке повторных замеров одной ячейки (дерево x операция)
+struct SampleSummary {
+    size_t count = 0;
+    double mean = 0.0;
+    double stddev = 0.0;
+    double median = 0.0;
+    double mad = 0.0;           // Медиана абсолютных отклонений от медианы
+    double min = 0.0;
+    double max = 0.0;
+    double p95 = 0.0;
+    double ciLow = 0.0;         // 95% доверительный интервал среднего (t-распределение)
+    double ciHigh = 0.0;
+    int outliers = 0;           // Дальше 3 * 1.4826 * MAD от медианы
+
+    // Полуширина ДИ в процентах от среднего (-1, если повторов меньше двух)
+    double getRelativeCIHalfWidth() const;
+
+    // "медиана=.. MAD=.. мин=.. p95=.. ДИ=[..; ..]"
+    std::string toString() const;
+};
+
+class SampleStatistics {
+public:
+    static SampleSummary summarize(std::vector<double> values);
+
+    // Значение по доле отсортированной выборки с линейной интерполяцией
+    static double percentile(const std::vector<double>& sorted, double percentile);
+
+    // Двусторонний 95% квантиль распределения Стьюдента
+    static double studentT95(size_t degreesOfFreedom);
+
+    // Двусторонний t-тест Уэлча (дисперсии выборок могут различаться).
+    // Возвращает p-значение или -1, если в какой-то выборке меньше двух значений
+    static double welchTTest(const std::vector<double>& a, const std::vector<double>& b);
+
+    // Регуляризованная неполная бета-функция I_x(a, b)
+    static double incompleteBeta(double x, double a, double b);
+};
+
+#endif // SAMPLESTATISTICS_H
\ No newline at end of file
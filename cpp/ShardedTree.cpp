@@ -0,0 +1,419 @@
+// src/ShardedTree.cpp
+#include <algorithm>
+#include <thread>
+
+#include "AATree.h"
+#include "AVLTree.h"
+#include "ShardedTree.h"
+#include "SkipList.h"
+#include "Treap.h"
+#include "TwoThreeTree.h"
+
+// =============== КОНСТРУКТОР ===============
+
+ShardedTree::ShardedTree(TreeType type, int shardCount, int minKey, int maxKey)
+    : shardType(type), insertsSinceCheck(0) {
+    if (shardCount < 1) shardCount = 1;
+
+    for (int i = 0; i < shardCount; i++) {
+        auto shard = std::make_unique<Shard>();
+        shard->tree = createShard();
+        shards.push_back(std::move(shard));
+    }
+
+    setUniformBounds(minKey, maxKey);
+}
+
+// =============== ПРИВАТНЫЕ ВСПОМОГАТЕЛЬНЫЕ МЕТОДЫ ===============
+
+std::unique_ptr<TreeBase> ShardedTree::createShard() const {
+    std::unique_ptr<TreeBase> tree;
+    switch (shardType) {
+    case TreeType::AVL:
+        tree = std::make_unique<AVLTree>();
+        break;
+    case TreeType::AA:
+        tree = std::make_unique<AATree>();
+        break;
+    case TreeType::TREAP:
+        tree = std::make_unique<Treap>();
+        break;
+    case TreeType::TWO_THREE:
+        tree = std::make_unique<TwoThreeTree>();
+        break;
+    case TreeType::SKIP_LIST:
+        tree = std::make_unique<SkipList>();
+        break;
+    default:
+        tree = std::make_unique<AVLTree>();
+        break;
+    }
+
+    // Операции засекает контейнер вместе с ожиданием блокировок
+    tree->setOperationTiming(false);
+    return tree;
+}
+
+size_t ShardedTree::shardIndex(int key) const {
+    // Первый шард, верхняя граница которого не меньше ключа
+    auto it = std::lower_bound(upperBounds.begin(), upperBounds.end(), key);
+    if (it == upperBounds.end()) return shards.size() - 1;
+    return static_cast<size_t>(it - upperBounds.begin());
+}
+
+void ShardedTree::setUniformBounds(int minKey, int maxKey) {
+    size_t count = shards.size();
+    upperBounds.assign(count, INT_MAX);
+
+    long long range = static_cast<long long>(maxKey) - minKey + 1;
+    if (range < 1) range = 1;
+
+    for (size_t i = 0; i + 1 < count; i++) {
+        upperBounds[i] = static_cast<int>(minKey + range * static_cast<long long>(i + 1) / count - 1);
+    }
+}
+
+void ShardedTree::setBoundsFromKeys(const std::vector<int>& sortedKeys) {
+    if (sortedKeys.empty()) return;
+
+    // Границы по квантилям: в каждом шарде примерно поровну ключей
+    size_t count = shards.size();
+    upperBounds.assign(count, INT_MAX);
+
+    for (size_t i = 0; i + 1 < count; i++) {
+        size_t index = (i + 1) * sortedKeys.size() / count;
+        upperBounds[i] = sortedKeys[index > 0 ? index - 1 : 0];
+    }
+}
+
+void ShardedTree::rebuild(const std::vector<int>& sortedKeys) {
+    setBoundsFromKeys(sortedKeys);
+
+    for (auto& shard : shards) {
+        shard->tree->clear();
+        shard->size = 0;
+    }
+
+    loadParallel(sortedKeys);
+}
+
+void ShardedTree::loadParallel(const std::vector<int>& keys) {
+    // Вызывается при эксклюзивно захваченной раскладке
+    std::vector<std::vector<int>> parts(shards.size());
+    for (int key : keys) {
+        parts[shardIndex(key)].push_back(key);
+    }
+
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < shards.size(); i++) {
+        if (parts[i].empty()) continue;
+
+        workers.emplace_back([this, i, &parts]() {
+            Shard& shard = *shards[i];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (int key : parts[i]) {
+                if (shard.tree->insert(key).success) {
+                    shard.size++;
+                }
+            }
+            });
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+bool ShardedTree::isSkewed() const {
+    // Перекос - самый большой шард вдвое больше среднего
+    long long total = 0;
+    int largest = 0;
+    for (const auto& shard : shards) {
+        int size = shard->size.load(std::memory_order_relaxed);
+        total += size;
+        largest = std::max(largest, size);
+    }
+
+    if (shards.size() < 2 || total < static_cast<long long>(shards.size()) * 16) return false;
+    return largest * static_cast<long long>(shards.size()) > 2 * total;
+}
+
+// =============== ОПЕРАЦИИ С РАСКЛАДКОЙ ===============
+
+void ShardedTree::rebalance() {
+    std::unique_lock<std::shared_mutex> layout(layoutMutex);
+    redistribute();
+}
+
+void ShardedTree::rebalanceIfSkewed() {
+    std::unique_lock<std::shared_mutex> layout(layoutMutex);
+
+    // Перекос мог устранить поток, раньше получивший блокировку
+    if (isSkewed()) {
+        redistribute();
+    }
+}
+
+void ShardedTree::redistribute() {
+    // Шарды упорядочены по диапазонам, поэтому конкатенация уже отсортирована
+    std::vector<int> keys;
+    for (auto& shard : shards) {
+        std::vector<int> part = shard->tree->traverse(TraversalType::INORDER);
+        keys.insert(keys.end(), part.begin(), part.end());
+    }
+
+    rebuild(keys);
+}
+
+void ShardedTree::bulkLoad(const std::vector<int>& keys) {
+    std::unique_lock<std::shared_mutex> layout(layoutMutex);
+
+    bool empty = true;
+    for (const auto& shard : shards) {
+        if (shard->size.load() > 0) empty = false;
+    }
+
+    // В пустой контейнер границы подбираются сразу под загружаемые ключи
+    if (empty) {
+        std::vector<int> sorted = keys;
+        std::sort(sorted.begin(), sorted.end());
+        setBoundsFromKeys(sorted);
+    }
+
+    loadParallel(keys);
+}
+
+std::vector<int> ShardedTree::rangeQuery(int low, int high) {
+    std::vector<int> result;
+    if (low > high) return result;
+
+    std::shared_lock<std::shared_mutex> layout(layoutMutex);
+
+    size_t first = shardIndex(low);
+    size_t last = shardIndex(high);
+
+    for (size_t i = first; i <= last; i++) {
+        Shard& shard = *shards[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        std::vector<int> keys = shard.tree->traverse(TraversalType::INORDER);
+        auto begin = std::lower_bound(keys.begin(), keys.end(), low);
+        auto end = std::upper_bound(begin, keys.end(), high);
+        result.insert(result.end(), begin, end);
+    }
+
+    return result;
+}
+
+std::vector<int> ShardedTree::getShardSizes() const {
+    std::shared_lock<std::shared_mutex> layout(layoutMutex);
+
+    std::vector<int> sizes;
+    for (const auto& shard : shards) {
+        sizes.push_back(shard->size.load(std::memory_order_relaxed));
+    }
+    return sizes;
+}
+
+// =============== ПУБЛИЧНЫЕ МЕТОДЫ ===============
+
+OperationResult ShardedTree::insert(int key) {
+    return measureWrapped([&]() { return insertKey(key); });
+}
+
+OperationResult ShardedTree::insertKey(int key) {
+    OperationResult result;
+    bool checkBalance = false;
+
+    {
+        std::shared_lock<std::shared_mutex> layout(layoutMutex);
+        Shard& shard = *shards[shardIndex(key)];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        result = shard.tree->insert(key);
+        if (result.success) {
+            shard.size++;
+            checkBalance = (insertsSinceCheck.fetch_add(1) + 1) % REBALANCE_CHECK_INTERVAL == 0;
+        }
+
+        if (checkBalance) {
+            checkBalance = isSkewed();
+        }
+    }
+
+    if (checkBalance) {
+        rebalanceIfSkewed();
+    }
+
+    return result;
+}
+
+OperationResult ShardedTree::remove(int key) {
+    return measureWrapped([&]() {
+        std::shared_lock<std::shared_mutex> layout(layoutMutex);
+        Shard& shard = *shards[shardIndex(key)];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        OperationResult result = shard.tree->remove(key);
+        if (result.success) {
+            shard.size--;
+        }
+        return result;
+        });
+}
+
+OperationResult ShardedTree::search(int key) {
+    return measureWrapped([&]() {
+        std::shared_lock<std::shared_mutex> layout(layoutMutex);
+        Shard& shard = *shards[shardIndex(key)];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        return shard.tree->search(key);
+        });
+}
+
+bool ShardedTree::contains(int key) const {
+    std::shared_lock<std::shared_mutex> layout(layoutMutex);
+    const Shard& shard = *shards[shardIndex(key)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    return shard.tree->contains(key);
+}
+
+std::unique_ptr<TreeBase> ShardedTree::clone() const {
+    std::shared_lock<std::shared_mutex> layout(layoutMutex);
+
+    // Те же границы и копии деревьев шардов
+    auto copy = std::make_unique<ShardedTree>(shardType, static_cast<int>(shards.size()));
+    copy->upperBounds = upperBounds;
+    for (size_t i = 0; i < shards.size(); i++) {
+        std::lock_guard<std::mutex> lock(shards[i]->mutex);
+        copy->shards[i]->tree = shards[i]->tree->clone();
+        copy->shards[i]->tree->setOperationTiming(false);
+        copy->shards[i]->size = shards[i]->size.load();
+    }
+    return copy;
+}
+
+OperationResult ShardedTree::clear() {
+    auto result = measureOperation([this]() {
+        std::unique_lock<std::shared_mutex> layout(layoutMutex);
+        for (auto& shard : shards) {
+            shard->tree->clear();
+            shard->size = 0;
+        }
+        return true;
+        });
+
+    result.message = "Дерево очищено";
+    return result;
+}
+
+std::vector<int> ShardedTree::traverse(TraversalType type) {
+    std::shared_lock<std::shared_mutex> layout(layoutMutex);
+
+    std::vector<int> result;
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        std::vector<int> part = shard->tree->traverse(type);
+        result.insert(result.end(), part.begin(), part.end());
+    }
+    return result;
+}
+
+int ShardedTree::getHeight() const {
+    std::shared_lock<std::shared_mutex> layout(layoutMutex);
+
+    int height = 0;
+    for (const auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        height = std::max(height, shard->tree->getHeight());
+    }
+    return height;
+}
+
+int ShardedTree::getNodeCount() const {
+    std::shared_lock<std::shared_mutex> layout(layoutMutex);
+
+    int count = 0;
+    for (const auto& shard : shards) {
+        count += shard->size.load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+bool ShardedTree::isEmpty() const {
+    return getNodeCount() == 0;
+}
+
+size_t ShardedTree::getMemoryUsage() const {
+    std::shared_lock<std::shared_mutex> layout(layoutMutex);
+
+    size_t bytes = sizeof(*this) + upperBounds.capacity() * sizeof(int);
+    for (const auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        bytes += sizeof(Shard) + shard->tree->getMemoryUsage();
+    }
+    return bytes;
+}
+
+StructureProfile ShardedTree::analyzeStructure(int threads) const {
+    std::shared_lock<std::shared_mutex> layout(layoutMutex);
+
+    // Лес шардов: глубины и сравнения - внутри шарда, без выбора шарда
+    StructureProfile profile;
+    for (const auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        profile.merge(shard->tree->analyzeStructure(threads));
+    }
+    return profile;
+}
+
+std::string ShardedTree::toString() const {
+    std::shared_lock<std::shared_mutex> layout(layoutMutex);
+
+    std::string result;
+    for (size_t i = 0; i < shards.size(); i++) {
+        std::lock_guard<std::mutex> lock(shards[i]->mutex);
+        result += "Шард " + std::to_string(i) + " (ключи <= " + std::to_string(upperBounds[i]) +
+            ", узлов: " + std::to_string(shards[i]->size.load()) + ")\n";
+        result += shards[i]->tree->toString();
+    }
+    return result;
+}
+
+void ShardedTree::resetStatistics() {
+    std::shared_lock<std::shared_mutex> layout(layoutMutex);
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        shard->tree->resetStatistics();
+    }
+}
+
+TreeStatistics ShardedTree::getStatistics() const {
+    std::shared_lock<std::shared_mutex> layout(layoutMutex);
+
+    TreeStatistics total;
+    for (const auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        TreeStatistics part = shard->tree->getStatistics();
+
+        total.insert_count += part.insert_count;
+        total.remove_count += part.remove_count;
+        total.search_count += part.search_count;
+        total.traversal_count += part.traversal_count;
+        total.rotations_count += part.rotations_count;
+        total.splits_count += part.splits_count;
+        total.merges_count += part.merges_count;
+        total.skew_count += part.skew_count;
+        total.split_count += part.split_count;
+        total.borrows_count += part.borrows_count;
+        total.comparisons += part.comparisons;
+        total.node_visits += part.node_visits;
+        total.allocations += part.allocations;
+        total.total_insert_time += part.total_insert_time;
+        total.total_search_time += part.total_search_time;
+        total.total_delete_time += part.total_delete_time;
+    }
+    return total;
+}
\ No newline at end of file
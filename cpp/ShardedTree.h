@@ -0,0 +1,87 @@
+#pragma once
+// include/ShardedTree.h
+#ifndef SHARDEDTREE_H
+#define SHARDEDTREE_H
+
+#include <atomic>
+#include <climits>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+#include "TreeBase.h"
+
+// Контейнер, разбивающий пространство ключей на диапазоны (шарды).
+// Каждый шард - независимое однопоточное дерево под собственным мьютексом,
+// поэтому операции над разными диапазонами выполняются параллельно
+class ShardedTree : public TreeBase {
+private:
+    struct Shard {
+        std::unique_ptr<TreeBase> tree;
+        mutable std::mutex mutex;
+        std::atomic<int> size{ 0 };
+    };
+
+    // Проверка перекоса шардов выполняется раз в столько успешных вставок
+    static const int REBALANCE_CHECK_INTERVAL = 4096;
+
+    TreeType shardType;
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::vector<int> upperBounds;            // Шард i хранит ключи (upperBounds[i-1], upperBounds[i]]
+    mutable std::shared_mutex layoutMutex;   // Эксклюзивно захватывается при смене границ
+    std::atomic<int> insertsSinceCheck;
+
+    // Вспомогательные методы
+    std::unique_ptr<TreeBase> createShard() const;
+    size_t shardIndex(int key) const;
+    void setUniformBounds(int minKey, int maxKey);
+    void setBoundsFromKeys(const std::vector<int>& sortedKeys);
+    void rebuild(const std::vector<int>& sortedKeys);
+    void loadParallel(const std::vector<int>& keys);
+    bool isSkewed() const;
+    void redistribute();                     // Вызывается под эксклюзивной блокировкой раскладки
+    void rebalanceIfSkewed();
+    OperationResult insertKey(int key);
+
+public:
+    ShardedTree(TreeType type, int shardCount, int minKey = 0, int maxKey = 1000000);
+
+    // Перераспределение границ по фактическому распределению ключей
+    void rebalance();
+
+    // Параллельная загрузка: ключи раскладываются по шардам,
+    // каждый шард заполняется в своем потоке
+    void bulkLoad(const std::vector<int>& keys);
+
+    // Ключи из [low, high] в порядке возрастания
+    std::vector<int> rangeQuery(int low, int high);
+
+    int getShardCount() const { return static_cast<int>(shards.size()); }
+    std::vector<int> getShardSizes() const;
+
+    // Реализация интерфейса TreeBase
+    OperationResult insert(int key) override;
+    OperationResult remove(int key) override;
+    OperationResult search(int key) override;
+    OperationResult clear() override;
+    bool contains(int key) const override;
+    std::unique_ptr<TreeBase> clone() const override;
+
+    std::vector<int> traverse(TraversalType type) override;
+
+    int getHeight() const override;
+    int getNodeCount() const override;
+    bool isEmpty() const override;
+    size_t getMemoryUsage() const override;
+    StructureProfile analyzeStructure(int threads = 1) const override;
+    bool isThreadSafe() const override { return true; }
+
+    std::string toString() const override;
+
+    void resetStatistics() override;
+    TreeStatistics getStatistics() const override;
+
+    TreeType getType() const override { return shardType; }
+};
+
+#endif // SHARDEDTREE_H
\ No newline at end of file
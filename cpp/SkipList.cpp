@@ -0,0 +1,717 @@
+// src/SkipList.cpp
+#include <algorithm>
+#include <climits>
+#include <new>
+#include <random>
+#include <sstream>
+#include <thread>
+
+#include "PhaseProfiler.h"
+#include "SkipList.h"
+
+namespace {
+
+// Работа с помеченными ссылками: младший бит - признак удаления
+inline SkipListNode* getRef(std::uintptr_t link) {
+    return reinterpret_cast<SkipListNode*>(link & ~static_cast<std::uintptr_t>(1));
+}
+
+inline bool isMarked(std::uintptr_t link) {
+    return (link & 1) != 0;
+}
+
+inline std::uintptr_t makeLink(SkipListNode* node, bool marked = false) {
+    return reinterpret_cast<std::uintptr_t>(node) | (marked ? 1 : 0);
+}
+
+}
+
+// =============== УЗЕЛ ===============
+
+SkipListNode::SkipListNode(int k, int levels)
+    : key(k), topLevel(static_cast<std::int16_t>(levels)), holders(1), retiredNext(nullptr), next(nullptr) {
+    // Ссылки размещены сразу за объектом узла
+    char* base = reinterpret_cast<char*>(this) + sizeof(SkipListNode);
+    next = reinterpret_cast<std::atomic<std::uintptr_t>*>(base);
+    for (int i = 0; i < levels; i++) {
+        new (&next[i]) std::atomic<std::uintptr_t>(0);
+    }
+}
+
+size_t SkipListNode::allocationSize(int levels) {
+    return sizeof(SkipListNode) + levels * sizeof(std::atomic<std::uintptr_t>);
+}
+
+SkipListNode* SkipListNode::create(int key, int levels) {
+    void* memory = ::operator new(allocationSize(levels));
+    return new (memory) SkipListNode(key, levels);
+}
+
+void SkipListNode::destroy(SkipListNode* node) {
+    if (!node) return;
+    for (int i = 0; i < node->topLevel; i++) {
+        node->next[i].~atomic();
+    }
+    node->~SkipListNode();
+    ::operator delete(node);
+}
+
+// =============== КОНСТРУКТОРЫ И ДЕСТРУКТОР ===============
+
+SkipList::SkipList()
+    : head(SkipListNode::create(INT_MIN, MAX_LEVEL)), levelHint(1), nodeCount(0),
+    epoch(0), reclaiming(false), insertCount(0), removeCount(0), searchCount(0), traversalCount(0),
+    comparisonCount(0), visitCount(0), allocationCount(0) {
+    for (int i = 0; i < EPOCHS; i++) {
+        activeOperations[i].store(0);
+        retired[i].store(nullptr);
+    }
+    resetStatistics();
+}
+
+SkipList::~SkipList() {
+    releaseAll();
+    SkipListNode::destroy(head);
+}
+
+// =============== ОСВОБОЖДЕНИЕ ПО ЭПОХАМ ===============
+
+SkipList::EpochGuard::EpochGuard(const SkipList& owner) : list(owner) {
+    // Вход засчитывается, только если эпоха не сменилась между чтением и
+    // увеличением счетчика: иначе смена могла не увидеть эту операцию
+    while (true) {
+        unsigned long long current = list.epoch.load();
+        slot = static_cast<int>(current % EPOCHS);
+        list.activeOperations[slot].fetch_add(1);
+        if (list.epoch.load() == current) break;
+        list.activeOperations[slot].fetch_sub(1);
+    }
+}
+
+SkipList::EpochGuard::~EpochGuard() {
+    list.activeOperations[slot].fetch_sub(1);
+}
+
+bool SkipList::release(SkipListNode* node) {
+    if (!node->releaseHolder()) return false;
+    retire(node);
+    return true;
+}
+
+void SkipList::retire(SkipListNode* node) {
+    // Узел уже вырезан: операции, начатые позже, до него не доберутся
+    std::atomic<SkipListNode*>& list = retired[epoch.load() % EPOCHS];
+    SkipListNode* top = list.load(std::memory_order_relaxed);
+    do {
+        node->setRetiredNext(top);
+    } while (!list.compare_exchange_weak(top, node, std::memory_order_release,
+        std::memory_order_relaxed));
+}
+
+void SkipList::tryReclaim() {
+    if (reclaiming.exchange(true, std::memory_order_acquire)) {
+        return; // Освобождает другой поток
+    }
+
+    // (current + 2) % EPOCHS - остаток эпохи current - 1
+    unsigned long long current = epoch.load();
+    int previous = static_cast<int>((current + 2) % EPOCHS);
+    if (activeOperations[previous].load() == 0) {
+        epoch.store(current + 1);
+        TREE_PHASE(ALLOCATION);
+        destroyList(retired[previous].exchange(nullptr, std::memory_order_acq_rel));
+    }
+
+    reclaiming.store(false, std::memory_order_release);
+}
+
+void SkipList::destroyList(SkipListNode* node) {
+    while (node) {
+        SkipListNode* next = node->getRetiredNext();
+        SkipListNode::destroy(node);
+        node = next;
+    }
+}
+
+// =============== ПРИВАТНЫЕ ВСПОМОГАТЕЛЬНЫЕ МЕТОДЫ ===============
+
+int SkipList::randomLevel() {
+    // Геометрическое распределение с p = 1/2, у каждого потока свой генератор
+    thread_local std::mt19937 rng(std::random_device{}());
+    std::uint32_t bits = rng();
+
+    int level = 1;
+    while ((bits & 1) && level < MAX_LEVEL) {
+        level++;
+        bits >>= 1;
+    }
+    return level;
+}
+
+void SkipList::visit(const SkipListNode* node, int level, WorkCounters& work) const {
+    work.visits++;
+
+    // Заголовок узла с ключом и ссылка нужного уровня
+    traceAccess(node, sizeof(SkipListNode));
+    traceAccess(&node->getNext(level), sizeof(std::uintptr_t));
+}
+
+void SkipList::addWork(const WorkCounters& work) const {
+    comparisonCount.fetch_add(work.comparisons, std::memory_order_relaxed);
+    visitCount.fetch_add(work.visits, std::memory_order_relaxed);
+}
+
+bool SkipList::find(int key, SkipListNode** preds, SkipListNode** succs) {
+    int startLevel = levelHint.load(std::memory_order_acquire) - 1;
+    WorkCounters work;
+
+    while (true) {
+        bool restart = false;
+        SkipListNode* pred = head;
+        SkipListNode* curr = nullptr;
+
+        for (int level = startLevel; level >= 0 && !restart; level--) {
+            curr = getRef(pred->getNext(level).load(std::memory_order_acquire));
+
+            while (curr) {
+                visit(curr, level, work);
+                std::uintptr_t succ = curr->getNext(level).load(std::memory_order_acquire);
+
+                if (isMarked(succ)) {
+                    // Узел логически удален - физически вырезаем его на этом уровне
+                    std::uintptr_t expected = makeLink(curr);
+                    if (!pred->getNext(level).compare_exchange_strong(expected, makeLink(getRef(succ)),
+                        std::memory_order_acq_rel)) {
+                        restart = true;
+                        break;
+                    }
+                    curr = getRef(succ);
+                    continue;
+                }
+
+                work.comparisons++;
+                if (curr->getKey() < key) {
+                    pred = curr;
+                    curr = getRef(succ);
+                }
+                else {
+                    break;
+                }
+            }
+
+            preds[level] = pred;
+            succs[level] = curr;
+        }
+
+        if (!restart) {
+            addWork(work);
+            return curr && curr->getKey() == key;
+        }
+    }
+}
+
+bool SkipList::insertNode(int key) {
+    bool inserted = false;
+    bool retiredNode = false;
+    {
+        EpochGuard guard(*this);
+        inserted = linkNode(key, retiredNode);
+    }
+    // Узел мог удалить другой поток, пока вставка достраивала уровни
+    if (retiredNode) {
+        tryReclaim();
+    }
+    return inserted;
+}
+
+bool SkipList::linkNode(int key, bool& retiredNode) {
+    SkipListNode* preds[MAX_LEVEL];
+    SkipListNode* succs[MAX_LEVEL];
+
+    int topLevel = randomLevel();
+
+    // Поднимаем подсказку уровня до вставки, чтобы поиск учитывал новые уровни
+    int hint = levelHint.load(std::memory_order_relaxed);
+    while (hint < topLevel &&
+        !levelHint.compare_exchange_weak(hint, topLevel, std::memory_order_acq_rel)) {
+    }
+
+    SkipListNode* node = nullptr;
+
+    while (true) {
+        if (find(key, preds, succs)) {
+            TREE_PHASE(ALLOCATION);
+            SkipListNode::destroy(node);
+            return false; // Дубликат
+        }
+
+        if (!node) {
+            TREE_PHASE(ALLOCATION);
+            node = SkipListNode::create(key, topLevel);
+            node->addHolder(); // Держатель - эта вставка до конца связывания
+            allocationCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        for (int level = 0; level < topLevel; level++) {
+            node->getNext(level).store(makeLink(succs[level]), std::memory_order_relaxed);
+        }
+
+        // Точка линеаризации - включение узла в нижний уровень
+        std::uintptr_t expected = makeLink(succs[0]);
+        if (!preds[0]->getNext(0).compare_exchange_strong(expected, makeLink(node),
+            std::memory_order_release)) {
+            continue;
+        }
+        break;
+    }
+
+    nodeCount.fetch_add(1, std::memory_order_relaxed);
+
+    // Достраиваем верхние уровни - аналог балансировки деревьев
+    TREE_PHASE(REBALANCE);
+    for (int level = 1; level < topLevel; level++) {
+        bool abandoned = false;
+        while (!abandoned) {
+            std::uintptr_t nodeNext = node->getNext(level).load(std::memory_order_acquire);
+            if (isMarked(nodeNext)) {
+                abandoned = true; // Узел уже удаляется - дальше не связываем
+                break;
+            }
+
+            if (getRef(nodeNext) != succs[level] &&
+                !node->getNext(level).compare_exchange_strong(nodeNext, makeLink(succs[level]),
+                    std::memory_order_acq_rel)) {
+                continue;
+            }
+
+            std::uintptr_t expected = makeLink(succs[level]);
+            if (preds[level]->getNext(level).compare_exchange_strong(expected, makeLink(node),
+                std::memory_order_release)) {
+                // Узел пометили до связывания: удаляющий поток мог уже пройти
+                // этот уровень со своим вырезанием - вырезаем сами. Освободить
+                // узел он не мог: вставка еще держит его
+                if (isMarked(node->getNext(level).load(std::memory_order_acquire))) {
+                    find(key, preds, succs);
+                    abandoned = true;
+                }
+                break;
+            }
+
+            // Соседи изменились - перестраиваем предшественников
+            find(key, preds, succs);
+            if (succs[0] != node) {
+                abandoned = true; // Узел успели удалить
+            }
+        }
+        if (abandoned) break;
+    }
+
+    // Больше эта вставка узел не свяжет
+    retiredNode = release(node);
+    return true;
+}
+
+bool SkipList::removeNode(int key) {
+    bool removed = false;
+    {
+        EpochGuard guard(*this);
+        removed = unlinkNode(key);
+    }
+    // Вне своей эпохи: иначе операция сама задерживала бы смену
+    if (removed) {
+        tryReclaim();
+    }
+    return removed;
+}
+
+bool SkipList::unlinkNode(int key) {
+    SkipListNode* preds[MAX_LEVEL];
+    SkipListNode* succs[MAX_LEVEL];
+
+    if (!find(key, preds, succs)) {
+        return false;
+    }
+
+    SkipListNode* victim = succs[0];
+
+    // Помечаем верхние уровни
+    {
+        TREE_PHASE(REBALANCE);
+        for (int level = victim->getTopLevel() - 1; level >= 1; level--) {
+            std::uintptr_t succ = victim->getNext(level).load(std::memory_order_acquire);
+            while (!isMarked(succ)) {
+                victim->getNext(level).compare_exchange_weak(succ, succ | 1, std::memory_order_acq_rel);
+            }
+        }
+    }
+
+    // Кто пометил нижний уровень, тот и удалил ключ
+    std::uintptr_t succ = victim->getNext(0).load(std::memory_order_acquire);
+    while (true) {
+        if (isMarked(succ)) {
+            return false; // Другой поток успел раньше
+        }
+        if (victim->getNext(0).compare_exchange_strong(succ, succ | 1, std::memory_order_acq_rel)) {
+            find(key, preds, succs); // Физически вырезаем узел
+            release(victim);
+            nodeCount.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+}
+
+bool SkipList::contains(int key) const {
+    return lookup(key, nullptr);
+}
+
+bool SkipList::lookup(int key, WorkCounters* work) const {
+    // Поиск без модификации структуры: помеченные узлы просто пропускаются.
+    // Без счетчиков (work == nullptr) работа не учитывается и не трассируется
+    EpochGuard guard(*this);
+    const SkipListNode* pred = head;
+    const SkipListNode* curr = nullptr;
+
+    for (int level = levelHint.load(std::memory_order_acquire) - 1; level >= 0; level--) {
+        curr = getRef(pred->getNext(level).load(std::memory_order_acquire));
+
+        while (curr) {
+            if (work) visit(curr, level, *work);
+            std::uintptr_t succ = curr->getNext(level).load(std::memory_order_acquire);
+            if (isMarked(succ)) {
+                curr = getRef(succ);
+                continue;
+            }
+
+            if (work) work->comparisons++;
+            if (curr->getKey() < key) {
+                pred = curr;
+                curr = getRef(succ);
+            }
+            else {
+                break;
+            }
+        }
+    }
+
+    return curr && curr->getKey() == key;
+}
+
+void SkipList::releaseAll() {
+    // Вызывается только когда к списку никто не обращается
+    SkipListNode* node = getRef(head->getNext(0).load(std::memory_order_acquire));
+    while (node) {
+        SkipListNode* next = getRef(node->getNext(0).load(std::memory_order_relaxed));
+        SkipListNode::destroy(node);
+        node = next;
+    }
+
+    for (int i = 0; i < EPOCHS; i++) {
+        destroyList(retired[i].exchange(nullptr, std::memory_order_acq_rel));
+    }
+
+    for (int level = 0; level < MAX_LEVEL; level++) {
+        head->getNext(level).store(0, std::memory_order_relaxed);
+    }
+    levelHint.store(1, std::memory_order_relaxed);
+    nodeCount.store(0, std::memory_order_relaxed);
+}
+
+// =============== ВИЗУАЛИЗАЦИЯ ===============
+
+std::string SkipList::toString() const {
+    return getStructure();
+}
+
+std::string SkipList::getStructure() const {
+    EpochGuard guard(*this);
+    std::string result;
+
+    for (int level = getHeight() - 1; level >= 0; level--) {
+        result += "L" + std::to_string(level + 1) + ": head";
+
+        SkipListNode* node = getRef(head->getNext(level).load(std::memory_order_acquire));
+        while (node) {
+            std::uintptr_t next = node->getNext(level).load(std::memory_order_acquire);
+            if (!isMarked(next)) {
+                result += " -> " + std::to_string(node->getKey());
+            }
+            node = getRef(next);
+        }
+        result += "\n";
+    }
+
+    return result;
+}
+
+// =============== ПУБЛИЧНЫЕ МЕТОДЫ ===============
+
+OperationResult SkipList::insert(int key) {
+    bool success = false;
+    auto result = measureOperation([this, key, &success]() {
+        TREE_PHASE(DESCENT);
+        success = insertNode(key);
+        return success;
+        });
+
+    if (success) {
+        insertCount.fetch_add(1, std::memory_order_relaxed);
+        result.message = "Вставка выполнена успешно";
+    }
+    else {
+        result.message = "Ключ уже существует";
+    }
+
+    return result;
+}
+
+OperationResult SkipList::remove(int key) {
+    bool success = false;
+    auto result = measureOperation([this, key, &success]() {
+        TREE_PHASE(DESCENT);
+        success = removeNode(key);
+        return success;
+        });
+
+    if (success) {
+        removeCount.fetch_add(1, std::memory_order_relaxed);
+        result.message = "Удаление выполнено успешно";
+    }
+    else {
+        result.message = "Ключ не найден";
+    }
+
+    return result;
+}
+
+OperationResult SkipList::search(int key) {
+    bool success = false;
+    auto result = measureOperation([this, key, &success]() {
+        TREE_PHASE(DESCENT);
+        WorkCounters work;
+        success = lookup(key, &work);
+        addWork(work);
+        return success;
+        });
+
+    if (success) {
+        searchCount.fetch_add(1, std::memory_order_relaxed);
+        result.message = "Ключ найден";
+    }
+    else {
+        result.message = "Ключ не найден";
+    }
+
+    return result;
+}
+
+OperationResult SkipList::clear() {
+    auto result = measureOperation([this]() {
+        releaseAll();
+        return true;
+        });
+
+    result.message = "Список очищен";
+    resetStatistics();
+
+    return result;
+}
+
+std::unique_ptr<TreeBase> SkipList::clone() const {
+    auto copy = std::make_unique<SkipList>();
+
+    // Узлы копируются по нижнему уровню в порядке ключей с теми же верхними
+    // уровнями; last[level] - последний скопированный узел уровня
+    SkipListNode* last[MAX_LEVEL];
+    for (int level = 0; level < MAX_LEVEL; level++) {
+        last[level] = copy->head;
+    }
+
+    EpochGuard guard(*this);
+    int count = 0;
+    SkipListNode* node = getRef(head->getNext(0).load(std::memory_order_acquire));
+    while (node) {
+        std::uintptr_t next = node->getNext(0).load(std::memory_order_acquire);
+
+        // Логически удаленные узлы в копию не попадают
+        if (!isMarked(next)) {
+            SkipListNode* created = SkipListNode::create(node->getKey(), node->getTopLevel());
+            for (int level = 0; level < node->getTopLevel(); level++) {
+                last[level]->getNext(level).store(makeLink(created), std::memory_order_relaxed);
+                last[level] = created;
+            }
+            count++;
+        }
+        node = getRef(next);
+    }
+
+    copy->levelHint.store(levelHint.load(std::memory_order_acquire));
+    copy->nodeCount.store(count);
+    return copy;
+}
+
+std::vector<int> SkipList::traverse(TraversalType type) {
+    EpochGuard guard(*this);
+    std::vector<int> result;
+
+    if (type == TraversalType::LEVELORDER) {
+        // По уровням сверху вниз, каждый ключ - на своем верхнем уровне
+        for (int level = getHeight() - 1; level >= 0; level--) {
+            SkipListNode* node = getRef(head->getNext(level).load(std::memory_order_acquire));
+            while (node) {
+                std::uintptr_t next = node->getNext(level).load(std::memory_order_acquire);
+                if (!isMarked(next) && node->getTopLevel() == level + 1) {
+                    result.push_back(node->getKey());
+                }
+                node = getRef(next);
+            }
+        }
+    }
+    else {
+        // Для списка прямой и симметричный обходы совпадают с порядком нижнего уровня
+        SkipListNode* node = getRef(head->getNext(0).load(std::memory_order_acquire));
+        while (node) {
+            std::uintptr_t next = node->getNext(0).load(std::memory_order_acquire);
+            if (!isMarked(next)) {
+                result.push_back(node->getKey());
+            }
+            node = getRef(next);
+        }
+
+        if (type == TraversalType::POSTORDER) {
+            std::reverse(result.begin(), result.end());
+        }
+    }
+
+    traversalCount.fetch_add(1, std::memory_order_relaxed);
+    return result;
+}
+
+int SkipList::getHeight() const {
+    // Высота - количество непустых уровней
+    for (int level = MAX_LEVEL - 1; level >= 0; level--) {
+        if (getRef(head->getNext(level).load(std::memory_order_acquire))) {
+            return level + 1;
+        }
+    }
+    return 0;
+}
+
+int SkipList::getNodeCount() const {
+    return nodeCount.load(std::memory_order_relaxed);
+}
+
+bool SkipList::isEmpty() const {
+    return getNodeCount() == 0;
+}
+
+size_t SkipList::getMemoryUsage() const {
+    size_t bytes = sizeof(*this) + SkipListNode::allocationSize(MAX_LEVEL);
+
+    {
+        EpochGuard guard(*this);
+        SkipListNode* node = getRef(head->getNext(0).load(std::memory_order_acquire));
+        while (node) {
+            bytes += SkipListNode::allocationSize(node->getTopLevel());
+            node = getRef(node->getNext(0).load(std::memory_order_acquire));
+        }
+    }
+
+    // Узлы, ожидающие освобождения, тоже занимают память. Освобождаются
+    // они только под reclaiming, поэтому на время прохода он захватывается
+    while (reclaiming.exchange(true, std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+    for (int i = 0; i < EPOCHS; i++) {
+        for (SkipListNode* r = retired[i].load(std::memory_order_acquire); r; r = r->getRetiredNext()) {
+            bytes += SkipListNode::allocationSize(r->getTopLevel());
+        }
+    }
+    reclaiming.store(false, std::memory_order_release);
+
+    return bytes;
+}
+
+StructureProfile SkipList::analyzeStructure(int threads) const {
+    // Один проход по нижнему уровню, логически удаленные узлы пропускаются.
+    // Глубина узла - его число уровней, листьев нет, заполненность - 1.
+    // Поиск (lookup) спускается до уровня 0 и на уровне l сравнивает узлы
+    // высоты ровно l + 1, идущие после последнего узла выше l + 1, плюс одно
+    // сравнение с первым узлом уровня не меньше ключа, если он есть.
+    // run[l] - такие узлы перед текущим, last[l] - номер последнего узла уровня l.
+    // Проход последовательный: threads не используется
+    (void)threads;
+
+    EpochGuard guard(*this);
+    StructureProfile profile;
+    profile.valid = true;
+
+    long long run[MAX_LEVEL] = {};
+    long long last[MAX_LEVEL];
+    std::fill(last, last + MAX_LEVEL, -1LL);
+    long long pending = 0;              // Сумма run[]: сравнения перед текущим узлом
+
+    long long index = 0;
+    SkipListNode* node = getRef(head->getNext(0).load(std::memory_order_acquire));
+    while (node) {
+        std::uintptr_t next = node->getNext(0).load(std::memory_order_acquire);
+        if (!isMarked(next)) {
+            int levels = node->getTopLevel();
+
+            profile.nodes++;
+            profile.keys++;
+            profile.key_slots++;
+            if (levels > static_cast<int>(profile.depth_histogram.size())) {
+                profile.depth_histogram.resize(levels, 0);
+            }
+            profile.depth_histogram[levels - 1]++;
+            profile.internal_path_length += levels - 1;
+
+            // Поиск этого ключа и промежутка перед ним проходит те же узлы
+            profile.successful_comparisons += pending;
+            profile.unsuccessful_comparisons += pending;
+
+            for (int level = 0; level < levels - 1; level++) {
+                pending -= run[level];
+                run[level] = 0;
+                last[level] = index;
+            }
+            run[levels - 1]++;
+            last[levels - 1] = index;
+            pending++;
+            index++;
+        }
+        node = getRef(next);
+    }
+
+    // Промежуток после последнего ключа и сравнения с первым узлом не меньше ключа
+    profile.unsuccessful_comparisons += pending;
+    profile.external_positions = index + 1;
+    for (int level = 0; level < MAX_LEVEL; level++) {
+        profile.successful_comparisons += last[level] + 1;
+        profile.unsuccessful_comparisons += last[level] + 1;
+    }
+
+    profile.height = static_cast<int>(profile.depth_histogram.size());
+    return profile;
+}
+
+void SkipList::resetStatistics() {
+    insertCount = 0;
+    removeCount = 0;
+    searchCount = 0;
+    traversalCount = 0;
+    comparisonCount = 0;
+    visitCount = 0;
+    allocationCount = 0;
+}
+
+TreeStatistics SkipList::getStatistics() const {
+    TreeStatistics stats;
+    stats.insert_count = insertCount.load(std::memory_order_relaxed);
+    stats.remove_count = removeCount.load(std::memory_order_relaxed);
+    stats.search_count = searchCount.load(std::memory_order_relaxed);
+    stats.traversal_count = traversalCount.load(std::memory_order_relaxed);
+    stats.comparisons = comparisonCount.load(std::memory_order_relaxed);
+    stats.node_visits = visitCount.load(std::memory_order_relaxed);
+    stats.allocations = allocationCount.load(std::memory_order_relaxed);
+    return stats;
+}
\ No newline at end of file
@@ -0,0 +1,149 @@
+#pragma once
+// include/SkipList.h
+#ifndef SKIPLIST_H
+#define SKIPLIST_H
+
+#include <atomic>
+#include <cstdint>
+
+#include "TreeBase.h"
+
+// Узел списка с пропусками.
+// Массив ссылок next размещается в той же аллокации сразу за узлом,
+// младший бит каждой ссылки - метка логического удаления узла на этом уровне
+class SkipListNode {
+private:
+    int key;
+    std::int16_t topLevel;              // Не больше MAX_LEVEL; вместе с holders - в 4 байтах
+    // Операции, которые еще могут связать узел со списком: вставка, пока
+    // достраивает верхние уровни, и сам список. Последняя сдает узел на освобождение
+    std::atomic<std::int16_t> holders;
+    SkipListNode* retiredNext;          // Связь в списке отложенного освобождения
+    std::atomic<std::uintptr_t>* next;
+
+    SkipListNode(int k, int levels);
+
+public:
+    static SkipListNode* create(int key, int levels);
+    static void destroy(SkipListNode* node);
+    static size_t allocationSize(int levels);
+
+    // Геттеры
+    int getKey() const { return key; }
+    int getTopLevel() const { return topLevel; }
+    SkipListNode* getRetiredNext() const { return retiredNext; }
+    std::atomic<std::uintptr_t>& getNext(int level) { return next[level]; }
+    const std::atomic<std::uintptr_t>& getNext(int level) const { return next[level]; }
+
+    // Сеттеры
+    void setRetiredNext(SkipListNode* node) { retiredNext = node; }
+
+    void addHolder() { holders.fetch_add(1, std::memory_order_relaxed); }
+    // true - держателей не осталось
+    bool releaseHolder() { return holders.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+};
+
+// Неблокирующий список с пропусками (алгоритм Херлихи-Шавита).
+// Удалённые узлы освобождаются по эпохам: операция входит в текущую
+// эпоху, вырезанный узел попадает в список своей эпохи. Вставка, которая
+// еще достраивает верхние уровни, может снова связать помеченный узел,
+// поэтому узел сдается, когда с ним закончили и удаление, и вставка. Эпоха E
+// сменяется на E + 1, когда не осталось операций эпохи E - 1, и тогда же
+// освобождаются узлы, удаленные в эпоху E - 1: все операции, которые
+// могли их видеть, завершены. Смену пытается сделать каждое удаление,
+// так что при постоянной замене ключей память не растет
+class SkipList : public TreeBase {
+public:
+    static const int MAX_LEVEL = 32;
+
+private:
+    static const int EPOCHS = 3;        // Одновременно активны не больше двух эпох
+
+    SkipListNode* head;
+    std::atomic<int> levelHint;          // Максимальный уровень среди вставленных узлов
+    std::atomic<int> nodeCount;
+
+    // Освобождение по эпохам: счетчики операций и списки удаленных узлов
+    // по остатку эпохи. Эпоху меняет только поток, захвативший reclaiming
+    mutable std::atomic<unsigned long long> epoch;
+    mutable std::atomic<int> activeOperations[EPOCHS];
+    std::atomic<SkipListNode*> retired[EPOCHS];
+    mutable std::atomic<bool> reclaiming;
+
+    // Операция в эпохе: пока объект жив, узлы, видимые операции, не освобождаются
+    class EpochGuard {
+    private:
+        const SkipList& list;
+        int slot;
+
+    public:
+        explicit EpochGuard(const SkipList& owner);
+        ~EpochGuard();
+
+        EpochGuard(const EpochGuard&) = delete;
+        EpochGuard& operator=(const EpochGuard&) = delete;
+    };
+
+    // Счетчики операций (атомарные, т.к. обновляются из разных потоков)
+    std::atomic<int> insertCount;
+    std::atomic<int> removeCount;
+    std::atomic<int> searchCount;
+    std::atomic<int> traversalCount;
+
+    // Работа по структуре: копится локально за операцию и добавляется одним
+    // атомарным сложением, чтобы не создавать конкуренции на каждом узле
+    struct WorkCounters {
+        long long comparisons = 0;
+        long long visits = 0;
+    };
+    mutable std::atomic<long long> comparisonCount;
+    mutable std::atomic<long long> visitCount;
+    std::atomic<long long> allocationCount;
+
+    // Вспомогательные методы
+    int randomLevel();
+    void visit(const SkipListNode* node, int level, WorkCounters& work) const;
+    void addWork(const WorkCounters& work) const;
+    bool lookup(int key, WorkCounters* work) const;
+    bool find(int key, SkipListNode** preds, SkipListNode** succs);
+    bool insertNode(int key);
+    bool linkNode(int key, bool& retiredNode);
+    bool removeNode(int key);
+    bool unlinkNode(int key);
+    bool release(SkipListNode* node);
+    void retire(SkipListNode* node);
+    void tryReclaim();
+    static void destroyList(SkipListNode* node);
+    void releaseAll();
+
+public:
+    SkipList();
+    ~SkipList();
+
+    // Реализация интерфейса TreeBase
+    OperationResult insert(int key) override;
+    OperationResult remove(int key) override;
+    OperationResult search(int key) override;
+    OperationResult clear() override;
+    bool contains(int key) const override;
+    std::unique_ptr<TreeBase> clone() const override;
+
+    std::vector<int> traverse(TraversalType type) override;
+
+    int getHeight() const override;
+    int getNodeCount() const override;
+    bool isEmpty() const override;
+    size_t getMemoryUsage() const override;
+    StructureProfile analyzeStructure(int threads = 1) const override;
+    bool isThreadSafe() const override { return true; }
+
+    std::string toString() const override;
+    std::string getStructure() const;
+
+    void resetStatistics() override;
+    TreeStatistics getStatistics() const override;
+
+    TreeType getType() const override { return TreeType::SKIP_LIST; }
+};
+
+#endif // SKIPLIST_H
\ No newline at end of file
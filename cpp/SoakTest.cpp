@@ -0,0 +1,216 @@
+// src/SoakTest.cpp
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+
+#include "DataGenerator.h"
+#include "MemoryTracker.h"
+#include "SoakTest.h"
+#include "TraceRecorder.h"
+#include "Visualizer.h"
+
+double SoakSample::getHeightRatio() const {
+    return nodes > 1 ? height / std::log2(static_cast<double>(nodes)) : 0.0;
+}
+
+double SoakSample::getHeapBytesPerKey() const {
+    return nodes > 0 ? static_cast<double>(heap_bytes) / nodes : 0.0;
+}
+
+double SoakSample::getFragmentation() const {
+    if (allocator_bytes <= 0 || live_heap_bytes <= 0) return 0.0;
+    return std::max(0.0, 1.0 - static_cast<double>(live_heap_bytes) / allocator_bytes);
+}
+
+SoakTest::SoakTest(Benchmark& soakBenchmark) : benchmark(soakBenchmark) {
+}
+
+// =============== НАГРУЗКА ===============
+
+SoakSample SoakTest::takeSample(TreeBase* tree, long long baseline_heap) const {
+    SoakSample sample;
+    sample.tree_type = tree->getType();
+    sample.height = tree->getHeight();
+    sample.nodes = tree->getNodeCount();
+    sample.memory_bytes = static_cast<long long>(tree->getMemoryUsage());
+    sample.live_heap_bytes = MemoryTracker::snapshot().liveBytes;
+    sample.heap_bytes = sample.live_heap_bytes - baseline_heap;
+    sample.allocator_bytes = MemoryTracker::readAllocatorHeld();
+    sample.rss_bytes = MemoryTracker::readRSS();
+    return sample;
+}
+
+std::vector<SoakSample> SoakTest::run(const std::vector<TreeType>& tree_types) {
+    std::vector<SoakSample> samples;
+    for (TreeType type : tree_types) {
+        std::vector<SoakSample> part = runTree(type);
+        samples.insert(samples.end(), part.begin(), part.end());
+    }
+    return samples;
+}
+
+std::vector<SoakSample> SoakTest::runTree(TreeType type) {
+    std::vector<SoakSample> samples;
+    if (!Benchmark::keepsKeySet(type)) {
+        std::cerr << benchmark.getTreeName(type) << ": пропущено, дерево не сохраняет набор ключей" << std::endl;
+        return samples;
+    }
+
+    TraceSpan span("Soak", "run", benchmark.getTreeName(type), keys);
+    DataGenerator generator(42);
+    std::vector<int> present = generator.generateUnique(keys);
+
+    long long baseline_heap = MemoryTracker::snapshot().liveBytes;
+    auto tree = benchmark.createTree(type);
+    if (!tree) return samples;
+
+    // Время каждой операции не замеряется: прогон меряет дрейф, а не задержку
+    tree->setOperationTiming(false);
+    for (int key : present) {
+        tree->insert(key);
+    }
+
+    std::cout << benchmark.getTreeName(type) << ": " << keys << " ключей, "
+        << duration_ms / 1000 << " с, замер каждые " << interval_ms / 1000.0 << " с" << std::endl;
+
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int> key_distribution(0, INT_MAX);
+
+    using Clock = std::chrono::steady_clock;
+    long long operations = 0;
+    long long interval_operations = 0;
+    long long busy_ns = 0;              // Время нагрузки без замеров состояния
+    long long interval_start_ns = 0;
+
+    while (busy_ns < duration_ms * 1000000LL) {
+        auto start = Clock::now();
+        for (int i = 0; i < PAIRS_PER_CHECK; i++) {
+            size_t index = static_cast<size_t>(rng() % present.size());
+            tree->remove(present[index]);
+
+            int key;
+            do {
+                key = key_distribution(rng);
+            } while (tree->contains(key));
+            tree->insert(key);
+            present[index] = key;
+        }
+        busy_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+        operations += 2LL * PAIRS_PER_CHECK;
+        interval_operations += 2LL * PAIRS_PER_CHECK;
+
+        bool finished = busy_ns >= duration_ms * 1000000LL;
+        if (busy_ns - interval_start_ns < interval_ms * 1000000LL && !finished) continue;
+
+        SoakSample sample = takeSample(tree.get(), baseline_heap);
+        // Узел хранит один ключ: расхождение значит, что дерево теряет или
+        // удерживает ключи, и тренды памяти и высоты дальше ничего не говорят
+        if (sample.nodes != keys) {
+            std::cerr << benchmark.getTreeName(type) << ": узлов " << sample.nodes << " при " << keys
+                << " ключах, нагрузка остановлена" << std::endl;
+            break;
+        }
+        sample.elapsed_ms = busy_ns / 1000000;
+        sample.operations = operations;
+        sample.ops_per_second = interval_operations * 1e9 / std::max(1LL, busy_ns - interval_start_ns);
+        samples.push_back(sample);
+
+        std::cout << "  " << std::setw(8) << sample.elapsed_ms / 1000 << " с  "
+            << std::fixed << std::setprecision(0) << std::setw(10) << sample.ops_per_second << " оп/с  RSS "
+            << Visualizer::formatMemory(static_cast<size_t>(sample.rss_bytes))
+            << "  куча/ключ " << std::setprecision(1) << sample.getHeapBytesPerKey()
+            << "  h=" << sample.height << " (" << std::setprecision(2) << sample.getHeightRatio() << " log2 n)"
+            << "  фрагм. " << std::setprecision(1) << sample.getFragmentation() * 100.0 << "%"
+            << std::defaultfloat << std::endl;
+        if (sample_observer) {
+            sample_observer(sample);
+        }
+
+        interval_operations = 0;
+        interval_start_ns = busy_ns;
+    }
+
+    return samples;
+}
+
+// =============== ВЫВОД ===============
+
+namespace {
+
+template <typename Field>
+double quarterMean(const std::vector<const SoakSample*>& samples, bool last, Field field) {
+    size_t count = std::max<size_t>(1, samples.size() / 4);
+    size_t begin = last ? samples.size() - count : 0;
+
+    double sum = 0.0;
+    for (size_t i = begin; i < begin + count; i++) {
+        sum += field(*samples[i]);
+    }
+    return sum / count;
+}
+
+}
+
+void SoakTest::printSummary(const std::vector<SoakSample>& samples) const {
+    std::map<TreeType, std::vector<const SoakSample*>> by_tree;
+    for (const auto& sample : samples) {
+        by_tree[sample.tree_type].push_back(&sample);
+    }
+
+    std::cout << "\n=== ДЛИТЕЛЬНАЯ НАГРУЗКА: НАЧАЛО -> КОНЕЦ (первая и последняя четверть замеров) ===\n";
+    std::cout << std::left << std::setw(12) << "Tree" << std::right
+        << std::setw(30) << "ops/s" << std::setw(28) << "RSS MB"
+        << std::setw(28) << "heap B/key" << std::setw(26) << "h/log2 n" << std::setw(26) << "frag %" << "\n";
+
+    for (const auto& tree : by_tree) {
+        const auto& part = tree.second;
+        auto column = [&](auto field, double scale, int precision) {
+            std::ostringstream cell;
+            double begin = quarterMean(part, false, field) * scale;
+            double end = quarterMean(part, true, field) * scale;
+            cell << std::fixed << std::setprecision(precision) << begin << " -> " << end;
+            if (begin > 0) {
+                cell << " (" << std::showpos << std::setprecision(1) << (end / begin - 1.0) * 100.0 << "%)";
+            }
+            return cell.str();
+        };
+
+        std::cout << std::left << std::setw(12) << benchmark.getTreeName(tree.first) << std::right
+            << std::setw(30) << column([](const SoakSample& s) { return s.ops_per_second; }, 1.0, 0)
+            << std::setw(28) << column([](const SoakSample& s) { return static_cast<double>(s.rss_bytes); },
+                1.0 / (1024 * 1024), 1)
+            << std::setw(28) << column([](const SoakSample& s) { return s.getHeapBytesPerKey(); }, 1.0, 1)
+            << std::setw(26) << column([](const SoakSample& s) { return s.getHeightRatio(); }, 1.0, 2)
+            << std::setw(26) << column([](const SoakSample& s) { return s.getFragmentation(); }, 100.0, 1)
+            << "\n";
+    }
+}
+
+bool SoakTest::saveToCSV(const std::vector<SoakSample>& samples, const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Не удалось открыть файл: " << filename << std::endl;
+        return false;
+    }
+
+    file << "TreeType;ElapsedMs;Operations;OpsPerSec;Height;HeightRatio;Nodes;MemoryBytes;"
+        << "HeapBytes;HeapBytesPerKey;AllocatorBytes;Fragmentation;RssBytes\n";
+
+    for (const auto& sample : samples) {
+        file << benchmark.getTreeName(sample.tree_type) << ";" << sample.elapsed_ms << ";"
+            << sample.operations << ";" << sample.ops_per_second << ";"
+            << sample.height << ";" << sample.getHeightRatio() << ";" << sample.nodes << ";"
+            << sample.memory_bytes << ";" << sample.heap_bytes << ";" << sample.getHeapBytesPerKey() << ";"
+            << sample.allocator_bytes << ";" << sample.getFragmentation() << ";" << sample.rss_bytes << "\n";
+    }
+
+    file.close();
+    return !file.fail();
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+// include/SoakTest.h
+#ifndef SOAKTEST_H
+#define SOAKTEST_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+
+// Замер состояния дерева за один интервал длительной нагрузки
+struct SoakSample {
+    TreeType tree_type = TreeType::UNKNOWN;
+    long long elapsed_ms = 0;           // С начала нагрузки, без времени замеров
+    long long operations = 0;           // Вставок и удалений с начала нагрузки
+    double ops_per_second = 0.0;        // За интервал
+    int height = 0;
+    int nodes = 0;
+    long long memory_bytes = 0;         // Оценка getMemoryUsage()
+    long long heap_bytes = 0;           // Живая куча сверх уровня до построения дерева
+    long long live_heap_bytes = 0;      // Вся живая куча процесса
+    long long allocator_bytes = 0;      // Память, удерживаемая аллокатором (0 - недоступна)
+    long long rss_bytes = 0;
+
+    double getHeightRatio() const;      // Высота / log2(узлов)
+    double getHeapBytesPerKey() const;
+    double getFragmentation() const;    // Доля удерживаемой аллокатором памяти, не занятой блоками
+};
+
+// Длительная нагрузка: дерево держится на N ключах, случайный ключ удаляется
+// и вставляется новый, пока не истечет время. Каждый интервал снимаются
+// пропускная способность, высота, куча, RSS и фрагментация - медленная
+// деградация (дрейф высоты Treap, удержание удаленных узлов) видна по тренду
+class SoakTest {
+private:
+    Benchmark& benchmark;
+
+    int keys = 1000000;
+    long long duration_ms = 3600000;    // На каждое дерево
+    long long interval_ms = 10000;
+
+    // Пар удаление-вставка между проверками часов
+    static constexpr int PAIRS_PER_CHECK = 1024;
+
+    std::function<void(const SoakSample&)> sample_observer;
+
+    SoakSample takeSample(TreeBase* tree, long long baseline_heap) const;
+
+public:
+    explicit SoakTest(Benchmark& benchmark);
+
+    void setKeys(int count) { keys = count < 1 ? 1 : count; }
+    void setDurationMs(long long ms) { duration_ms = ms < 1 ? 1 : ms; }
+    void setIntervalMs(long long ms) { interval_ms = ms < 1 ? 1 : ms; }
+
+    // Вызывается после каждого замера интервала, вне времени нагрузки
+    void setSampleObserver(const std::function<void(const SoakSample&)>& observer) {
+        sample_observer = observer;
+    }
+
+    // Деревья нагружаются по очереди
+    std::vector<SoakSample> run(const std::vector<TreeType>& tree_types);
+    std::vector<SoakSample> runTree(TreeType type);
+
+    // Начало и конец нагрузки по средним первой и последней четверти замеров
+    void printSummary(const std::vector<SoakSample>& samples) const;
+    bool saveToCSV(const std::vector<SoakSample>& samples, const std::string& filename) const;
+};
+
+#endif // SOAKTEST_H
\ No newline at end of file
@@ -1,324 +1,649 @@
-// src/Statistics.cpp
-#include <algorithm>
-#include <fstream>
-#include <sstream>
-#include <iomanip>
-
-#include "Statistics.h"
-
-void DetailedStatistics::reset() {
-    treeType = TreeType::UNKNOWN;
-    treeName = "";
-    timeMetrics = TimeMetrics();
-    structureMetrics = StructureMetrics();
-
-    //   
-    avlRotations = 0;
-    avlBalanceOperations = 0;
-    aaSkewOperations = 0;
-    aaSplitOperations = 0;
-    treapSplitOperations = 0;
-    treapMergeOperations = 0;
-    treapPriorityChanges = 0;
-    twoThreeSplits = 0;
-    twoThreeMerges = 0;
-    twoThreeBorrows = 0;
-
-    insertTimes.clear();
-    searchTimes.clear();
-    deleteTimes.clear();
-}
-
-void DetailedStatistics::addInsertTime(long long time) {
-    insertTimes.push_back(time);
-    timeMetrics.insertTime += time;
-    timeMetrics.operationCount++;
-}
-
-void DetailedStatistics::addSearchTime(long long time) {
-    searchTimes.push_back(time);
-    timeMetrics.searchTime += time;
-    timeMetrics.operationCount++;
-}
-
-void DetailedStatistics::addDeleteTime(long long time) {
-    deleteTimes.push_back(time);
-    timeMetrics.deleteTime += time;
-    timeMetrics.operationCount++;
-}
-
-std::string DetailedStatistics::generateReport() const {
-    std::stringstream ss;
-    ss << " : " << treeName << "\n";
-    ss << "================================\n";
-
-    ss << " :\n";
-    ss << "  : " << timeMetrics.insertTime << "  (: "
-        << (timeMetrics.operationCount > 0 ? timeMetrics.insertTime / timeMetrics.operationCount : 0) << " )\n";
-    ss << "  : " << timeMetrics.searchTime << "  (: "
-        << (timeMetrics.operationCount > 0 ? timeMetrics.searchTime / timeMetrics.operationCount : 0) << " )\n";
-    ss << "  : " << timeMetrics.deleteTime << "  (: "
-        << (timeMetrics.operationCount > 0 ? timeMetrics.deleteTime / timeMetrics.operationCount : 0) << " )\n";
-
-    ss << "\n :\n";
-    ss << "  . : " << structureMetrics.maxHeight << "\n";
-    ss << "  . : " << structureMetrics.minHeight << "\n";
-    ss << "   : " << std::fixed << std::setprecision(2) << structureMetrics.avgHeight << "\n";
-    ss << "   : " << structureMetrics.nodeCount << "\n";
-    ss << "   : " << structureMetrics.leafCount << "\n";
-    ss << "   : " << std::fixed << std::setprecision(3) << structureMetrics.balanceFactor << "\n";
-
-    //        
-    switch (treeType) {
-    case TreeType::AVL:
-        ss << "\n  AVL :\n";
-        ss << "  : " << avlRotations << "\n";
-        ss << "   : " << avlBalanceOperations << "\n";
-        break;
-    case TreeType::AA:
-        ss << "\n  AA :\n";
-        ss << "  Skew : " << aaSkewOperations << "\n";
-        ss << "  Split : " << aaSplitOperations << "\n";
-        break;
-    case TreeType::TREAP:
-        ss << "\n  Treap:\n";
-        ss << "  Split : " << treapSplitOperations << "\n";
-        ss << "  Merge : " << treapMergeOperations << "\n";
-        ss << "   : " << treapPriorityChanges << "\n";
-        break;
-    case TreeType::TWO_THREE:
-        ss << "\n  2-3 :\n";
-        ss << "  : " << twoThreeSplits << "\n";
-        ss << "  : " << twoThreeMerges << "\n";
-        ss << "  : " << twoThreeBorrows << "\n";
-        break;
-    default:
-        break;
-    }
-
-    return ss.str();
-}
-
-std::map<std::string, double> DetailedStatistics::getMetricsMap() const {
-    std::map<std::string, double> metrics;
-    metrics["insert_time"] = static_cast<double>(timeMetrics.insertTime);
-    metrics["search_time"] = static_cast<double>(timeMetrics.searchTime);
-    metrics["delete_time"] = static_cast<double>(timeMetrics.deleteTime);
-    metrics["max_height"] = static_cast<double>(structureMetrics.maxHeight);
-    metrics["min_height"] = static_cast<double>(structureMetrics.minHeight);
-    metrics["avg_height"] = structureMetrics.avgHeight;
-    metrics["node_count"] = static_cast<double>(structureMetrics.nodeCount);
-    metrics["leaf_count"] = static_cast<double>(structureMetrics.leafCount);
-    metrics["balance_factor"] = structureMetrics.balanceFactor;
-
-    return metrics;
-}
-
-// StatisticsCollector 
-StatisticsCollector::StatisticsCollector() {
-    //      
-    DetailedStatistics avlStats;
-    avlStats.treeType = TreeType::AVL;
-    avlStats.treeName = "AVL Tree";
-    statistics[TreeType::AVL] = avlStats;
-
-    DetailedStatistics aaStats;
-    aaStats.treeType = TreeType::AA;
-    aaStats.treeName = "AA Tree";
-    statistics[TreeType::AA] = aaStats;
-
-    DetailedStatistics treapStats;
-    treapStats.treeType = TreeType::TREAP;
-    treapStats.treeName = "Treap";
-    statistics[TreeType::TREAP] = treapStats;
-
-    DetailedStatistics twoThreeStats;
-    twoThreeStats.treeType = TreeType::TWO_THREE;
-    twoThreeStats.treeName = "2-3 Tree";
-    statistics[TreeType::TWO_THREE] = twoThreeStats;
-}
-
-void StatisticsCollector::registerInsert(TreeBase* tree, long long time) {
-    if (!tree) return;
-    TreeType type = tree->getType();
-    auto it = statistics.find(type);
-    if (it != statistics.end()) {
-        it->second.addInsertTime(time);
-    }
-}
-
-void StatisticsCollector::registerSearch(TreeBase* tree, long long time) {
-    if (!tree) return;
-    TreeType type = tree->getType();
-    auto it = statistics.find(type);
-    if (it != statistics.end()) {
-        it->second.addSearchTime(time);
-    }
-}
-
-void StatisticsCollector::registerDelete(TreeBase* tree, long long time) {
-    if (!tree) return;
-    TreeType type = tree->getType();
-    auto it = statistics.find(type);
-    if (it != statistics.end()) {
-        it->second.addDeleteTime(time);
-    }
-}
-
-void StatisticsCollector::registerTraversal(TreeBase* tree, long long time) {
-    if (!tree) return;
-    TreeType type = tree->getType();
-    auto it = statistics.find(type);
-    if (it != statistics.end()) {
-        it->second.timeMetrics.traversalTime += time;
-        it->second.timeMetrics.operationCount++;
-    }
-}
-
-void StatisticsCollector::updateStructureMetrics(TreeBase* tree) {
-    if (!tree) return;
-    TreeType type = tree->getType();
-    auto it = statistics.find(type);
-    if (it == statistics.end()) return;
-
-    auto& stats = it->second;
-
-    int height = tree->getHeight();
-    int nodeCount = tree->getNodeCount();
-
-    if (height > stats.structureMetrics.maxHeight) {
-        stats.structureMetrics.maxHeight = height;
-    }
-    if (stats.structureMetrics.minHeight == 0 || height < stats.structureMetrics.minHeight) {
-        stats.structureMetrics.minHeight = height;
-    }
-
-    //   
-    if (stats.timeMetrics.operationCount > 0) {
-        stats.structureMetrics.avgHeight =
-            (stats.structureMetrics.avgHeight * (stats.timeMetrics.operationCount - 1) + height) /
-            stats.timeMetrics.operationCount;
-    }
-
-    stats.structureMetrics.nodeCount = nodeCount;
-    //   ,    nodeCount/2
-    stats.structureMetrics.leafCount = nodeCount > 0 ? (nodeCount + 1) / 2 : 0;
-}
-
-const DetailedStatistics& StatisticsCollector::getStatistics(TreeType type) const {
-    auto it = statistics.find(type);
-    if (it != statistics.end()) {
-        return it->second;
-    }
-
-    //      
-    static DetailedStatistics emptyStats;
-    return emptyStats;
-}
-
-std::vector<DetailedStatistics> StatisticsCollector::getAllStatistics() const {
-    std::vector<DetailedStatistics> result;
-    for (const auto& pair : statistics) {
-        result.push_back(pair.second);
-    }
-    return result;
-}
-
-void StatisticsCollector::exportToCSV(const std::string& filename) const {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        return;
-    }
-
-    //  CSV
-    file << "TreeType,TreeName,InsertTime,SearchTime,DeleteTime,TraversalTime,"
-        << "MaxHeight,MinHeight,AvgHeight,NodeCount,LeafCount,BalanceFactor,"
-        << "AVLRotations,AASkew,AASplit,TreapSplits,TreapMerges,TwoThreeSplits,TwoThreeMerges\n";
-
-    for (const auto& pair : statistics) {
-        const DetailedStatistics& stats = pair.second;
-        auto metrics = stats.getMetricsMap();
-
-        file << static_cast<int>(stats.treeType) << ","
-            << stats.treeName << ","
-            << metrics.at("insert_time") << ","
-            << metrics.at("search_time") << ","
-            << metrics.at("delete_time") << ","
-            << stats.timeMetrics.traversalTime << ","
-            << metrics.at("max_height") << ","
-            << metrics.at("min_height") << ","
-            << metrics.at("avg_height") << ","
-            << metrics.at("node_count") << ","
-            << metrics.at("leaf_count") << ","
-            << metrics.at("balance_factor") << ","
-            << stats.avlRotations << ","
-            << stats.aaSkewOperations << ","
-            << stats.aaSplitOperations << ","
-            << stats.treapSplitOperations << ","
-            << stats.treapMergeOperations << ","
-            << stats.twoThreeSplits << ","
-            << stats.twoThreeMerges << "\n";
-    }
-
-    file.close();
-}
-
-void StatisticsCollector::exportToJSON(const std::string& filename) const {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        return;
-    }
-
-    file << "{\n";
-    file << "  \"statistics\": [\n";
-
-    bool first = true;
-    for (const auto& pair : statistics) {
-        const DetailedStatistics& stats = pair.second;
-
-        if (!first) file << ",\n";
-        first = false;
-
-        file << "    {\n";
-        file << "      \"treeType\": \"" << stats.treeName << "\",\n";
-        file << "      \"timeMetrics\": {\n";
-        file << "        \"insertTime\": " << stats.timeMetrics.insertTime << ",\n";
-        file << "        \"searchTime\": " << stats.timeMetrics.searchTime << ",\n";
-        file << "        \"deleteTime\": " << stats.timeMetrics.deleteTime << ",\n";
-        file << "        \"traversalTime\": " << stats.timeMetrics.traversalTime << "\n";
-        file << "      },\n";
-        file << "      \"structureMetrics\": {\n";
-        file << "        \"maxHeight\": " << stats.structureMetrics.maxHeight << ",\n";
-        file << "        \"minHeight\": " << stats.structureMetrics.minHeight << ",\n";
-        file << "        \"avgHeight\": " << stats.structureMetrics.avgHeight << ",\n";
-        file << "        \"nodeCount\": " << stats.structureMetrics.nodeCount << ",\n";
-        file << "        \"leafCount\": " << stats.structureMetrics.leafCount << ",\n";
-        file << "        \"balanceFactor\": " << stats.structureMetrics.balanceFactor << "\n";
-        file << "      },\n";
-
-        //  
-        file << "      \"specificMetrics\": {\n";
-        file << "        \"avlRotations\": " << stats.avlRotations << ",\n";
-        file << "        \"avlBalanceOperations\": " << stats.avlBalanceOperations << ",\n";
-        file << "        \"aaSkewOperations\": " << stats.aaSkewOperations << ",\n";
-        file << "        \"aaSplitOperations\": " << stats.aaSplitOperations << ",\n";
-        file << "        \"treapSplitOperations\": " << stats.treapSplitOperations << ",\n";
-        file << "        \"treapMergeOperations\": " << stats.treapMergeOperations << ",\n";
-        file << "        \"treapPriorityChanges\": " << stats.treapPriorityChanges << ",\n";
-        file << "        \"twoThreeSplits\": " << stats.twoThreeSplits << ",\n";
-        file << "        \"twoThreeMerges\": " << stats.twoThreeMerges << ",\n";
-        file << "        \"twoThreeBorrows\": " << stats.twoThreeBorrows << "\n";
-        file << "      }\n";
-        file << "    }";
-    }
-
-    file << "\n  ]\n";
-    file << "}\n";
-    file.close();
-}
-
-void StatisticsCollector::clear() {
-    for (auto& pair : statistics) {
-        pair.second.reset();
-    }
+// src/Statistics.cpp
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <iterator>
+
+#include "Statistics.h"
+#include "Timer.h"
+
+void DetailedStatistics::reset() {
+    treeType = TreeType::UNKNOWN;
+    treeName = "";
+    timeMetrics = TimeMetrics();
+    structureMetrics = StructureMetrics();
+
+    // Сброс специфических метрик
+    avlRotations = 0;
+    avlBalanceOperations = 0;
+    aaSkewOperations = 0;
+    aaSplitOperations = 0;
+    treapSplitOperations = 0;
+    treapMergeOperations = 0;
+    treapPriorityChanges = 0;
+    twoThreeSplits = 0;
+    twoThreeMerges = 0;
+    twoThreeBorrows = 0;
+    comparisons = 0;
+    nodeVisits = 0;
+    allocations = 0;
+
+    insertLatency.reset();
+    searchLatency.reset();
+    deleteLatency.reset();
+}
+
+void DetailedStatistics::addInsertTime(long long time) {
+    insertLatency.record(time);
+    timeMetrics.insertTime += time;
+    timeMetrics.operationCount++;
+}
+
+void DetailedStatistics::addSearchTime(long long time) {
+    searchLatency.record(time);
+    timeMetrics.searchTime += time;
+    timeMetrics.operationCount++;
+}
+
+void DetailedStatistics::addDeleteTime(long long time) {
+    deleteLatency.record(time);
+    timeMetrics.deleteTime += time;
+    timeMetrics.operationCount++;
+}
+
+void DetailedStatistics::merge(const DetailedStatistics& other) {
+    int totalOperations = timeMetrics.operationCount + other.timeMetrics.operationCount;
+
+    // Средняя высота взвешивается по числу замеров структуры
+    int totalSamples = structureMetrics.samples + other.structureMetrics.samples;
+    if (totalSamples > 0) {
+        structureMetrics.avgHeight =
+            (structureMetrics.avgHeight * structureMetrics.samples +
+                other.structureMetrics.avgHeight * other.structureMetrics.samples) / totalSamples;
+    }
+    // Метрики последнего замера берутся у большего дерева
+    if (other.structureMetrics.samples > 0 &&
+        (structureMetrics.samples == 0 || other.structureMetrics.nodeCount > structureMetrics.nodeCount)) {
+        const StructureMetrics& latest = other.structureMetrics;
+        structureMetrics.nodeCount = latest.nodeCount;
+        structureMetrics.leafCount = latest.leafCount;
+        structureMetrics.balanceFactor = latest.balanceFactor;
+        structureMetrics.avgDepth = latest.avgDepth;
+        structureMetrics.internalPathLength = latest.internalPathLength;
+        structureMetrics.successfulComparisons = latest.successfulComparisons;
+        structureMetrics.unsuccessfulComparisons = latest.unsuccessfulComparisons;
+        structureMetrics.fillFactor = latest.fillFactor;
+        structureMetrics.depthHistogram = latest.depthHistogram;
+    }
+    structureMetrics.samples = totalSamples;
+
+    timeMetrics.insertTime += other.timeMetrics.insertTime;
+    timeMetrics.searchTime += other.timeMetrics.searchTime;
+    timeMetrics.deleteTime += other.timeMetrics.deleteTime;
+    timeMetrics.traversalTime += other.timeMetrics.traversalTime;
+    timeMetrics.operationCount = totalOperations;
+
+    structureMetrics.maxHeight = std::max(structureMetrics.maxHeight, other.structureMetrics.maxHeight);
+    if (structureMetrics.minHeight == 0 ||
+        (other.structureMetrics.minHeight > 0 && other.structureMetrics.minHeight < structureMetrics.minHeight)) {
+        structureMetrics.minHeight = other.structureMetrics.minHeight;
+    }
+
+    avlRotations += other.avlRotations;
+    avlBalanceOperations += other.avlBalanceOperations;
+    aaSkewOperations += other.aaSkewOperations;
+    aaSplitOperations += other.aaSplitOperations;
+    treapSplitOperations += other.treapSplitOperations;
+    treapMergeOperations += other.treapMergeOperations;
+    treapPriorityChanges += other.treapPriorityChanges;
+    twoThreeSplits += other.twoThreeSplits;
+    twoThreeMerges += other.twoThreeMerges;
+    twoThreeBorrows += other.twoThreeBorrows;
+    comparisons += other.comparisons;
+    nodeVisits += other.nodeVisits;
+    allocations += other.allocations;
+
+    insertLatency.merge(other.insertLatency);
+    searchLatency.merge(other.searchLatency);
+    deleteLatency.merge(other.deleteLatency);
+}
+
+std::string DetailedStatistics::generateReport() const {
+    std::stringstream ss;
+    ss << "Отчет для: " << treeName << "\n";
+    ss << "================================\n";
+
+    ss << "Метрики производительности:\n";
+    ss << "  Вставка: " << timeMetrics.insertTime << " нс (среднее: "
+        << (timeMetrics.operationCount > 0 ? timeMetrics.insertTime / timeMetrics.operationCount : 0) << " нс)\n";
+    ss << "  Поиск: " << timeMetrics.searchTime << " нс (среднее: "
+        << (timeMetrics.operationCount > 0 ? timeMetrics.searchTime / timeMetrics.operationCount : 0) << " нс)\n";
+    ss << "  Удаление: " << timeMetrics.deleteTime << " нс (среднее: "
+        << (timeMetrics.operationCount > 0 ? timeMetrics.deleteTime / timeMetrics.operationCount : 0) << " нс)\n";
+
+    ss << "\nРаспределение времени (нс):\n";
+    ss << "  Вставка: " << insertLatency.toString() << "\n";
+    ss << "  Поиск: " << searchLatency.toString() << "\n";
+    ss << "  Удаление: " << deleteLatency.toString() << "\n";
+
+    ss << "\nМетрики структуры:\n";
+    ss << "  Макс. высота: " << structureMetrics.maxHeight << "\n";
+    ss << "  Мин. высота: " << structureMetrics.minHeight << "\n";
+    ss << "  Средняя высота: " << std::fixed << std::setprecision(2) << structureMetrics.avgHeight << "\n";
+    ss << "  Количество узлов: " << structureMetrics.nodeCount << "\n";
+    ss << "  Количество листьев: " << structureMetrics.leafCount << "\n";
+    ss << "  Коэффициент балансировки: " << std::fixed << std::setprecision(3) << structureMetrics.balanceFactor << "\n";
+    ss << "  Средняя глубина узла: " << std::fixed << std::setprecision(2) << structureMetrics.avgDepth << "\n";
+    ss << "  Длина внутреннего пути: " << structureMetrics.internalPathLength << "\n";
+    ss << "  Сравнений на поиск (есть / нет ключа): " << std::fixed << std::setprecision(2)
+        << structureMetrics.successfulComparisons << " / " << structureMetrics.unsuccessfulComparisons << "\n";
+    ss << "  Заполненность узлов: " << std::fixed << std::setprecision(3) << structureMetrics.fillFactor << "\n";
+    if (!structureMetrics.depthHistogram.empty()) {
+        ss << "  Узлов по глубинам:";
+        for (long long count : structureMetrics.depthHistogram) {
+            ss << " " << count;
+        }
+        ss << "\n";
+    }
+
+    ss << "\nРабота по структуре:\n";
+    ss << "  Сравнения: " << comparisons << "\n";
+    ss << "  Посещения узлов: " << nodeVisits << "\n";
+    ss << "  Выделения узлов: " << allocations << "\n";
+
+    // Вывод специфических метрик в зависимости от типа дерева
+    switch (treeType) {
+    case TreeType::AVL:
+        ss << "\nСпецифичные метрики AVL дерева:\n";
+        ss << "  Повороты: " << avlRotations << "\n";
+        ss << "  Операции балансировки: " << avlBalanceOperations << "\n";
+        break;
+    case TreeType::AA:
+        ss << "\nСпецифичные метрики AA дерева:\n";
+        ss << "  Skew операции: " << aaSkewOperations << "\n";
+        ss << "  Split операции: " << aaSplitOperations << "\n";
+        break;
+    case TreeType::TREAP:
+        ss << "\nСпецифичные метрики Treap:\n";
+        ss << "  Split операции: " << treapSplitOperations << "\n";
+        ss << "  Merge операции: " << treapMergeOperations << "\n";
+        ss << "  Изменения приоритета: " << treapPriorityChanges << "\n";
+        break;
+    case TreeType::TWO_THREE:
+        ss << "\nСпецифичные метрики 2-3 дерева:\n";
+        ss << "  Расщепления: " << twoThreeSplits << "\n";
+        ss << "  Слияния: " << twoThreeMerges << "\n";
+        ss << "  Заимствования: " << twoThreeBorrows << "\n";
+        break;
+    default:
+        break;
+    }
+
+    return ss.str();
+}
+
+std::map<std::string, double> DetailedStatistics::getMetricsMap() const {
+    std::map<std::string, double> metrics;
+    metrics["insert_time"] = static_cast<double>(timeMetrics.insertTime);
+    metrics["search_time"] = static_cast<double>(timeMetrics.searchTime);
+    metrics["delete_time"] = static_cast<double>(timeMetrics.deleteTime);
+    metrics["max_height"] = static_cast<double>(structureMetrics.maxHeight);
+    metrics["min_height"] = static_cast<double>(structureMetrics.minHeight);
+    metrics["avg_height"] = structureMetrics.avgHeight;
+    metrics["node_count"] = static_cast<double>(structureMetrics.nodeCount);
+    metrics["leaf_count"] = static_cast<double>(structureMetrics.leafCount);
+    metrics["balance_factor"] = structureMetrics.balanceFactor;
+    metrics["avg_depth"] = structureMetrics.avgDepth;
+    metrics["internal_path_length"] = static_cast<double>(structureMetrics.internalPathLength);
+    metrics["successful_comparisons"] = structureMetrics.successfulComparisons;
+    metrics["unsuccessful_comparisons"] = structureMetrics.unsuccessfulComparisons;
+    metrics["fill_factor"] = structureMetrics.fillFactor;
+
+    return metrics;
+}
+
+// StatisticsCollector реализация
+
+namespace {
+std::atomic<unsigned long long> nextCollectorId{ 1 };
+}
+
+StatisticsCollector::StatisticsCollector()
+    : collectorId(nextCollectorId++), shards(std::make_shared<ShardList>()) {
+    // Инициализация статистики для всех типов деревьев
+    DetailedStatistics avlStats;
+    avlStats.treeType = TreeType::AVL;
+    avlStats.treeName = "AVL Tree";
+    prototypes[TreeType::AVL] = avlStats;
+
+    DetailedStatistics aaStats;
+    aaStats.treeType = TreeType::AA;
+    aaStats.treeName = "AA Tree";
+    prototypes[TreeType::AA] = aaStats;
+
+    DetailedStatistics treapStats;
+    treapStats.treeType = TreeType::TREAP;
+    treapStats.treeName = "Treap";
+    prototypes[TreeType::TREAP] = treapStats;
+
+    DetailedStatistics twoThreeStats;
+    twoThreeStats.treeType = TreeType::TWO_THREE;
+    twoThreeStats.treeName = "2-3 Tree";
+    prototypes[TreeType::TWO_THREE] = twoThreeStats;
+
+    DetailedStatistics skipListStats;
+    skipListStats.treeType = TreeType::SKIP_LIST;
+    skipListStats.treeName = "Skip List";
+    prototypes[TreeType::SKIP_LIST] = skipListStats;
+
+    statistics = prototypes;
+}
+
+StatisticsCollector::ShardList::~ShardList() {
+    ThreadShard* shard = head.load();
+    while (shard) {
+        ThreadShard* next = shard->next;
+        delete shard;
+        shard = next;
+    }
+}
+
+StatisticsCollector::ThreadShard* StatisticsCollector::createShard() const {
+    ThreadShard* shard = new ThreadShard();
+    for (const auto& pair : prototypes) {
+        shard->statistics[static_cast<int>(pair.first)] = pair.second;
+    }
+    return shard;
+}
+
+StatisticsCollector::ThreadShard* StatisticsCollector::localShard() {
+    // Шарды потока по сборщикам; при завершении потока они возвращаются
+    // в списки еще живых сборщиков
+    struct OwnedShards {
+        struct Entry {
+            std::weak_ptr<ShardList> list;
+            ThreadShard* shard;
+        };
+        std::map<unsigned long long, Entry> entries;
+
+        ~OwnedShards() {
+            for (auto& pair : entries) {
+                if (std::shared_ptr<ShardList> list = pair.second.list.lock()) {
+                    pair.second.shard->owned.store(false, std::memory_order_release);
+                }
+            }
+        }
+    };
+
+    // Кэш последнего использованного сборщика и таблица остальных
+    thread_local unsigned long long cachedId = 0;
+    thread_local ThreadShard* cachedShard = nullptr;
+    thread_local OwnedShards ownedShards;
+
+    if (cachedId == collectorId) return cachedShard;
+
+    ThreadShard* shard = nullptr;
+    auto it = ownedShards.entries.find(collectorId);
+    if (it != ownedShards.entries.end()) {
+        shard = it->second.shard;
+    }
+    else {
+        // Записи уничтоженных сборщиков не копятся у долгоживущего потока
+        for (auto entry = ownedShards.entries.begin(); entry != ownedShards.entries.end();) {
+            entry = entry->second.list.expired() ? ownedShards.entries.erase(entry) : std::next(entry);
+        }
+
+        // Сначала - шард завершившегося потока, его статистика дополняется
+        for (ThreadShard* free = shards->head.load(std::memory_order_acquire); free; free = free->next) {
+            bool expected = false;
+            if (free->owned.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                shard = free;
+                break;
+            }
+        }
+
+        if (!shard) {
+            // Регистрация без блокировок: добавляем шард в голову списка
+            shard = createShard();
+            ThreadShard* head = shards->head.load(std::memory_order_relaxed);
+            do {
+                shard->next = head;
+            } while (!shards->head.compare_exchange_weak(head, shard, std::memory_order_release,
+                std::memory_order_relaxed));
+        }
+        ownedShards.entries[collectorId] = { shards, shard };
+    }
+
+    cachedId = collectorId;
+    cachedShard = shard;
+    return shard;
+}
+
+DetailedStatistics* StatisticsCollector::localStatistics(TreeBase* tree) {
+    if (!tree) return nullptr;
+
+    int index = static_cast<int>(tree->getType());
+    if (index < 0 || index >= TREE_TYPE_COUNT) return nullptr;
+
+    return &localShard()->statistics[index];
+}
+
+void StatisticsCollector::registerInsert(TreeBase* tree, long long time) {
+    DetailedStatistics* stats = localStatistics(tree);
+    if (stats) {
+        stats->addInsertTime(time);
+    }
+}
+
+void StatisticsCollector::registerSearch(TreeBase* tree, long long time) {
+    DetailedStatistics* stats = localStatistics(tree);
+    if (stats) {
+        stats->addSearchTime(time);
+    }
+}
+
+void StatisticsCollector::registerDelete(TreeBase* tree, long long time) {
+    DetailedStatistics* stats = localStatistics(tree);
+    if (stats) {
+        stats->addDeleteTime(time);
+    }
+}
+
+void StatisticsCollector::registerTraversal(TreeBase* tree, long long time) {
+    DetailedStatistics* stats = localStatistics(tree);
+    if (stats) {
+        stats->timeMetrics.traversalTime += time;
+        stats->timeMetrics.operationCount++;
+    }
+}
+
+void StatisticsCollector::updateStructureMetrics(TreeBase* tree, int threads) {
+    DetailedStatistics* found = localStatistics(tree);
+    if (!found) return;
+
+    auto& stats = *found;
+
+    // Точные метрики - одним проходом; без доступа к узлам остаются высота и число узлов
+    StructureProfile profile = tree->analyzeStructure(threads);
+    int height = profile.valid ? profile.height : tree->getHeight();
+    int nodeCount = profile.valid ? static_cast<int>(profile.nodes) : tree->getNodeCount();
+
+    if (height > stats.structureMetrics.maxHeight) {
+        stats.structureMetrics.maxHeight = height;
+    }
+    if (stats.structureMetrics.minHeight == 0 || height < stats.structureMetrics.minHeight) {
+        stats.structureMetrics.minHeight = height;
+    }
+
+    // Средняя высота по замерам
+    stats.structureMetrics.samples++;
+    stats.structureMetrics.avgHeight +=
+        (height - stats.structureMetrics.avgHeight) / stats.structureMetrics.samples;
+
+    stats.structureMetrics.nodeCount = nodeCount;
+    stats.structureMetrics.leafCount = static_cast<int>(profile.leaves);
+    stats.structureMetrics.balanceFactor = profile.getBalanceFactor();
+    stats.structureMetrics.avgDepth = profile.getAverageDepth();
+    stats.structureMetrics.internalPathLength = profile.internal_path_length;
+    stats.structureMetrics.successfulComparisons = profile.getSuccessfulComparisons();
+    stats.structureMetrics.unsuccessfulComparisons = profile.getUnsuccessfulComparisons();
+    stats.structureMetrics.fillFactor = profile.getFillFactor();
+    stats.structureMetrics.depthHistogram = profile.depth_histogram;
+}
+
+void StatisticsCollector::registerStructureWork(TreeBase* tree, const TreeStatistics& delta) {
+    DetailedStatistics* stats = localStatistics(tree);
+    if (!stats) return;
+
+    stats->comparisons += delta.comparisons;
+    stats->nodeVisits += delta.node_visits;
+    stats->allocations += delta.allocations;
+
+    switch (tree->getType()) {
+    case TreeType::AVL:
+        stats->avlRotations += delta.rotations_count;
+        break;
+    case TreeType::AA:
+        stats->aaSkewOperations += delta.skew_count;
+        stats->aaSplitOperations += delta.split_count;
+        break;
+    case TreeType::TREAP:
+        stats->treapSplitOperations += delta.splits_count;
+        stats->treapMergeOperations += delta.merges_count;
+        // Повороты при вставке восстанавливают порядок приоритетов
+        stats->treapPriorityChanges += delta.rotations_count;
+        break;
+    case TreeType::TWO_THREE:
+        stats->twoThreeSplits += delta.splits_count;
+        stats->twoThreeMerges += delta.merges_count;
+        stats->twoThreeBorrows += delta.borrows_count;
+        break;
+    default:
+        break;
+    }
+}
+
+void StatisticsCollector::merge(const DetailedStatistics& other) {
+    int index = static_cast<int>(other.treeType);
+    if (index < 0 || index >= TREE_TYPE_COUNT) return;
+
+    localShard()->statistics[index].merge(other);
+}
+
+void StatisticsCollector::snapshot() const {
+    std::lock_guard<std::mutex> lock(snapshotMutex);
+
+    statistics = prototypes;
+    for (ThreadShard* shard = shards->head.load(std::memory_order_acquire); shard; shard = shard->next) {
+        for (auto& pair : statistics) {
+            pair.second.merge(shard->statistics[static_cast<int>(pair.first)]);
+        }
+    }
+}
+
+DetailedStatistics StatisticsCollector::getStatistics(TreeType type) const {
+    snapshot();
+
+    // Копия: следующий snapshot() пересобирает statistics
+    std::lock_guard<std::mutex> lock(snapshotMutex);
+    auto it = statistics.find(type);
+    if (it != statistics.end()) {
+        return it->second;
+    }
+
+    // Возвращаем пустую статистику если не нашли
+    return DetailedStatistics();
+}
+
+std::vector<DetailedStatistics> StatisticsCollector::getAllStatistics() const {
+    snapshot();
+
+    std::lock_guard<std::mutex> lock(snapshotMutex);
+    std::vector<DetailedStatistics> result;
+    for (const auto& pair : statistics) {
+        result.push_back(pair.second);
+    }
+    return result;
+}
+
+void StatisticsCollector::exportToCSV(const std::string& filename) const {
+    snapshot();
+
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        return;
+    }
+
+    // Заголовок CSV
+    file << "TreeType,TreeName,InsertTime,SearchTime,DeleteTime,TraversalTime,"
+        << "MaxHeight,MinHeight,AvgHeight,NodeCount,LeafCount,BalanceFactor,"
+        << "AvgDepth,InternalPathLength,SuccessfulComparisons,UnsuccessfulComparisons,FillFactor,"
+        << "AVLRotations,AASkew,AASplit,TreapSplits,TreapMerges,TwoThreeSplits,TwoThreeMerges,"
+        << "TwoThreeBorrows,Comparisons,NodeVisits,Allocations,"
+        << "TimerSource,TimerResolutionNs,TimerOverheadNs";
+
+    const char* operations[] = { "Insert", "Search", "Delete" };
+    for (const char* operation : operations) {
+        file << "," << operation << "P50," << operation << "P90," << operation << "P99,"
+            << operation << "P999," << operation << "Max";
+    }
+    file << "\n";
+
+    for (const auto& pair : statistics) {
+        const DetailedStatistics& stats = pair.second;
+        auto metrics = stats.getMetricsMap();
+
+        file << static_cast<int>(stats.treeType) << ","
+            << stats.treeName << ","
+            << metrics.at("insert_time") << ","
+            << metrics.at("search_time") << ","
+            << metrics.at("delete_time") << ","
+            << stats.timeMetrics.traversalTime << ","
+            << metrics.at("max_height") << ","
+            << metrics.at("min_height") << ","
+            << metrics.at("avg_height") << ","
+            << metrics.at("node_count") << ","
+            << metrics.at("leaf_count") << ","
+            << metrics.at("balance_factor") << ","
+            << metrics.at("avg_depth") << ","
+            << stats.structureMetrics.internalPathLength << ","
+            << metrics.at("successful_comparisons") << ","
+            << metrics.at("unsuccessful_comparisons") << ","
+            << metrics.at("fill_factor") << ","
+            << stats.avlRotations << ","
+            << stats.aaSkewOperations << ","
+            << stats.aaSplitOperations << ","
+            << stats.treapSplitOperations << ","
+            << stats.treapMergeOperations << ","
+            << stats.twoThreeSplits << ","
+            << stats.twoThreeMerges << ","
+            << stats.twoThreeBorrows << ","
+            << stats.comparisons << ","
+            << stats.nodeVisits << ","
+            << stats.allocations << ","
+            << Timer::getSourceName() << ","
+            << Timer::getResolutionNs() << ","
+            << Timer::getOverheadNs();
+
+        const LatencyHistogram* latencies[] = { &stats.insertLatency, &stats.searchLatency, &stats.deleteLatency };
+        for (const LatencyHistogram* latency : latencies) {
+            file << "," << latency->getPercentile(50.0)
+                << "," << latency->getPercentile(90.0)
+                << "," << latency->getPercentile(99.0)
+                << "," << latency->getPercentile(99.9)
+                << "," << latency->getMax();
+        }
+        file << "\n";
+    }
+
+    file.close();
+}
+
+void StatisticsCollector::exportToJSON(const std::string& filename) const {
+    snapshot();
+
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        return;
+    }
+
+    file << "{\n";
+    file << "  \"timer\": {\n";
+    file << "    \"source\": \"" << Timer::getSourceName() << "\",\n";
+    file << "    \"resolutionNs\": " << Timer::getResolutionNs() << ",\n";
+    file << "    \"overheadNs\": " << Timer::getOverheadNs() << "\n";
+    file << "  },\n";
+    file << "  \"statistics\": [\n";
+
+    bool first = true;
+    for (const auto& pair : statistics) {
+        const DetailedStatistics& stats = pair.second;
+
+        if (!first) file << ",\n";
+        first = false;
+
+        file << "    {\n";
+        file << "      \"treeType\": \"" << stats.treeName << "\",\n";
+        file << "      \"timeMetrics\": {\n";
+        file << "        \"insertTime\": " << stats.timeMetrics.insertTime << ",\n";
+        file << "        \"searchTime\": " << stats.timeMetrics.searchTime << ",\n";
+        file << "        \"deleteTime\": " << stats.timeMetrics.deleteTime << ",\n";
+        file << "        \"traversalTime\": " << stats.timeMetrics.traversalTime << "\n";
+        file << "      },\n";
+
+        // Перцентили времени операций
+        file << "      \"latency\": {\n";
+        const std::pair<const char*, const LatencyHistogram*> latencies[] = {
+            { "insert", &stats.insertLatency },
+            { "search", &stats.searchLatency },
+            { "delete", &stats.deleteLatency }
+        };
+        for (size_t i = 0; i < 3; i++) {
+            const LatencyHistogram& latency = *latencies[i].second;
+            file << "        \"" << latencies[i].first << "\": { "
+                << "\"count\": " << latency.getCount() << ", "
+                << "\"p50\": " << latency.getPercentile(50.0) << ", "
+                << "\"p90\": " << latency.getPercentile(90.0) << ", "
+                << "\"p99\": " << latency.getPercentile(99.0) << ", "
+                << "\"p999\": " << latency.getPercentile(99.9) << ", "
+                << "\"max\": " << latency.getMax() << " }"
+                << (i + 1 < 3 ? ",\n" : "\n");
+        }
+        file << "      },\n";
+        file << "      \"structureMetrics\": {\n";
+        file << "        \"maxHeight\": " << stats.structureMetrics.maxHeight << ",\n";
+        file << "        \"minHeight\": " << stats.structureMetrics.minHeight << ",\n";
+        file << "        \"avgHeight\": " << stats.structureMetrics.avgHeight << ",\n";
+        file << "        \"nodeCount\": " << stats.structureMetrics.nodeCount << ",\n";
+        file << "        \"leafCount\": " << stats.structureMetrics.leafCount << ",\n";
+        file << "        \"balanceFactor\": " << stats.structureMetrics.balanceFactor << ",\n";
+        file << "        \"avgDepth\": " << stats.structureMetrics.avgDepth << ",\n";
+        file << "        \"internalPathLength\": " << stats.structureMetrics.internalPathLength << ",\n";
+        file << "        \"successfulComparisons\": " << stats.structureMetrics.successfulComparisons << ",\n";
+        file << "        \"unsuccessfulComparisons\": " << stats.structureMetrics.unsuccessfulComparisons << ",\n";
+        file << "        \"fillFactor\": " << stats.structureMetrics.fillFactor << ",\n";
+        file << "        \"depthHistogram\": [";
+        for (size_t depth = 0; depth < stats.structureMetrics.depthHistogram.size(); depth++) {
+            file << (depth > 0 ? ", " : "") << stats.structureMetrics.depthHistogram[depth];
+        }
+        file << "]\n";
+        file << "      },\n";
+
+        // Специфичные метрики
+        file << "      \"specificMetrics\": {\n";
+        file << "        \"avlRotations\": " << stats.avlRotations << ",\n";
+        file << "        \"avlBalanceOperations\": " << stats.avlBalanceOperations << ",\n";
+        file << "        \"aaSkewOperations\": " << stats.aaSkewOperations << ",\n";
+        file << "        \"aaSplitOperations\": " << stats.aaSplitOperations << ",\n";
+        file << "        \"treapSplitOperations\": " << stats.treapSplitOperations << ",\n";
+        file << "        \"treapMergeOperations\": " << stats.treapMergeOperations << ",\n";
+        file << "        \"treapPriorityChanges\": " << stats.treapPriorityChanges << ",\n";
+        file << "        \"twoThreeSplits\": " << stats.twoThreeSplits << ",\n";
+        file << "        \"twoThreeMerges\": " << stats.twoThreeMerges << ",\n";
+        file << "        \"twoThreeBorrows\": " << stats.twoThreeBorrows << "\n";
+        file << "      },\n";
+        file << "      \"structureWork\": {\n";
+        file << "        \"comparisons\": " << stats.comparisons << ",\n";
+        file << "        \"nodeVisits\": " << stats.nodeVisits << ",\n";
+        file << "        \"allocations\": " << stats.allocations << "\n";
+        file << "      }\n";
+        file << "    }";
+    }
+
+    file << "\n  ]\n";
+    file << "}\n";
+    file.close();
+}
+
+void StatisticsCollector::clear() {
+    // Как и snapshot(), вызывается при отсутствии параллельной регистрации
+    for (ThreadShard* shard = shards->head.load(std::memory_order_acquire); shard; shard = shard->next) {
+        for (const auto& pair : prototypes) {
+            shard->statistics[static_cast<int>(pair.first)] = pair.second;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(snapshotMutex);
+    statistics = prototypes;
 }
\ No newline at end of file
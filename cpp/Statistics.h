@@ -1,97 +1,165 @@
-#pragma once
-// include/Statistics.h
-#ifndef STATISTICS_H
-#define STATISTICS_H
-
-#include <vector>
-#include <map>
-#include <string>
-
-#include "TreeBase.h"
-
-struct DetailedStatistics {
-    //  
-    TreeType treeType;
-    std::string treeName;
-
-    //  
-    struct TimeMetrics {
-        long long insertTime = 0;
-        long long searchTime = 0;
-        long long deleteTime = 0;
-        long long traversalTime = 0;
-        int operationCount = 0;
-    } timeMetrics;
-
-    //  
-    struct StructureMetrics {
-        int maxHeight = 0;
-        int minHeight = 0;
-        double avgHeight = 0.0;
-        int nodeCount = 0;
-        int leafCount = 0;
-        double balanceFactor = 0.0; //  
-    } structureMetrics;
-
-    // AVL 
-    int avlRotations = 0;
-    int avlBalanceOperations = 0;
-
-    // AA 
-    int aaSkewOperations = 0;
-    int aaSplitOperations = 0;
-
-    // Treap 
-    int treapSplitOperations = 0;
-    int treapMergeOperations = 0;
-    int treapPriorityChanges = 0;
-
-    // 2-3  
-    int twoThreeSplits = 0;
-    int twoThreeMerges = 0;
-    int twoThreeBorrows = 0;
-
-    //    
-    std::vector<long long> insertTimes;
-    std::vector<long long> searchTimes;
-    std::vector<long long> deleteTimes;
-
-    // 
-    void reset();
-    void addInsertTime(long long time);
-    void addSearchTime(long long time);
-    void addDeleteTime(long long time);
-
-    std::string generateReport() const;
-    std::map<std::string, double> getMetricsMap() const;
-};
-
-class StatisticsCollector {
-private:
-    std::map<TreeType, DetailedStatistics> statistics;
-
-public:
-    StatisticsCollector();
-
-    //  
-    void registerInsert(TreeBase* tree, long long time);
-    void registerSearch(TreeBase* tree, long long time);
-    void registerDelete(TreeBase* tree, long long time);
-    void registerTraversal(TreeBase* tree, long long time);
-
-    //   
-    void updateStructureMetrics(TreeBase* tree);
-
-    //  
-    const DetailedStatistics& getStatistics(TreeType type) const;
-    std::vector<DetailedStatistics> getAllStatistics() const;
-
-    // 
-    void exportToCSV(const std::string& filename) const;
-    void exportToJSON(const std::string& filename) const;
-
-    // 
-    void clear();
-};
-
+#pragma once
+// include/Statistics.h
+#ifndef STATISTICS_H
+#define STATISTICS_H
+
+#include <atomic>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "LatencyHistogram.h"
+#include "TreeBase.h"
+
+struct DetailedStatistics {
+    // Общие метрики
+    TreeType treeType;
+    std::string treeName;
+
+    // Метрики производительности
+    struct TimeMetrics {
+        long long insertTime = 0;
+        long long searchTime = 0;
+        long long deleteTime = 0;
+        long long traversalTime = 0;
+        int operationCount = 0;
+    } timeMetrics;
+
+    // Метрики структуры. Высоты - по всем замерам, остальное - по последнему
+    // (см. StructureProfile)
+    struct StructureMetrics {
+        int samples = 0;            // Число замеров структуры
+        int maxHeight = 0;
+        int minHeight = 0;
+        double avgHeight = 0.0;
+        int nodeCount = 0;
+        int leafCount = 0;
+        double balanceFactor = 0.0; // Высота относительно минимально возможной
+        double avgDepth = 0.0;
+        long long internalPathLength = 0;
+        double successfulComparisons = 0.0;     // Ожидаемые сравнения поиска существующего ключа
+        double unsuccessfulComparisons = 0.0;   // и отсутствующего
+        double fillFactor = 0.0;
+        std::vector<long long> depthHistogram;
+    } structureMetrics;
+
+    // AVL метрики
+    int avlRotations = 0;
+    int avlBalanceOperations = 0;
+
+    // AA метрики
+    int aaSkewOperations = 0;
+    int aaSplitOperations = 0;
+
+    // Treap метрики
+    int treapSplitOperations = 0;
+    int treapMergeOperations = 0;
+    int treapPriorityChanges = 0;
+
+    // 2-3 дерево метрики
+    int twoThreeSplits = 0;
+    int twoThreeMerges = 0;
+    int twoThreeBorrows = 0;
+
+    // Работа по структуре для всех деревьев
+    long long comparisons = 0;
+    long long nodeVisits = 0;
+    long long allocations = 0;
+
+    // Распределение времени операций (фиксированный объем памяти)
+    LatencyHistogram insertLatency;
+    LatencyHistogram searchLatency;
+    LatencyHistogram deleteLatency;
+
+    // Методы
+    void reset();
+    void addInsertTime(long long time);
+    void addSearchTime(long long time);
+    void addDeleteTime(long long time);
+
+    // Объединение со статистикой, собранной в другом потоке или прогоне
+    void merge(const DetailedStatistics& other);
+
+    std::string generateReport() const;
+    std::map<std::string, double> getMetricsMap() const;
+};
+
+// Сборщик статистики. Каждый поток пишет в собственный шард, поэтому
+// регистрация операций не требует блокировок. Сводная статистика
+// формируется явным вызовом snapshot() после завершения параллельной фазы
+class StatisticsCollector {
+private:
+    static const int TREE_TYPE_COUNT = static_cast<int>(TreeType::UNKNOWN);
+
+    // Шард одного потока, выровнен по строке кэша против ложного разделения.
+    // Когда поток завершается, шард с накопленной статистикой освобождается
+    // и достается следующему новому потоку: число шардов не больше числа
+    // одновременно живших потоков
+    struct alignas(64) ThreadShard {
+        DetailedStatistics statistics[TREE_TYPE_COUNT];
+        ThreadShard* next = nullptr;
+        std::atomic<bool> owned{ true };
+    };
+
+    // Список шардов в отдельном объекте: поток возвращает шард при
+    // завершении, а сборщик к этому моменту может быть уже уничтожен
+    struct ShardList {
+        std::atomic<ThreadShard*> head{ nullptr };
+        ~ShardList();
+    };
+
+    unsigned long long collectorId;
+    std::shared_ptr<ShardList> shards;
+    std::map<TreeType, DetailedStatistics> prototypes;   // Начальные значения (тип и имя дерева)
+
+    mutable std::mutex snapshotMutex;
+    mutable std::map<TreeType, DetailedStatistics> statistics;
+
+    ThreadShard* createShard() const;
+    ThreadShard* localShard();
+    DetailedStatistics* localStatistics(TreeBase* tree);
+
+public:
+    StatisticsCollector();
+
+    StatisticsCollector(const StatisticsCollector&) = delete;
+    StatisticsCollector& operator=(const StatisticsCollector&) = delete;
+
+    // Регистрация операций
+    void registerInsert(TreeBase* tree, long long time);
+    void registerSearch(TreeBase* tree, long long time);
+    void registerDelete(TreeBase* tree, long long time);
+    void registerTraversal(TreeBase* tree, long long time);
+
+    // Замер структуры одним проходом по дереву (TreeBase::analyzeStructure).
+    // Дерево в это время никто не должен изменять
+    void updateStructureMetrics(TreeBase* tree, int threads = 1);
+
+    // Работа по структуре за фазу (разность TreeStatistics до и после),
+    // раскладывается по специфичным счетчикам типа дерева
+    void registerStructureWork(TreeBase* tree, const TreeStatistics& delta);
+
+    // Статистика, собранная вне сборщика (в дочернем процессе ячейки),
+    // добавляется в шард текущего потока по other.treeType
+    void merge(const DetailedStatistics& other);
+
+    // Сведение шардов всех потоков в общую статистику. Вызывается (в том
+    // числе неявно из методов получения и экспорта), когда потоки,
+    // регистрирующие операции, завершили работу
+    void snapshot() const;
+
+    // Получение статистики
+    DetailedStatistics getStatistics(TreeType type) const;
+    std::vector<DetailedStatistics> getAllStatistics() const;
+
+    // Экспорт
+    void exportToCSV(const std::string& filename) const;
+    void exportToJSON(const std::string& filename) const;
+
+    // Очистка
+    void clear();
+};
+
 #endif // STATISTICS_H
\ No newline at end of file
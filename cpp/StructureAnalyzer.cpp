@@ -0,0 +1,57 @@
+// src/StructureAnalyzer.cpp
+#include <algorithm>
+
+#include "StructureAnalyzer.h"
+
+double StructureProfile::getAverageDepth() const {
+    return nodes > 0 ? static_cast<double>(internal_path_length) / nodes : 0.0;
+}
+
+double StructureProfile::getSuccessfulComparisons() const {
+    return keys > 0 ? static_cast<double>(successful_comparisons) / keys : 0.0;
+}
+
+double StructureProfile::getUnsuccessfulComparisons() const {
+    return external_positions > 0 ? static_cast<double>(unsuccessful_comparisons) / external_positions : 0.0;
+}
+
+double StructureProfile::getFillFactor() const {
+    return key_slots > 0 ? static_cast<double>(keys) / key_slots : 0.0;
+}
+
+double StructureProfile::getBalanceFactor() const {
+    if (!valid || keys == 0 || nodes == 0) return 0.0;
+
+    // Минимальная высота: уровни заполняются целиком, на уровне d
+    // помещается (m + 1)^d узлов по m ключей
+    double keys_per_node = static_cast<double>(key_slots) / nodes;
+    double capacity = 0.0;
+    double level_nodes = 1.0;
+    int min_height = 0;
+    while (capacity < keys) {
+        capacity += level_nodes * keys_per_node;
+        level_nodes *= keys_per_node + 1.0;
+        min_height++;
+    }
+    return static_cast<double>(height) / min_height;
+}
+
+void StructureProfile::merge(const StructureProfile& other) {
+    valid = valid || other.valid;
+    nodes += other.nodes;
+    keys += other.keys;
+    leaves += other.leaves;
+    key_slots += other.key_slots;
+    internal_path_length += other.internal_path_length;
+    successful_comparisons += other.successful_comparisons;
+    unsuccessful_comparisons += other.unsuccessful_comparisons;
+    external_positions += other.external_positions;
+
+    if (other.depth_histogram.size() > depth_histogram.size()) {
+        depth_histogram.resize(other.depth_histogram.size(), 0);
+    }
+    for (size_t depth = 0; depth < other.depth_histogram.size(); depth++) {
+        depth_histogram[depth] += other.depth_histogram[depth];
+    }
+    height = std::max({ height, other.height, static_cast<int>(depth_histogram.size()) });
+}
\ No newline at end of file
@@ -0,0 +1,194 @@
+#pragma once
+// include/StructureAnalyzer.h
+#ifndef STRUCTUREANALYZER_H
+#define STRUCTUREANALYZER_H
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Точная форма дерева, собранная одним проходом по узлам. Ожидаемое число
+// сравнений считается по той же модели, что и счетчик comparisons дерева,
+// поэтому его можно сверять с замеренным comparisons / операций
+struct StructureProfile {
+    bool valid = false;
+    long long nodes = 0;
+    long long keys = 0;
+    long long leaves = 0;                       // Узлы без потомков
+    long long key_slots = 0;                    // Емкость узлов в ключах
+    int height = 0;                             // Число уровней
+    std::vector<long long> depth_histogram;     // Узлов на глубине d (корень - 0)
+    long long internal_path_length = 0;         // Сумма глубин узлов
+    long long successful_comparisons = 0;       // Сумма по поискам каждого ключа
+    long long unsuccessful_comparisons = 0;     // Сумма по всем промежуткам между ключами
+    long long external_positions = 0;           // Число промежутков (keys + 1)
+
+    double getAverageDepth() const;
+    // Среднее число сравнений поиска существующего и отсутствующего ключа
+    double getSuccessfulComparisons() const;
+    double getUnsuccessfulComparisons() const;
+    // Доля занятых мест под ключи (для 2-3 дерева; у бинарных всегда 1)
+    double getFillFactor() const;
+    // Высота относительно минимальной для того же числа ключей при той же
+    // емкости узлов: 1.0 - идеально сбалансированное дерево
+    double getBalanceFactor() const;
+
+    // Объединение профилей непересекающихся поддеревьев (глубины абсолютные)
+    void merge(const StructureProfile& other);
+};
+
+// Как дерево считает сравнения при поиске
+enum class ComparisonModel {
+    THREE_WAY,          // Трехсторонний спуск: ключ i узла стоит i + 1, переход в потомка j - min(j + 1, k)
+    SCAN_THEN_DESCEND   // Ключи узла по очереди на равенство, потомок - без новых сравнений (2-3 дерево)
+};
+
+// Итеративный обход в глубину с явным стеком: глубина дерева не ограничена
+// стеком вызовов. keyCount(node) - число ключей узла, child(node, j) -
+// потомок j из k + 1 (nullptr - пустое место). При threads > 1 верхние
+// уровни разворачиваются в ширину до ~8 поддеревьев на поток, поддеревья
+// разбираются потоками по общему счетчику, профили потоков объединяются.
+// Дерево во время прохода никто не должен изменять
+template<typename Node, typename KeyCount, typename Child>
+StructureProfile analyzeShape(const Node* root, int max_keys, ComparisonModel model, int threads,
+    KeyCount keyCount, Child child) {
+    struct Frame {
+        const Node* node;
+        int depth;
+        long long cost;         // Сравнений до входа в узел
+    };
+
+    // Счетчики прохода - в локальной структуре, в профиль переносятся в конце:
+    // иначе запись в стек мешает компилятору держать их в регистрах
+    struct Totals {
+        long long nodes = 0;
+        long long keys = 0;
+        long long leaves = 0;
+        long long internal_path_length = 0;
+        long long successful = 0;
+        long long unsuccessful = 0;
+        long long external = 0;
+        std::vector<long long> depths;
+
+        void addTo(StructureProfile& profile) const {
+            StructureProfile part;
+            part.nodes = nodes;
+            part.keys = keys;
+            part.leaves = leaves;
+            part.internal_path_length = internal_path_length;
+            part.successful_comparisons = successful;
+            part.unsuccessful_comparisons = unsuccessful;
+            part.external_positions = external;
+            part.depth_histogram = depths;
+            profile.merge(part);
+        }
+    };
+
+    auto visit = [&](const Frame& frame, Totals& totals, auto&& push) {
+        const Node* node = frame.node;
+        long long k = keyCount(node);
+
+        totals.nodes++;
+        totals.keys += k;
+        if (frame.depth >= static_cast<int>(totals.depths.size())) {
+            totals.depths.resize(frame.depth + 1, 0);
+        }
+        totals.depths[frame.depth]++;
+        totals.internal_path_length += frame.depth;
+        // Ключ i стоит cost + i + 1 в обеих моделях
+        totals.successful += k * frame.cost + k * (k + 1) / 2;
+
+        bool leaf = true;
+        for (int j = 0; j <= k; j++) {
+            if (child(node, j)) {
+                leaf = false;
+                break;
+            }
+        }
+        if (leaf) totals.leaves++;
+
+        for (int j = 0; j <= k; j++) {
+            long long cost = model == ComparisonModel::THREE_WAY
+                ? frame.cost + std::min<long long>(j + 1, k)
+                : frame.cost + k;
+
+            const Node* next = child(node, j);
+            if (next) {
+                push(Frame{ next, frame.depth + 1, cost });
+            }
+            else {
+                totals.external++;
+                totals.unsuccessful += cost;
+            }
+        }
+    };
+
+    // Стек - массив с вершиной в локальной переменной: с push_back/pop_back
+    // вектора обход на больших деревьях вдвое медленнее
+    auto walk = [&](const Frame& start, StructureProfile& profile) {
+        Totals totals;
+        std::vector<Frame> stack(64);
+        size_t top = 0;
+        stack[top++] = start;
+        while (top > 0) {
+            Frame frame = stack[--top];
+            size_t needed = top + static_cast<size_t>(keyCount(frame.node)) + 1;
+            if (needed > stack.size()) {
+                stack.resize(std::max(needed, stack.size() * 2));
+            }
+            Frame* base = stack.data();
+            visit(frame, totals, [&](const Frame& next) { base[top++] = next; });
+        }
+        totals.addTo(profile);
+    };
+
+    StructureProfile profile;
+    profile.valid = true;
+    if (!root) {
+        profile.external_positions = 1;
+        return profile;
+    }
+
+    if (threads <= 1) {
+        walk(Frame{ root, 0, 0 }, profile);
+    }
+    else {
+        // Верхние уровни - в основном профиле, ниже - по поддереву на задачу
+        std::vector<Frame> frontier{ Frame{ root, 0, 0 } };
+        size_t target = static_cast<size_t>(threads) * 8;
+        Totals upper;
+        while (!frontier.empty() && frontier.size() < target) {
+            std::vector<Frame> next;
+            for (const Frame& frame : frontier) {
+                visit(frame, upper, [&](const Frame& child_frame) { next.push_back(child_frame); });
+            }
+            frontier.swap(next);
+        }
+        upper.addTo(profile);
+
+        size_t workers = std::min(frontier.size(), static_cast<size_t>(threads));
+        std::vector<StructureProfile> partial(workers);
+        std::atomic<size_t> next_task{ 0 };
+        std::vector<std::thread> pool;
+        for (size_t t = 0; t < workers; t++) {
+            pool.emplace_back([&, t]() {
+                for (size_t task = next_task++; task < frontier.size(); task = next_task++) {
+                    walk(frontier[task], partial[t]);
+                }
+                });
+        }
+        for (auto& thread : pool) {
+            thread.join();
+        }
+        for (const auto& part : partial) {
+            profile.merge(part);
+        }
+    }
+
+    profile.key_slots = profile.nodes * max_keys;
+    profile.height = static_cast<int>(profile.depth_histogram.size());
+    return profile;
+}
+
+#endif // STRUCTUREANALYZER_H
\ No newline at end of file
@@ -0,0 +1,43 @@
+// src/TelemetrySampler.cpp
+#include "TelemetrySampler.h"
+
+TelemetrySampler::TelemetrySampler(long long sampleInterval, const TreeStatistics& phaseStart, size_t capacity)
+    : interval(sampleInterval), next_index(sampleInterval), baseline(phaseStart) {
+    if (interval > 0) {
+        ring.resize(capacity > 0 ? capacity : 1);
+    }
+}
+
+void TelemetrySampler::record(long long op_index, const TreeBase* tree, long long latency_ns) {
+    if (interval <= 0) return;
+
+    TreeStatistics current = tree->getStatistics();
+
+    TelemetrySample& sample = ring[head];
+    sample.op_index = op_index;
+    sample.height = tree->getHeight();
+    sample.nodes = tree->getNodeCount();
+    sample.rotations = current.rotations_count - baseline.rotations_count;
+    sample.skews = current.skew_count - baseline.skew_count;
+    sample.splits = current.split_count - baseline.split_count + current.splits_count - baseline.splits_count;
+    sample.merges = current.merges_count - baseline.merges_count;
+    sample.last_latency_ns = latency_ns;
+
+    head = (head + 1) % ring.size();
+    if (stored < ring.size()) stored++;
+    else overwritten++;
+
+    // Пакет может перешагнуть несколько отметок: следующая - после op_index
+    next_index = (op_index / interval + 1) * interval;
+}
+
+std::vector<TelemetrySample> TelemetrySampler::getSamples() const {
+    std::vector<TelemetrySample> samples;
+    samples.reserve(stored);
+
+    size_t first = stored < ring.size() ? 0 : head;
+    for (size_t i = 0; i < stored; i++) {
+        samples.push_back(ring[(first + i) % ring.size()]);
+    }
+    return samples;
+}
\ No newline at end of file
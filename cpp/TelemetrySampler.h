@@ -0,0 +1,58 @@
+#pragma once
+// include/TelemetrySampler.h
+#ifndef TELEMETRYSAMPLER_H
+#define TELEMETRYSAMPLER_H
+
+#include <vector>
+
+#include "TreeBase.h"
+
+// Состояние дерева после операции с номером op_index (считая с 1).
+// Счетчики структуры накоплены с начала фазы
+struct TelemetrySample {
+    long long op_index = 0;
+    int height = 0;
+    int nodes = 0;
+    long long rotations = 0;
+    long long skews = 0;
+    long long splits = 0;               // Расщепления АА, Treap и 2-3 вместе, как в BenchmarkResult
+    long long merges = 0;
+    long long last_latency_ns = 0;      // При пакетном замере - среднее операции последнего пакета
+};
+
+// Динамика структуры во время фазы: каждые interval операций в кольцевой
+// буфер фиксированного размера пишется высота, число узлов и накопленные
+// повороты и расщепления. При переполнении затираются старые замеры.
+// Замер делается между замеряемыми интервалами: высота и число узлов
+// считаются обходом - это O(n) на замер и прогревает кэш дерева
+class TelemetrySampler {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+private:
+    std::vector<TelemetrySample> ring;
+    size_t head = 0;                    // Позиция следующей записи
+    size_t stored = 0;
+    long long overwritten = 0;
+
+    long long interval;
+    long long next_index;
+    TreeStatistics baseline;
+
+public:
+    // interval <= 0 - замер выключен
+    TelemetrySampler(long long sampleInterval, const TreeStatistics& phaseStart,
+        size_t capacity = DEFAULT_CAPACITY);
+
+    bool isEnabled() const { return interval > 0; }
+    // Проверка на каждой операции - одно сравнение
+    bool isDue(long long op_index) const { return interval > 0 && op_index >= next_index; }
+
+    void record(long long op_index, const TreeBase* tree, long long latency_ns);
+
+    // Замеры в порядке операций (без затертых)
+    std::vector<TelemetrySample> getSamples() const;
+    long long getOverwritten() const { return overwritten; }
+};
+
+#endif // TELEMETRYSAMPLER_H
\ No newline at end of file
@@ -0,0 +1,108 @@
+// src/Timer.cpp
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+#if !defined(_MSC_VER) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#endif
+
+#include "Timer.h"
+
+Timer::Source Timer::source = Timer::Source::STEADY_CLOCK;
+double Timer::nsPerTick = 1.0;
+Timer::Ticks Timer::overheadTicks = 0;
+double Timer::resolutionNs = 1.0;
+bool Timer::calibrated = false;
+
+namespace {
+const int OVERHEAD_SAMPLES = 10000;
+const int RESOLUTION_SAMPLES = 1000;
+const int FREQUENCY_INTERVAL_MS = 50;
+}
+
+bool Timer::hasInvariantTSC() {
+#ifdef TIMER_HAS_TSC
+    // CPUID 0x80000007, EDX бит 8: частота TSC не зависит от P/C-состояний
+#ifdef _MSC_VER
+    int registers[4] = {};
+    __cpuid(registers, 0x80000000);
+    if (static_cast<unsigned int>(registers[0]) < 0x80000007u) return false;
+    __cpuid(registers, 0x80000007);
+    return (registers[3] & (1 << 8)) != 0;
+#else
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid_max(0x80000000u, nullptr) < 0x80000007u) return false;
+    __get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx);
+    return (edx & (1u << 8)) != 0;
+#endif
+#else
+    return false;
+#endif
+}
+
+void Timer::measureOverhead() {
+    // Минимум, а не среднее: прерывания и промахи только увеличивают разность
+    Ticks best = ~Ticks(0);
+    for (int i = 0; i < OVERHEAD_SAMPLES; i++) {
+        Ticks start = now();
+        Ticks end = now();
+        if (end >= start) best = std::min(best, end - start);
+    }
+    overheadTicks = best == ~Ticks(0) ? 0 : best;
+
+    // Шаг показаний: ждем смены значения
+    Ticks step = ~Ticks(0);
+    for (int i = 0; i < RESOLUTION_SAMPLES; i++) {
+        Ticks start = now();
+        Ticks end = now();
+        while (end == start) end = now();
+        if (end > start) step = std::min(step, end - start);
+    }
+    resolutionNs = step == ~Ticks(0) ? nsPerTick : step * nsPerTick;
+}
+
+void Timer::calibrate(bool preferTSC) {
+    source = Source::STEADY_CLOCK;
+    nsPerTick = 1.0;
+
+    if (preferTSC && hasInvariantTSC()) {
+        // Частота TSC по интервалу steady_clock
+        source = Source::TSC;
+        Ticks steadyStart = steadyTicks();
+        Ticks tscStart = now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(FREQUENCY_INTERVAL_MS));
+        Ticks steadyEnd = steadyTicks();
+        Ticks tscEnd = now();
+
+        if (tscEnd > tscStart && steadyEnd > steadyStart) {
+            nsPerTick = static_cast<double>(steadyEnd - steadyStart) / (tscEnd - tscStart);
+        }
+        else {
+            source = Source::STEADY_CLOCK;
+        }
+    }
+
+    measureOverhead();
+    calibrated = true;
+}
+
+const char* Timer::getSourceName() {
+    return source == Source::TSC ? "TSC" : "steady_clock";
+}
+
+std::string Timer::describe() {
+    std::stringstream ss;
+    ss << getSourceName();
+    if (source == Source::TSC) {
+        ss << " (" << std::fixed << std::setprecision(2) << 1.0 / nsPerTick << " ГГц)";
+    }
+    ss << std::fixed << std::setprecision(1)
+        << ", разрешение " << getResolutionNs() << " нс"
+        << ", накладные расходы " << getOverheadNs() << " нс";
+    if (!calibrated) {
+        ss << " (без калибровки)";
+    }
+    return ss.str();
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#pragma once
+// include/Timer.h
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define TIMER_HAS_TSC 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+// Таймер для замера коротких операций. На x86 с инвариантным TSC
+// используется rdtsc (единицы наносекунд на вызов), иначе steady_clock.
+// calibrate() вызывается один раз при запуске: измеряет частоту TSC,
+// накладные расходы пары отметок и разрешение. Накладные расходы
+// вычитаются в elapsedNs(). До калибровки используется steady_clock
+class Timer {
+public:
+    typedef std::uint64_t Ticks;
+
+    enum class Source {
+        STEADY_CLOCK,
+        TSC
+    };
+
+private:
+    static Source source;
+    static double nsPerTick;
+    static Ticks overheadTicks;     // Минимум разности двух соседних отметок
+    static double resolutionNs;     // Минимальный ненулевой шаг показаний
+    static bool calibrated;
+
+    static Ticks steadyTicks() {
+        return static_cast<Ticks>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    static bool hasInvariantTSC();
+    static void measureOverhead();
+
+public:
+    static Ticks now() {
+#ifdef TIMER_HAS_TSC
+        if (source == Source::TSC) {
+            // lfence не дает rdtsc выполниться раньше предыдущих инструкций
+            _mm_lfence();
+            Ticks ticks = __rdtsc();
+            _mm_lfence();
+            return ticks;
+        }
+#endif
+        return steadyTicks();
+    }
+
+    // Время между отметками за вычетом накладных расходов (не меньше 0)
+    static long long elapsedNs(Ticks start, Ticks end) {
+        Ticks ticks = end > start ? end - start : 0;
+        ticks = ticks > overheadTicks ? ticks - overheadTicks : 0;
+        return static_cast<long long>(ticks * nsPerTick + 0.5);
+    }
+
+    // Без вычета накладных расходов (для длинных интервалов)
+    static double toNanoseconds(Ticks ticks) { return ticks * nsPerTick; }
+
+    // preferTSC = false принудительно выбирает steady_clock
+    static void calibrate(bool preferTSC = true);
+    static bool isCalibrated() { return calibrated; }
+
+    static Source getSource() { return source; }
+    static const char* getSourceName();
+    static double getOverheadNs() { return overheadTicks * nsPerTick; }
+    static double getResolutionNs() { return resolutionNs; }
+
+    // "TSC (3.00 ГГц), разрешение 0.3 нс, накладные расходы 12.0 нс"
+    static std::string describe();
+};
+
+#endif // TIMER_H
\ No newline at end of file
@@ -0,0 +1,261 @@
+// src/TraceRecorder.cpp
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "TraceRecorder.h"
+
+// =============== БУФЕРЫ ПОТОКОВ ===============
+
+namespace {
+
+// Блоки берутся через malloc, мимо замененного operator new: ~256 КБ
+// блока не попадают в кучу фазы, которую считает MemoryTracker
+struct ChunkDeleter {
+    void operator()(TraceEvent* events) const { std::free(events); }
+};
+using EventChunk = std::unique_ptr<TraceEvent, ChunkDeleter>;
+
+// Буфер пополняется блоками: уже записанные события не перемещаются
+struct ThreadBuffer {
+    static constexpr size_t CHUNK_EVENTS = 4096;
+
+    std::vector<EventChunk> chunks;
+    std::atomic<size_t> count{ 0 };     // Публикуется владельцем после записи события
+    std::string thread_name;
+    int tid = 0;
+};
+
+std::atomic<bool> enabled{ false };
+std::atomic<Timer::Ticks> origin{ 0 };
+
+std::mutex registry_mutex;
+
+std::vector<std::unique_ptr<ThreadBuffer>>& registry() {
+    static std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    return buffers;
+}
+
+thread_local ThreadBuffer* local_buffer = nullptr;
+
+void addChunk(ThreadBuffer& buffer) {
+    void* memory = std::malloc(ThreadBuffer::CHUNK_EVENTS * sizeof(TraceEvent));
+    if (!memory) throw std::bad_alloc();
+    // Конструирование заодно касается страниц блока, пока фаза не началась
+    TraceEvent* events = static_cast<TraceEvent*>(memory);
+    std::uninitialized_default_construct_n(events, ThreadBuffer::CHUNK_EVENTS);
+    buffer.chunks.emplace_back(events);
+}
+
+// Вызывается под registry_mutex. Первый блок выделяется сразу: поток
+// регистрируется через setThreadName до замера, а не первой записью в фазе
+ThreadBuffer* registerBuffer() {
+    auto& buffers = registry();
+    buffers.push_back(std::make_unique<ThreadBuffer>());
+    ThreadBuffer* buffer = buffers.back().get();
+    buffer->tid = static_cast<int>(buffers.size()) - 1;
+    buffer->thread_name = "thread " + std::to_string(buffer->tid);
+    addChunk(*buffer);
+    return buffer;
+}
+
+ThreadBuffer& localBuffer() {
+    if (!local_buffer) {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        local_buffer = registerBuffer();
+    }
+    return *local_buffer;
+}
+
+void writeString(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; c++) {
+        if (*c == '"' || *c == '\\') out << '\\' << *c;
+        else if (static_cast<unsigned char>(*c) < 0x20) out << ' ';
+        else out << *c;
+    }
+    out << '"';
+}
+
+}
+
+void TraceRecorder::setEnabled(bool value) {
+    if (value && !enabled.load(std::memory_order_relaxed)) {
+        localBuffer();
+        origin.store(Timer::now(), std::memory_order_relaxed);
+    }
+    enabled.store(value, std::memory_order_relaxed);
+}
+
+bool TraceRecorder::isEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+void TraceRecorder::setThreadName(const std::string& name) {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    if (!local_buffer) {
+        local_buffer = registerBuffer();
+    }
+    local_buffer->thread_name = name;
+}
+
+void TraceRecorder::record(const char* name, const char* category, Timer::Ticks start, Timer::Ticks end,
+    const std::string& detail, long long value) {
+    if (!isEnabled()) return;
+
+    ThreadBuffer& buffer = localBuffer();
+    size_t index = buffer.count.load(std::memory_order_relaxed);
+    size_t chunk = index / ThreadBuffer::CHUNK_EVENTS;
+    if (chunk == buffer.chunks.size()) {
+        addChunk(buffer);
+    }
+
+    TraceEvent& event = buffer.chunks[chunk].get()[index % ThreadBuffer::CHUNK_EVENTS];
+    event.name = name;
+    event.category = category;
+    event.start = start;
+    event.end = end;
+    event.value = value;
+    size_t length = std::min(detail.size(), sizeof(event.detail) - 1);
+    std::memcpy(event.detail, detail.data(), length);
+    event.detail[length] = '\0';
+
+    buffer.count.store(index + 1, std::memory_order_release);
+}
+
+void TraceRecorder::clear() {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for (auto& buffer : registry()) {
+        buffer->count.store(0, std::memory_order_relaxed);
+    }
+    origin.store(Timer::now(), std::memory_order_relaxed);
+}
+
+size_t TraceRecorder::getEventCount() {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    size_t total = 0;
+    for (const auto& buffer : registry()) {
+        total += buffer->count.load(std::memory_order_acquire);
+    }
+    return total;
+}
+
+std::vector<TraceRecorder::ThreadEvents> TraceRecorder::exportEvents() {
+    ThreadBuffer* current = &localBuffer();
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    std::vector<ThreadEvents> threads;
+    threads.emplace_back();
+    for (const auto& buffer : registry()) {
+        size_t count = buffer->count.load(std::memory_order_acquire);
+        if (buffer.get() != current && count == 0) continue;
+
+        ThreadEvents thread;
+        thread.thread_name = buffer->thread_name;
+        thread.events.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            thread.events.push_back(buffer->chunks[i / ThreadBuffer::CHUNK_EVENTS].get()[i % ThreadBuffer::CHUNK_EVENTS]);
+        }
+
+        if (buffer.get() == current) {
+            threads.front() = std::move(thread);
+        }
+        else {
+            threads.push_back(std::move(thread));
+        }
+    }
+    return threads;
+}
+
+void TraceRecorder::importEvents(const std::vector<ThreadEvents>& threads) {
+    if (!isEnabled()) return;
+
+    for (size_t i = 0; i < threads.size(); i++) {
+        ThreadBuffer* buffer = nullptr;
+        if (i == 0) {
+            buffer = &localBuffer();
+        }
+        else {
+            if (threads[i].events.empty()) continue;
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            buffer = registerBuffer();
+            buffer->thread_name = threads[i].thread_name;
+        }
+
+        // Буфер дописывает только текущий поток, новые дорожки еще никому не видны
+        for (const TraceEvent& event : threads[i].events) {
+            size_t index = buffer->count.load(std::memory_order_relaxed);
+            size_t chunk = index / ThreadBuffer::CHUNK_EVENTS;
+            if (chunk == buffer->chunks.size()) {
+                addChunk(*buffer);
+            }
+            buffer->chunks[chunk].get()[index % ThreadBuffer::CHUNK_EVENTS] = event;
+            buffer->count.store(index + 1, std::memory_order_release);
+        }
+    }
+}
+
+// =============== ЭКСПОРТ ===============
+
+bool TraceRecorder::writeJSON(const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Не удалось открыть файл: " << filename << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    Timer::Ticks zero = origin.load(std::memory_order_relaxed);
+    // Отметки в микросекундах от включения записи
+    auto us = [&](Timer::Ticks ticks) {
+        return ticks > zero ? Timer::toNanoseconds(ticks - zero) / 1000.0 : 0.0;
+    };
+
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"timer\":";
+    writeString(file, Timer::getSourceName());
+    file << ",\"timerOverheadNs\":" << Timer::getOverheadNs() << "},\"traceEvents\":[\n";
+    file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"trees\"}}";
+
+    for (const auto& buffer : registry()) {
+        file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid
+            << ",\"args\":{\"name\":";
+        writeString(file, buffer->thread_name.c_str());
+        file << "}}";
+
+        size_t count = buffer->count.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; i++) {
+            const TraceEvent& event =
+                buffer->chunks[i / ThreadBuffer::CHUNK_EVENTS].get()[i % ThreadBuffer::CHUNK_EVENTS];
+            file << ",\n{\"name\":";
+            writeString(file, event.name);
+            file << ",\"cat\":";
+            writeString(file, event.category);
+            file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid
+                << ",\"ts\":" << us(event.start) << ",\"dur\":" << us(event.end) - us(event.start)
+                << ",\"args\":{";
+            bool first = true;
+            if (event.detail[0]) {
+                file << "\"detail\":";
+                writeString(file, event.detail);
+                first = false;
+            }
+            if (event.value >= 0) {
+                file << (first ? "" : ",") << "\"value\":" << event.value;
+            }
+            file << "}}";
+        }
+    }
+
+    file << "\n]}\n";
+    file.close();
+    return !file.fail();
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+// include/TraceRecorder.h
+#ifndef TRACERECORDER_H
+#define TRACERECORDER_H
+
+#include <string>
+#include <vector>
+
+#include "Timer.h"
+
+// Событие трассы: интервал выполнения на одном потоке
+struct TraceEvent {
+    const char* name = "";          // Строковые литералы: хранится только указатель
+    const char* category = "";
+    Timer::Ticks start = 0;
+    Timer::Ticks end = 0;
+    long long value = -1;           // Числовой аргумент (размер, номер повтора), -1 - нет
+    char detail[24] = {};           // Короткая подпись (имя дерева, режим кэша), копируется
+};
+
+// Запись хода прогона для просмотра в chrome://tracing или Perfetto.
+// Каждый поток пишет в свой буфер без блокировок; мьютекс берется только
+// при первой записи потока, чтобы зарегистрировать буфер. События пишутся
+// на границах ячеек и фаз, а не операций, поэтому запись почти ничего не
+// стоит. Буферы живут до завершения процесса: события рабочих потоков
+// остаются после их завершения
+class TraceRecorder {
+public:
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    // Имя дорожки текущего потока в трассе
+    static void setThreadName(const std::string& name);
+
+    static void record(const char* name, const char* category, Timer::Ticks start, Timer::Ticks end,
+        const std::string& detail = std::string(), long long value = -1);
+
+    // Сбрасывает записанные события всех потоков. Вызывается, когда другие
+    // потоки не пишут в трассу
+    static void clear();
+    static size_t getEventCount();
+
+    // События одного потока для передачи из дочернего процесса (fork)
+    // в родительский. Указатели name и category остаются верными: это
+    // литералы того же исполняемого файла
+    struct ThreadEvents {
+        std::string thread_name;
+        std::vector<TraceEvent> events;
+    };
+
+    // Записанные события по потокам, первым - текущий поток
+    static std::vector<ThreadEvents> exportEvents();
+    // События первого потока дописываются в буфер текущего, остальные -
+    // в новые дорожки. При выключенной записи ничего не делает
+    static void importEvents(const std::vector<ThreadEvents>& threads);
+
+    // Формат Chrome Trace Event (JSON). Вызывается после завершения рабочих потоков
+    static bool writeJSON(const std::string& filename);
+};
+
+// Интервал от создания до разрушения объекта
+class TraceSpan {
+private:
+    const char* name;
+    const char* category;
+    std::string detail;
+    long long value;
+    Timer::Ticks start;
+    bool active;
+
+public:
+    TraceSpan(const char* spanName, const char* spanCategory, const std::string& spanDetail = std::string(),
+        long long spanValue = -1)
+        : name(spanName), category(spanCategory), value(spanValue), start(0),
+        active(TraceRecorder::isEnabled()) {
+        if (active) {
+            detail = spanDetail;
+            start = Timer::now();
+        }
+    }
+
+    ~TraceSpan() {
+        if (active) {
+            TraceRecorder::record(name, category, start, Timer::now(), detail, value);
+        }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+};
+
+#endif // TRACERECORDER_H
\ No newline at end of file
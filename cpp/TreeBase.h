@@ -1,59 +1,118 @@
-#pragma once
-// include/TreeBase.h
-#ifndef TREEBASE_H
-#define TREEBASE_H
-
-#include <chrono>
-#include <vector>
-#include <memory>
-#include <string>
-
-#include "CommonTypes.h"
-
-class TreeBase {
-public:
-    virtual ~TreeBase() = default;
-
-    //  
-    virtual OperationResult insert(int key) = 0;
-    virtual OperationResult remove(int key) = 0;
-    virtual OperationResult search(int key) = 0;
-    virtual OperationResult clear() = 0;
-
-    //  
-    virtual std::vector<int> traverse(TraversalType type) = 0;
-
-    //   
-    virtual int getHeight() const = 0;
-    virtual int getNodeCount() const = 0;
-    virtual bool isEmpty() const = 0;
-
-    // 
-    virtual std::string toString() const = 0;
-
-    // 
-    virtual void resetStatistics() = 0;
-    virtual TreeStatistics getStatistics() const = 0;
-
-    //   
-    virtual TreeType getType() const = 0;
-
-protected:
-    //     
-    template<typename Func, typename... Args>
-    OperationResult measureOperation(Func&& func, Args&&... args) {
-        auto start = std::chrono::high_resolution_clock::now();
-        bool success = func(std::forward<Args>(args)...);
-        auto end = std::chrono::high_resolution_clock::now();
-
-        OperationResult result;
-        result.success = success;
-        result.time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
-        result.height = getHeight();
-        result.nodes_count = getNodeCount();
-
-        return result;
-    }
-};
-
+#pragma once
+// include/TreeBase.h
+#ifndef TREEBASE_H
+#define TREEBASE_H
+
+#include <vector>
+#include <memory>
+#include <string>
+
+#include "AccessTracer.h"
+#include "CommonTypes.h"
+#include "StructureAnalyzer.h"
+#include "Timer.h"
+
+class TreeBase {
+public:
+    virtual ~TreeBase() = default;
+
+    // Основные операции
+    virtual OperationResult insert(int key) = 0;
+    virtual OperationResult remove(int key) = 0;
+    virtual OperationResult search(int key) = 0;
+    virtual OperationResult clear() = 0;
+
+    // Поиск без замера времени и без изменения статистики.
+    // Безопасен для одновременного вызова из нескольких читателей
+    virtual bool contains(int key) const = 0;
+
+    // Копия той же формы (высоты, уровни, приоритеты узлов): узлы выделяются
+    // заново в прямом порядке обхода, статистика копии нулевая, трассировщик
+    // не переносится. Дерево в это время никто не должен изменять
+    virtual std::unique_ptr<TreeBase> clone() const = 0;
+
+    // Обходы дерева
+    virtual std::vector<int> traverse(TraversalType type) = 0;
+
+    // Информация о дереве
+    virtual int getHeight() const = 0;
+    virtual int getNodeCount() const = 0;
+    virtual bool isEmpty() const = 0;
+
+    // Оценка занимаемой памяти (узлы + служебные поля), в байтах
+    virtual size_t getMemoryUsage() const = 0;
+
+    // Точная форма дерева за один проход по узлам (см. StructureAnalyzer.h),
+    // при threads > 1 поддеревья обходятся параллельно. Дерево в это время
+    // никто не должен изменять. Без доступа к узлам - профиль с valid == false
+    virtual StructureProfile analyzeStructure(int /*threads*/ = 1) const { return StructureProfile(); }
+
+    // Допускает ли реализация одновременный доступ из нескольких потоков
+    virtual bool isThreadSafe() const { return false; }
+
+    // Визуализация
+    virtual std::string toString() const = 0;
+
+    // Статистика
+    virtual void resetStatistics() = 0;
+    virtual TreeStatistics getStatistics() const = 0;
+
+    // Геттер типа дерева
+    virtual TreeType getType() const = 0;
+
+    // Режим трассировки: дерево сообщает адреса узлов, которых касается
+    // при поиске, вставке и удалении (nullptr - трассировка выключена).
+    // Трассировщик не синхронизирован, режим рассчитан на один поток
+    void setAccessTracer(AccessTracer* accessTracer) { tracer = accessTracer; }
+    AccessTracer* getAccessTracer() const { return tracer; }
+
+    // Замер отдельных операций. При пакетном замере (время K операций
+    // засекает вызывающий) выключается, и OperationResult содержит только
+    // признак успеха. Высоту и число узлов операции не считают: это обход
+    // O(n), вызывающий при необходимости запрашивает их вне замера
+    void setOperationTiming(bool enabled) { operationTiming = enabled; }
+    bool isOperationTiming() const { return operationTiming; }
+
+protected:
+    AccessTracer* tracer = nullptr;
+    bool operationTiming = true;
+
+    void traceAccess(const void* address, size_t size) const {
+        if (tracer) tracer->onAccess(address, size);
+    }
+
+    // Вспомогательные методы для замера времени
+    template<typename Func, typename... Args>
+    OperationResult measureOperation(Func&& func, Args&&... args) {
+        OperationResult result;
+        if (!operationTiming) {
+            result.success = func(std::forward<Args>(args)...);
+            return result;
+        }
+
+        Timer::Ticks start = Timer::now();
+        bool success = func(std::forward<Args>(args)...);
+        Timer::Ticks end = Timer::now();
+
+        result.success = success;
+        result.time_ns = Timer::elapsedNs(start, end);
+
+        return result;
+    }
+
+    // Замер обертки над другими деревьями (LockedTree, ShardedTree): время
+    // вместе с ожиданием блокировок
+    template<typename Func>
+    OperationResult measureWrapped(Func&& func) {
+        if (!operationTiming) {
+            return func();
+        }
+
+        Timer::Ticks start = Timer::now();
+        OperationResult result = func();
+        result.time_ns = Timer::elapsedNs(start, Timer::now());
+        return result;
+    }
+};
+
 #endif // TREEBASE_H
\ No newline at end of file
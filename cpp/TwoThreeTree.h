@@ -1,107 +1,116 @@
-#pragma once
-// include/TwoThreeTree.h
-#ifndef TWOTHREETREE_H
-#define TWOTHREETREE_H
-
-#include <vector>
-
-#include "TreeBase.h"
-
-//  2-3 
-class TwoThreeNode {
-private:
-    bool isLeaf;
-    std::vector<int> keys;
-    std::vector<TwoThreeNode*> children;
-    TwoThreeNode* parent;
-
-public:
-    TwoThreeNode(bool leaf = true) : isLeaf(leaf), parent(nullptr) {}
-
-    // 
-    bool getIsLeaf() const { return isLeaf; }
-    const std::vector<int>& getKeys() const { return keys; }
-    std::vector<int>& getKeys() { return keys; } //  
-    const std::vector<TwoThreeNode*>& getChildren() const { return children; }
-    std::vector<TwoThreeNode*>& getChildren() { return children; } //  
-    TwoThreeNode* getParent() const { return parent; }
-
-    // 
-    void setIsLeaf(bool leaf) { isLeaf = leaf; }
-    void setParent(TwoThreeNode* p) { parent = p; }
-
-    //  
-    bool isFull() const { return keys.size() == 2; }
-    bool isUnderflow() const { return keys.empty(); }
-    int getKeyCount() const { return keys.size(); }
-    int getChildCount() const { return children.size(); }
-};
-
-class TwoThreeTree : public TreeBase {
-private:
-    TwoThreeNode* root;
-    mutable TreeStatistics stats;
-
-    //  
-    int getNodeCount(TwoThreeNode* node) const;
-    int getHeight(TwoThreeNode* node) const;
-    void clear(TwoThreeNode* node);
-
-    // 
-    TwoThreeNode* findLeaf(TwoThreeNode* node, int key) const;
-    bool containsKey(TwoThreeNode* node, int key) const;
-
-    // 
-    void insertIntoLeaf(TwoThreeNode* leaf, int key);
-    void splitNode(TwoThreeNode* node);
-    void insertRecursive(TwoThreeNode* node, int key);
-
-    // 
-    TwoThreeNode* findNode(TwoThreeNode* node, int key) const;
-    void removeFromLeaf(TwoThreeNode* leaf, int key);
-    void borrowFromSibling(TwoThreeNode* node);
-    void mergeWithSibling(TwoThreeNode* node);
-    void fixUnderflow(TwoThreeNode* node);
-
-    //  /
-    int findMinKey(TwoThreeNode* node) const;
-    int findMaxKey(TwoThreeNode* node) const;
-
-    // 
-    void inorder(TwoThreeNode* node, std::vector<int>& result) const;
-    void preorder(TwoThreeNode* node, std::vector<int>& result) const;
-    void postorder(TwoThreeNode* node, std::vector<int>& result) const;
-    void levelOrder(TwoThreeNode* node, std::vector<int>& result) const;
-
-    // 
-    void getStructure(TwoThreeNode* node, std::string& result,
-        const std::string& prefix,
-        const std::string& childrenPrefix,
-        int childIndex = -1) const;
-
-public:
-    TwoThreeTree();
-    ~TwoThreeTree();
-
-    //   TreeBase
-    OperationResult insert(int key) override;
-    OperationResult remove(int key) override;
-    OperationResult search(int key) override;
-    OperationResult clear() override;
-
-    std::vector<int> traverse(TraversalType type) override;
-
-    int getHeight() const override;
-    int getNodeCount() const override;
-    bool isEmpty() const override;
-
-    std::string toString() const override;
-    std::string getStructure() const;
-
-    void resetStatistics() override;
-    TreeStatistics getStatistics() const override;
-
-    TreeType getType() const override { return TreeType::TWO_THREE; }
-};
-
+#pragma once
+// include/TwoThreeTree.h
+#ifndef TWOTHREETREE_H
+#define TWOTHREETREE_H
+
+#include <vector>
+
+#include "TreeBase.h"
+
+// Узел 2-3 дерева
+class TwoThreeNode {
+private:
+    bool isLeaf;
+    std::vector<int> keys;
+    std::vector<TwoThreeNode*> children;
+    TwoThreeNode* parent;
+
+public:
+    TwoThreeNode(bool leaf = true) : isLeaf(leaf), parent(nullptr) {}
+
+    // Геттеры
+    bool getIsLeaf() const { return isLeaf; }
+    const std::vector<int>& getKeys() const { return keys; }
+    std::vector<int>& getKeys() { return keys; } // Для модификации
+    const std::vector<TwoThreeNode*>& getChildren() const { return children; }
+    std::vector<TwoThreeNode*>& getChildren() { return children; } // Для модификации
+    TwoThreeNode* getParent() const { return parent; }
+
+    // Сеттеры
+    void setIsLeaf(bool leaf) { isLeaf = leaf; }
+    void setParent(TwoThreeNode* p) { parent = p; }
+
+    // Вспомогательные методы
+    bool isFull() const { return keys.size() == 2; }
+    bool isUnderflow() const { return keys.empty(); }
+    int getKeyCount() const { return keys.size(); }
+    int getChildCount() const { return children.size(); }
+};
+
+class TwoThreeTree : public TreeBase {
+private:
+    TwoThreeNode* root;
+    mutable TreeStatistics stats;
+
+    // Вспомогательные методы
+    int getNodeCount(TwoThreeNode* node) const;
+    int getHeight(TwoThreeNode* node) const;
+    size_t getMemoryUsage(TwoThreeNode* node) const;
+    void clear(TwoThreeNode* node);
+    TwoThreeNode* clone(const TwoThreeNode* node, TwoThreeNode* parent) const;
+
+    // Учет посещения узла и его трассировка вместе с буферами ключей и детей
+    void visit(const TwoThreeNode* node) const;
+
+    // Поиск
+    TwoThreeNode* findLeaf(TwoThreeNode* node, int key) const;
+    bool containsKey(TwoThreeNode* node, int key) const;
+
+    // Вставка
+    void insertIntoLeaf(TwoThreeNode* leaf, int key);
+    void splitNode(TwoThreeNode* node);
+    void insertRecursive(TwoThreeNode* node, int key);
+
+    // Удаление
+    TwoThreeNode* findNode(TwoThreeNode* node, int key) const;
+    void removeFromLeaf(TwoThreeNode* leaf, int key);
+    void borrowFromSibling(TwoThreeNode* node);
+    void mergeWithSibling(TwoThreeNode* node);
+    void fixUnderflow(TwoThreeNode* node);
+
+    // Поиск минимума/максимума
+    int findMinKey(TwoThreeNode* node) const;
+    int findMaxKey(TwoThreeNode* node) const;
+
+    // Обходы
+    void inorder(TwoThreeNode* node, std::vector<int>& result) const;
+    void preorder(TwoThreeNode* node, std::vector<int>& result) const;
+    void postorder(TwoThreeNode* node, std::vector<int>& result) const;
+    void levelOrder(TwoThreeNode* node, std::vector<int>& result) const;
+
+    // Визуализация
+    void getStructure(TwoThreeNode* node, std::string& result,
+        const std::string& prefix,
+        const std::string& childrenPrefix,
+        int childIndex = -1) const;
+
+public:
+    TwoThreeTree();
+    ~TwoThreeTree();
+
+    // Реализация интерфейса TreeBase
+    OperationResult insert(int key) override;
+    OperationResult remove(int key) override;
+    OperationResult search(int key) override;
+    OperationResult clear() override;
+    bool contains(int key) const override;
+    std::unique_ptr<TreeBase> clone() const override;
+
+    std::vector<int> traverse(TraversalType type) override;
+
+    int getHeight() const override;
+    int getNodeCount() const override;
+    bool isEmpty() const override;
+    size_t getMemoryUsage() const override;
+    StructureProfile analyzeStructure(int threads = 1) const override;
+
+    std::string toString() const override;
+    std::string getStructure() const;
+
+    void resetStatistics() override;
+    TreeStatistics getStatistics() const override;
+
+    TreeType getType() const override { return TreeType::TWO_THREE; }
+};
+
 #endif // TWOTHREETREE_H
\ No newline at end of file
@@ -1,24 +1,35 @@
-﻿// src/main.cpp
-#include <iostream>
-#include <locale>
-
-#include "ConsoleUI.h"
-
-int main() {
-    setlocale(LC_ALL, "Russian");
-
-    std::cout << "===============================================================================\n";
-    std::cout << "                     ПРОГРАММНАЯ РЕАЛИЗАЦИЯ И ИССЛЕДОВАНИЕ\n";
-    std::cout << "                       ЭФФЕКТИВНОСТИ БИНАРНЫХ ДЕРЕВЬЕВ\n";
-    std::cout << "===============================================================================\n";
-    std::cout << "                         Курсовой проект по ТМП\n";
-    std::cout << "                          Самарский университет\n";
-    std::cout << "===============================================================================\n\n";
-
-    ConsoleUI ui;
-    ui.run();
-
-    std::cout << "\nСпасибо за использование программы!\n";
-
-    return 0;
+// src/main.cpp
+#include <iostream>
+#include <locale>
+
+#include "BenchmarkRunner.h"
+#include "ConsoleUI.h"
+#include "Timer.h"
+
+int main(int argc, char* argv[]) {
+    setlocale(LC_ALL, "Russian");
+
+    // Калибровка до первых замеров: частота TSC и накладные расходы таймера
+    Timer::calibrate();
+
+    // С параметрами командной строки - прогон без диалога, код завершения для планировщика
+    int exit_code = BenchmarkRunner::runFromCommandLine(argc, argv);
+    if (exit_code >= 0) {
+        return exit_code;
+    }
+
+    std::cout << "===============================================================================\n";
+    std::cout << "                     ПРОГРАММНАЯ РЕАЛИЗАЦИЯ И ИССЛЕДОВАНИЕ\n";
+    std::cout << "                       ЭФФЕКТИВНОСТИ БИНАРНЫХ ДЕРЕВЬЕВ\n";
+    std::cout << "===============================================================================\n";
+    std::cout << "                         Курсовой проект по ТМП\n";
+    std::cout << "                          Самарский университет\n";
+    std::cout << "===============================================================================\n\n";
+
+    ConsoleUI ui;
+    ui.run();
+
+    std::cout << "\nСпасибо за использование программы!\n";
+
+    return 0;
 }
\ No newline at end of file